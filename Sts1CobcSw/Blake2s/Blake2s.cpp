@@ -12,7 +12,7 @@ namespace sts1cobcsw::blake2s
 using sts1cobcsw::operator""_b;
 
 
-auto ComputeHash(std::span<Byte const> data) -> Hash
+auto Hasher::Reset() -> void
 {
     static constexpr auto keySize = 4;
     // TODO: Use a proper key
@@ -21,11 +21,29 @@ auto ComputeHash(std::span<Byte const> data) -> Hash
     static auto const serializedKey = Serialize<std::endian::big>(key);
     static_assert(serializedKey.size() == keySize);
 
-    auto blake2s = BLAKE2s();
-    blake2s.reset(serializedKey.data(), serializedKey.size(), sizeof(Hash));
-    blake2s.update(data.data(), data.size());
+    blake2s_.reset(serializedKey.data(), serializedKey.size(), sizeof(Hash));
+}
+
+
+auto Hasher::Update(std::span<Byte const> data) -> void
+{
+    blake2s_.update(data.data(), data.size());
+}
+
+
+auto Hasher::Finalize() -> Hash
+{
     auto hash = Hash{};
-    blake2s.finalize(hash.data(), hash.size());
+    blake2s_.finalize(hash.data(), hash.size());
     return hash;
 }
+
+
+auto ComputeHash(std::span<Byte const> data) -> Hash
+{
+    auto hasher = Hasher{};
+    hasher.Reset();
+    hasher.Update(data);
+    return hasher.Finalize();
+}
 }
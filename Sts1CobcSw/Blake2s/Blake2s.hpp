@@ -1,6 +1,7 @@
 #pragma once
 
 
+#include <Sts1CobcSw/Blake2s/External/BLAKE2s.h>
 #include <Sts1CobcSw/Serial/Byte.hpp>
 
 #include <array>
@@ -12,5 +13,20 @@ namespace sts1cobcsw::blake2s
 using Hash = std::array<Byte, 8>;  // NOLINT(*magic-numbers)
 
 
+// Computes the same hash as ComputeHash() for data that arrives piece by piece, e.g., while a frame
+// is still being received. Reset() must be called before the first Update().
+class Hasher
+{
+public:
+    auto Reset() -> void;
+    auto Update(std::span<Byte const> data) -> void;
+    [[nodiscard]] auto Finalize() -> Hash;
+
+
+private:
+    BLAKE2s blake2s_;
+};
+
+
 auto ComputeHash(std::span<Byte const> data) -> Hash;
 }
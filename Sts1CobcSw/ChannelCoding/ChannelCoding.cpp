@@ -6,6 +6,9 @@
 #endif
 #include <Sts1CobcSw/Outcome/Outcome.hpp>
 
+#include <algorithm>
+#include <cassert>
+
 
 namespace sts1cobcsw
 {
@@ -16,12 +19,40 @@ auto Encode(std::span<Byte, blockLength> block) -> void
 #ifdef DISABLE_CHANNEL_CODING
     (void)block;
 #else
-    rs::Encode(block.first<rs::messageLength>(), block.last<rs::nParitySymbols>());
+    rs::EncodeInterleaved<interleavingDepth>(block.first<messageLength>(),
+                                             block.last<interleavingDepth * nParitySymbols>());
     Scramble(block);
 #endif
 }
 
 
+auto EncodeChannelAccessDataUnit(std::span<Byte, channelAccessDataUnitLength> channelAccessDataUnit)
+    -> void
+{
+#ifdef DISABLE_CHANNEL_CODING
+    (void)channelAccessDataUnit;
+#else
+    auto block = channelAccessDataUnit.last<blockLength>();
+    rs::EncodeInterleaved<interleavingDepth>(block.first<messageLength>(),
+                                             block.last<interleavingDepth * nParitySymbols>());
+    AttachSynchMarkerAndScramble(channelAccessDataUnit);
+#endif
+}
+
+
+auto EncodeChannelAccessDataUnit(std::span<Byte, channelAccessDataUnitLength> channelAccessDataUnit,
+                                 CodingProfile profile) -> std::span<Byte const>
+{
+    assert(IsValid(profile));
+    if(profile == CodingProfile::none)
+    {
+        return channelAccessDataUnit.subspan(attachedSynchMarkerLength, messageLength);
+    }
+    EncodeChannelAccessDataUnit(channelAccessDataUnit);
+    return channelAccessDataUnit;
+}
+
+
 auto Decode(std::span<Byte, blockLength> block) -> Result<int>
 {
 #ifdef DISABLE_CHANNEL_CODING
@@ -29,7 +60,7 @@ auto Decode(std::span<Byte, blockLength> block) -> Result<int>
     return 0;
 #else
     Unscramble(block);
-    return rs::Decode(block);
+    return rs::DecodeInterleaved<interleavingDepth>(block);
 #endif
 }
 }
@@ -58,5 +89,62 @@ auto Decode(std::span<Byte, blockLength> block) -> Result<int>
     return rs::Decode(block);
 #endif
 }
+
+
+auto Decode(std::span<Byte, blockLength> block, std::span<std::uint8_t const> erasurePositions)
+    -> Result<int>
+{
+    auto decoder = BlockDecoder{};
+    decoder.Update(block);
+    return decoder.Finish(block, erasurePositions);
+}
+
+
+auto BlockDecoder::Reset() -> void
+{
+    syndromeAccumulator_.Reset();
+    nBytes_ = 0;
+}
+
+
+auto BlockDecoder::Update(std::span<Byte> chunk) -> void
+{
+    assert(nBytes_ + chunk.size() <= blockLength);
+#ifndef DISABLE_CHANNEL_CODING
+    Unscramble(chunk, nBytes_);
+    syndromeAccumulator_.Update(chunk);
+#endif
+    nBytes_ += chunk.size();
+}
+
+
+auto BlockDecoder::IsComplete() const -> bool
+{
+    return nBytes_ == blockLength;
+}
+
+
+auto BlockDecoder::Finish(std::span<Byte, blockLength> block,
+                          std::span<std::uint8_t const> erasurePositions) const -> Result<int>
+{
+    assert(IsComplete());
+#ifdef DISABLE_CHANNEL_CODING
+    (void)block;
+    (void)erasurePositions;
+    return 0;
+#else
+    auto decodeResult = rs::Decode(block, syndromeAccumulator_, {});
+    if(decodeResult.has_value() or erasurePositions.empty())
+    {
+        return decodeResult;
+    }
+    // Erasures only cost half as much as errors but wrongly flagged bytes waste correction
+    // capacity, so we only use them if decoding without them failed. A failed decoding leaves the
+    // block untouched, so the syndromes are still valid.
+    return rs::Decode(block,
+                      syndromeAccumulator_,
+                      erasurePositions.first(std::min(erasurePositions.size(), rs::maxNErasures)));
+#endif
+}
 }
 }
@@ -7,9 +7,16 @@
 #include <Sts1CobcSw/Serial/Byte.hpp>
 
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <span>
 
 
+#ifndef RS_INTERLEAVING_DEPTH
+    #define RS_INTERLEAVING_DEPTH 1
+#endif
+
+
 namespace sts1cobcsw
 {
 using sts1cobcsw::operator""_b;
@@ -17,17 +24,79 @@ using sts1cobcsw::operator""_b;
 
 inline constexpr auto attachedSynchMarker = std::array{0x1A_b, 0xCF_b, 0xFC_b, 0x1D_b};
 #ifdef DISABLE_CHANNEL_CODING
-inline constexpr auto blockLength = rs::messageLength;
 inline constexpr auto attachedSynchMarkerLength = 0;
 #else
-inline constexpr auto blockLength = rs::blockLength;
 inline constexpr auto attachedSynchMarkerLength = attachedSynchMarker.size();
 #endif
-inline constexpr auto messageLength = rs::messageLength;
 inline constexpr auto nParitySymbols = rs::nParitySymbols;
+
+
+namespace tc
+{
+inline constexpr auto messageLength = rs::messageLength;
+#ifdef DISABLE_CHANNEL_CODING
+inline constexpr auto blockLength = messageLength;
+#else
+inline constexpr auto blockLength = rs::blockLength;
+#endif
+}
+
+namespace tm
+{
+// TM frames consist of interleavingDepth interleaved Reed-Solomon codewords. Deeper interleaving
+// means fewer, longer frames and therefore less overhead per byte of payload, as well as a better
+// tolerance of burst errors.
+inline constexpr auto interleavingDepth = std::size_t{RS_INTERLEAVING_DEPTH};
+static_assert(1 <= interleavingDepth and interleavingDepth <= 5,  // NOLINT(*magic-numbers)
+              "The interleaving depth must be between 1 and 5");
+inline constexpr auto messageLength = interleavingDepth * rs::messageLength;
+#ifdef DISABLE_CHANNEL_CODING
+inline constexpr auto blockLength = messageLength;
+#else
+inline constexpr auto blockLength = interleavingDepth * rs::blockLength;
+#endif
 inline constexpr auto channelAccessDataUnitLength = attachedSynchMarkerLength + blockLength;
-inline constexpr auto fullyEncodedFrameLength = static_cast<unsigned>(
-    cc::ViterbiCodec::EncodedSize(channelAccessDataUnitLength, /*withFlushBits=*/true));
+}
+
+
+// The coding steps that are applied to TM frames. The profile can be changed at runtime, e.g., to
+// trade error correction capability for data rate. The build options only select the default.
+// Without Reed-Solomon coding the frame is sent without the attached sync marker and scrambling,
+// i.e., just as it was when DISABLE_CHANNEL_CODING was defined.
+enum class CodingProfile : std::uint8_t
+{
+    none = 0,
+    reedSolomon = 1,
+    reedSolomonAndConvolutional = 2,
+    reedSolomonAndPuncturedConvolutional = 3,
+};
+
+
+#if defined(DISABLE_CHANNEL_CODING)
+inline constexpr auto defaultCodingProfile = CodingProfile::none;
+#elif defined(DISABLE_CONVOLUTIONAL_CODING)
+inline constexpr auto defaultCodingProfile = CodingProfile::reedSolomon;
+#elif defined(USE_PUNCTURING)
+inline constexpr auto defaultCodingProfile = CodingProfile::reedSolomonAndPuncturedConvolutional;
+#else
+inline constexpr auto defaultCodingProfile = CodingProfile::reedSolomonAndConvolutional;
+#endif
+
+
+// DISABLE_CHANNEL_CODING changes the size of the buffers, so only the profile without any coding is
+// valid if it is defined
+[[nodiscard]] constexpr auto IsValid(CodingProfile profile) -> bool;
+[[nodiscard]] constexpr auto ToCodeRate(CodingProfile profile) -> cc::CodeRate;
+
+
+namespace tm
+{
+// Return the length of the frame after Reed-Solomon coding and attaching the sync marker, i.e.,
+// before convolutional coding
+[[nodiscard]] constexpr auto EncodedFrameLength(CodingProfile profile) -> std::size_t;
+// Return the number of bytes that are actually sent for a single frame
+[[nodiscard]] constexpr auto FullyEncodedFrameLength(CodingProfile profile) -> std::size_t;
+}
 
 
 namespace tc
@@ -35,12 +104,98 @@ namespace tc
 auto Encode(std::span<Byte, blockLength> block) -> void;
 // Return the number of corrected errors
 auto Decode(std::span<Byte, blockLength> block) -> Result<int>;
+// Like Decode() but if decoding fails, retry with the bytes at the given positions treated as
+// erasures, e.g., because the receiver flagged them as suspect. At most rs::maxNErasures positions
+// are used. Return the number of corrected errors and erasures.
+auto Decode(std::span<Byte, blockLength> block, std::span<std::uint8_t const> erasurePositions)
+    -> Result<int>;
+
+
+// Decodes a block while it is received: every chunk is unscrambled in place and added to the
+// Reed-Solomon syndromes as soon as it arrives, so that only the error correction is left after the
+// last one
+class BlockDecoder
+{
+public:
+    auto Reset() -> void;
+    // Unscramble the next chunk of the block in place and add it to the syndromes
+    auto Update(std::span<Byte> chunk) -> void;
+    // Return true if all blockLength bytes of the block were added
+    [[nodiscard]] auto IsComplete() const -> bool;
+    // Finish decoding the block whose chunks were passed to Update() like Decode() does. Return the
+    // number of corrected errors and erasures.
+    [[nodiscard]] auto Finish(std::span<Byte, blockLength> block,
+                              std::span<std::uint8_t const> erasurePositions) const -> Result<int>;
+
+
+private:
+    rs::SyndromeAccumulator syndromeAccumulator_;
+    std::size_t nBytes_ = 0;
+};
 }
 
 namespace tm
 {
 auto Encode(std::span<Byte, blockLength> block) -> void;
+// Encode the block of the channel access data unit like Encode() but also write the attached sync
+// marker. Scrambling and writing the sync marker are fused into a single pass over the buffer.
+auto EncodeChannelAccessDataUnit(std::span<Byte, channelAccessDataUnitLength> channelAccessDataUnit)
+    -> void;
+// Apply the Reed-Solomon part of the given coding profile to the channel access data unit and
+// return the part of it that must be sent, i.e., EncodedFrameLength(profile) bytes
+auto EncodeChannelAccessDataUnit(std::span<Byte, channelAccessDataUnitLength> channelAccessDataUnit,
+                                 CodingProfile profile) -> std::span<Byte const>;
 // Return the number of corrected errors
 auto Decode(std::span<Byte, blockLength> block) -> Result<int>;
 }
+
+
+constexpr auto IsValid(CodingProfile profile) -> bool
+{
+#ifdef DISABLE_CHANNEL_CODING
+    return profile == CodingProfile::none;
+#else
+    return profile <= CodingProfile::reedSolomonAndPuncturedConvolutional;
+#endif
+}
+
+
+constexpr auto ToCodeRate(CodingProfile profile) -> cc::CodeRate
+{
+    switch(profile)
+    {
+        case CodingProfile::reedSolomonAndConvolutional:
+            return cc::CodeRate::oneHalf;
+        case CodingProfile::reedSolomonAndPuncturedConvolutional:
+            return cc::CodeRate::twoThirds;
+        default:
+            return cc::CodeRate::uncoded;
+    }
+}
+
+
+namespace tm
+{
+constexpr auto EncodedFrameLength(CodingProfile profile) -> std::size_t
+{
+    return profile == CodingProfile::none ? messageLength : channelAccessDataUnitLength;
+}
+
+
+constexpr auto FullyEncodedFrameLength(CodingProfile profile) -> std::size_t
+{
+    return cc::ViterbiCodec::EncodedSize(
+        EncodedFrameLength(profile), /*withFlushBits=*/true, ToCodeRate(profile));
+}
+
+
+// Buffers for fully encoded frames must be large enough for every valid coding profile
+#ifdef DISABLE_CHANNEL_CODING
+inline constexpr auto maxFullyEncodedFrameLength =
+    static_cast<unsigned>(FullyEncodedFrameLength(CodingProfile::none));
+#else
+inline constexpr auto maxFullyEncodedFrameLength =
+    static_cast<unsigned>(FullyEncodedFrameLength(CodingProfile::reedSolomonAndConvolutional));
+#endif
+}
 }
@@ -13,9 +13,8 @@
 
 #include <etl/utility.h>
 
-#if defined(DISABLE_CHANNEL_CODING) || defined(DISABLE_CONVOLUTIONAL_CODING)
-    #include <algorithm>
-#endif
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <cstdlib>
 
@@ -25,7 +24,108 @@ namespace sts1cobcsw::cc
 using sts1cobcsw::operator""_b;
 
 
-ViterbiCodec::ViterbiCodec()
+namespace
+{
+constexpr auto nStates = 1U << (ViterbiCodec::constraint - 1U);
+constexpr auto nInputValues = 1U << CHAR_BIT;
+
+
+// The code is linear apart from the inverted second polynomial. The output bits for a whole input
+// byte are therefore the XOR of a part that only depends on the state and a part that only depends
+// on the input byte. This allows encoding byte-wise with two small tables instead of a single one
+// with 64 x 256 entries. The next state does not depend on the old state at all because it only
+// consists of the last 6 input bits.
+struct ByteEncodingTable
+{
+    std::array<std::uint16_t, nStates> stateOutputs = {};
+    std::array<std::uint16_t, nInputValues> inputOutputs = {};
+};
+
+
+// Encode a byte bit by bit, MSB first, exactly like repeated calls to ProcessTwoBits() would
+[[nodiscard]] constexpr auto ComputeByteOutput(unsigned int state,
+                                               unsigned int inputBits,
+                                               CodeRate codeRate) -> std::uint16_t
+{
+    auto result = 0U;
+    for(auto i = CHAR_BIT; i-- > 0;)
+    {
+        auto bit = (inputBits >> static_cast<unsigned>(i)) & 1U;
+        auto output =
+            ViterbiCodec::ComputeOutput(state | (bit << (ViterbiCodec::constraint - 1U)));
+        state = (state >> 1U) | (bit << (ViterbiCodec::constraint - 2U));
+        if(codeRate == CodeRate::twoThirds)
+        {
+            // The first parity bit of every second input bit is punctured
+            result = (i % 2 == 0) ? ((result << 1U) | (output & 1U)) : ((result << 2U) | output);
+        }
+        else
+        {
+            result = (result << 2U) | output;
+        }
+    }
+    return static_cast<std::uint16_t>(result);
+}
+
+
+[[nodiscard]] constexpr auto ComputeNextState(unsigned int inputBits) -> std::uint8_t
+{
+    auto state = 0U;
+    for(auto i = CHAR_BIT; i-- > 0;)
+    {
+        auto bit = (inputBits >> static_cast<unsigned>(i)) & 1U;
+        state = (state >> 1U) | (bit << (ViterbiCodec::constraint - 2U));
+    }
+    return static_cast<std::uint8_t>(state);
+}
+
+
+[[nodiscard]] constexpr auto MakeByteEncodingTable(CodeRate codeRate) -> ByteEncodingTable
+{
+    auto table = ByteEncodingTable{};
+    for(auto state = 0U; state < nStates; ++state)
+    {
+        table.stateOutputs[state] = static_cast<std::uint16_t>(
+            ComputeByteOutput(state, 0U, codeRate) ^ ComputeByteOutput(0U, 0U, codeRate));
+    }
+    for(auto inputBits = 0U; inputBits < nInputValues; ++inputBits)
+    {
+        table.inputOutputs[inputBits] = ComputeByteOutput(0U, inputBits, codeRate);
+    }
+    return table;
+}
+
+
+constexpr auto byteEncodingTable = MakeByteEncodingTable(CodeRate::oneHalf);
+constexpr auto puncturedByteEncodingTable = MakeByteEncodingTable(CodeRate::twoThirds);
+
+constexpr auto nextStates = []
+{
+    auto states = std::array<std::uint8_t, nInputValues>{};
+    for(auto inputBits = 0U; inputBits < nInputValues; ++inputBits)
+    {
+        states[inputBits] = ComputeNextState(inputBits);
+    }
+    return states;
+}();
+
+
+static_assert(ComputeByteOutput(0b10'1101, 0xA7, CodeRate::oneHalf)
+              == (byteEncodingTable.stateOutputs[0b10'1101]
+                  ^ byteEncodingTable.inputOutputs[0xA7]));
+static_assert(ComputeByteOutput(0b11'1111, 0x3C, CodeRate::oneHalf)
+              == (byteEncodingTable.stateOutputs[0b11'1111]
+                  ^ byteEncodingTable.inputOutputs[0x3C]));
+static_assert(ComputeByteOutput(0b10'1101, 0xA7, CodeRate::twoThirds)
+              == (puncturedByteEncodingTable.stateOutputs[0b10'1101]
+                  ^ puncturedByteEncodingTable.inputOutputs[0xA7]));
+static_assert(ComputeByteOutput(0b11'1111, 0x3C, CodeRate::twoThirds)
+              == (puncturedByteEncodingTable.stateOutputs[0b11'1111]
+                  ^ puncturedByteEncodingTable.inputOutputs[0x3C]));
+}
+
+
+ViterbiCodec::ViterbiCodec(CodeRate codeRate) : codeRate_(codeRate)
 {
     assert(!polynomials.empty());
     for(auto i = 0U; i < polynomials.size(); i++)
@@ -36,94 +136,105 @@ ViterbiCodec::ViterbiCodec()
 }
 
 
-auto ViterbiCodec::Encode(std::span<Byte const> data, [[maybe_unused]] bool flush)
+auto ViterbiCodec::GetCodeRate() const -> CodeRate
+{
+    return codeRate_;
+}
+
+
+auto ViterbiCodec::Encode(std::span<Byte const> data, bool flush)
     -> etl::vector<Byte, ViterbiCodec::maxEncodedSize>
 {
     assert(data.size() <= ViterbiCodec::maxUnencodedSize);
 
     auto dst = etl::vector<Byte, ViterbiCodec::maxEncodedSize>();
-#if defined(DISABLE_CHANNEL_CODING) || defined(DISABLE_CONVOLUTIONAL_CODING)
-    dst.uninitialized_resize(std::min(data.size(), dst.max_size()));
-    std::copy_n(data.begin(), dst.size(), dst.begin());
-#elif defined(USE_PUNCTURING)
-    for(auto i = 0U; i < data.size(); ++i)
+    dst.uninitialized_resize(dst.max_size());
+    auto nEncodedBytes = EncodeTo(data, dst, flush);
+    dst.resize(nEncodedBytes);
+    return dst;
+}
+
+
+auto ViterbiCodec::EncodeTo(std::span<Byte const> data,
+                            std::span<Byte> encodedData,
+                            bool flush) -> std::size_t
+{
+    auto nEncodedBytes = std::size_t{0};
+    auto push = [&](Byte byte)
     {
-        auto inputBits = static_cast<std::uint8_t>(data[i]);
-        // Turn 8 input bits into 12 encoded bits
-        for(auto j = CHAR_BIT - 1; j > 0; j -= 2)
-        {
-            std::uint8_t bit1 = (inputBits >> static_cast<std::uint8_t>(j)) & 1U;
-            std::uint8_t bit2 = (inputBits >> (static_cast<std::uint8_t>(j) - 1U)) & 1U;
-            bytes_ = (bytes_ << 3) | ProcessTwoBits(bit1, bit2);
-        }
-        if((i + nProcessedBytes_) % 2 == 0)
-        {
-            // 12 bits -> push back 1 byte and keep the remaining 4 bits for the next iteration
-            assert(bytes_ <= 0xFFF);
-            dst.push_back(static_cast<Byte>((bytes_ >> 4) & 0xFF));
-            bytes_ &= 0xF;
-        }
-        else
-        {
-            // 12 bits + 4 bits from the last iteration -> push back 2 bytes
-            assert(bytes_ <= 0xFFFF);
-            dst.push_back(static_cast<Byte>((bytes_ >> 8) & 0xFF));
-            dst.push_back(static_cast<Byte>(bytes_ & 0xFF));
-            bytes_ = 0;
-        }
+        assert(nEncodedBytes < encodedData.size());
+        encodedData[nEncodedBytes++] = byte;
+    };
+    if(codeRate_ == CodeRate::uncoded)
+    {
+        nEncodedBytes = std::min(data.size(), encodedData.size());
+        std::copy_n(data.begin(), nEncodedBytes, encodedData.begin());
+        return nEncodedBytes;
     }
-    nProcessedBytes_ += data.size();
-    if(flush)
+    if(codeRate_ == CodeRate::twoThirds)
     {
-        for(int j = constraint - 1; j > 0; j -= 2)
-        {
-            bytes_ = (bytes_ << 3) | ProcessTwoBits(0, 0);
-        }
-        if(nProcessedBytes_ % 2 == 1)
+        for(auto i = 0U; i < data.size(); ++i)
         {
-            // 13 bits remaining -> pad with 3 zeros from the right to make it 2 full bytes
-            assert(bytes_ <= 0x1FFF);
-            bytes_ <<= 3;
+            // Turn 8 input bits into 12 encoded bits
+            bytes_ = (bytes_ << 12) | ProcessByte(static_cast<std::uint8_t>(data[i]));
+            if((i + nProcessedBytes_) % 2 == 0)
+            {
+                // 12 bits -> push back 1 byte and keep the remaining 4 bits for the next iteration
+                assert(bytes_ <= 0xFFF);
+                push(static_cast<Byte>((bytes_ >> 4) & 0xFF));
+                bytes_ &= 0xF;
+            }
+            else
+            {
+                // 12 bits + 4 bits from the last iteration -> push back 2 bytes
+                assert(bytes_ <= 0xFFFF);
+                push(static_cast<Byte>((bytes_ >> 8) & 0xFF));
+                push(static_cast<Byte>(bytes_ & 0xFF));
+                bytes_ = 0;
+            }
         }
-        else
+        nProcessedBytes_ += data.size();
+        if(flush)
         {
-            // 9 bits remaining -> pad with 7 zeros from the right to make it 2 full bytes
-            assert(bytes_ <= 0x1FF);
-            bytes_ <<= 7;
+            for(int j = constraint - 1; j > 0; j -= 2)
+            {
+                bytes_ = (bytes_ << 3) | ProcessTwoBits(0, 0);
+            }
+            if(nProcessedBytes_ % 2 == 1)
+            {
+                // 13 bits remaining -> pad with 3 zeros from the right to make it 2 full bytes
+                assert(bytes_ <= 0x1FFF);
+                bytes_ <<= 3;
+            }
+            else
+            {
+                // 9 bits remaining -> pad with 7 zeros from the right to make it 2 full bytes
+                assert(bytes_ <= 0x1FF);
+                bytes_ <<= 7;
+            }
+            push(static_cast<Byte>((bytes_ >> 8) & 0xFF));
+            push(static_cast<Byte>(bytes_ & 0xFF));
+            state_ = 0;
+            bytes_ = 0;
+            nProcessedBytes_ = 0;
         }
-        dst.push_back(static_cast<Byte>((bytes_ >> 8) & 0xFF));
-        dst.push_back(static_cast<Byte>(bytes_ & 0xFF));
-        state_ = 0;
-        bytes_ = 0;
-        nProcessedBytes_ = 0;
+        // else
+        // {
+        //     if(nProcessedBytes_ % 2 == 1)
+        //     {
+        //         assert(bytes_ <= 0xFFF);  // 12 bits -> we can output 1 more full byte
+        //         push(static_cast<Byte>((bytes_ >> 4) & 0xFF));
+        //         bytes_ &= 0xF;  // Keep the last 4 bits for the next call
+        //         ++nProcessedBytes_;
+        //     }
+        // }
+        return nEncodedBytes;
     }
-    // else
-    // {
-    //     if(nProcessedBytes_ % 2 == 1)
-    //     {
-    //         assert(bytes_ <= 0xFFF);  // 12 bits -> we can output 1 more full byte
-    //         dst.push_back(static_cast<Byte>((bytes_ >> 4) & 0xFF));
-    //         bytes_ &= 0xF;  // Keep the last 4 bits for the next call
-    //         ++nProcessedBytes_;
-    //     }
-    // }
-#else
     for(auto i = 0U; i < data.size(); i++)
     {
-        auto inputBits = static_cast<std::uint8_t>(data[i]);
-        for(auto j = CHAR_BIT - 1; j > 0; j -= 2)
-        {
-            std::uint8_t bit1 = (inputBits >> static_cast<std::uint8_t>(j)) & 1U;
-            std::uint8_t bit2 = (inputBits >> (static_cast<std::uint8_t>(j) - 1U)) & 1U;
-            bytes_ = (bytes_ << 4) | ProcessTwoBits(bit1, bit2);
-        }
-
-        assert(bytes_ <= 0xFFFF);
-        auto mask = 0xFF00U;
-
-        dst.push_back(static_cast<Byte>((bytes_ & mask) >> CHAR_BIT));
-        dst.push_back(static_cast<Byte>(bytes_ & (mask >> CHAR_BIT)));
-        bytes_ = 0;
+        auto output = ProcessByte(static_cast<std::uint8_t>(data[i]));
+        push(static_cast<Byte>(output >> CHAR_BIT));
+        push(static_cast<Byte>(output & 0xFFU));
     }
     if(flush)
     {
@@ -133,13 +244,12 @@ auto ViterbiCodec::Encode(std::span<Byte const> data, [[maybe_unused]] bool flus
         }
 
         assert(bytes_ <= 0xFFF);
-        dst.push_back(static_cast<Byte>((bytes_ >> 4) & 0xFF));
-        dst.push_back(static_cast<Byte>((bytes_ & 0xF) << 4));
+        push(static_cast<Byte>((bytes_ >> 4) & 0xFF));
+        push(static_cast<Byte>((bytes_ & 0xF) << 4));
         state_ = 0;
         bytes_ = 0;
     }
-#endif
-    return dst;
+    return nEncodedBytes;
 }
 
 
@@ -161,36 +271,34 @@ auto ViterbiCodec::ProcessTwoBits(std::uint8_t bit1, std::uint8_t bit2) -> std::
     state_ = NextState(state_, bit1);
     auto output2 = Output(state_, bit2);
     state_ = NextState(state_, bit2);
-#ifdef USE_PUNCTURING
-    auto output = (output1 << 1) | (output2 & 1);
-    assert(output <= 0b111);
-#else
+    if(codeRate_ == CodeRate::twoThirds)
+    {
+        auto output = (output1 << 1) | (output2 & 1);
+        assert(output <= 0b111);
+        return static_cast<std::uint8_t>(output);
+    }
     auto output = (output1 << 2) | output2;
     assert(output <= 0b1111);
-#endif
     return static_cast<std::uint8_t>(output);
 }
 
 
+auto ViterbiCodec::ProcessByte(std::uint8_t inputBits) -> std::uint16_t
+{
+    auto const & table =
+        codeRate_ == CodeRate::twoThirds ? puncturedByteEncodingTable : byteEncodingTable;
+    auto output =
+        static_cast<std::uint16_t>(table.stateOutputs[state_] ^ table.inputOutputs[inputBits]);
+    state_ = nextStates[inputBits];
+    return output;
+}
+
+
 auto ViterbiCodec::InitializeOutputs() -> void
 {
     for(auto i = 0U; i < outputs.size(); ++i)
     {
-        outputs[i] = 0U;
-        for(auto j = 0U; j < nParityBits; ++j)
-        {
-            auto polynomial = static_cast<std::uint8_t>(std::abs(polynomials[j]));
-            auto input = static_cast<std::uint8_t>(i);
-            std::uint8_t output = 0U;
-            for(auto k = 0U; k < constraint; ++k)
-            {
-                output ^= static_cast<std::uint8_t>((polynomials[j] < 0)
-                                                    ^ ((input & 1U) & (polynomial & 1U)));
-                polynomial >>= 1U;
-                input >>= 1U;
-            }
-            outputs[i] = static_cast<std::uint8_t>((outputs[i] << 1U) | output);
-        }
+        outputs[i] = ComputeOutput(i);
     }
 }
 }
@@ -24,6 +24,24 @@
 
 namespace sts1cobcsw::cc
 {
+// The code rate can be chosen at runtime. The build options only select the default.
+enum class CodeRate : std::uint8_t
+{
+    uncoded,    // No convolutional coding at all
+    oneHalf,    // K = 7, r = 1/2
+    twoThirds,  // K = 7, r = 1/2 punctured to r = 2/3
+};
+
+
+#if defined(DISABLE_CHANNEL_CODING) || defined(DISABLE_CONVOLUTIONAL_CODING)
+inline constexpr auto defaultCodeRate = CodeRate::uncoded;
+#elif defined(USE_PUNCTURING)
+inline constexpr auto defaultCodeRate = CodeRate::twoThirds;
+#else
+inline constexpr auto defaultCodeRate = CodeRate::oneHalf;
+#endif
+
+
 // This class implements a convolutional Encoder.
 class ViterbiCodec
 {
@@ -37,23 +55,21 @@ public:
     static constexpr auto nParityBits = polynomials.size();
 
     static constexpr auto maxUnencodedSize = 255U + 4U;  // >= RS(255,223) + 4 byte sync marker
-    // EncodedSize() cannot be used in a constant expression until the class is complete
-#if defined(DISABLE_CHANNEL_CODING) || defined(DISABLE_CONVOLUTIONAL_CODING)
-    static constexpr auto maxEncodedSize = maxUnencodedSize;
-#else
-    #ifdef USE_PUNCTURING
-    static constexpr auto maxEncodedSize = 390U;
-    #else
+    // EncodedSize() cannot be used in a constant expression until the class is complete. The
+    // largest encoded size is the one for r = 1/2.
     static constexpr auto maxEncodedSize = 520U;
-    #endif
-#endif
 
+    // The code rate is selected at runtime, so it must always be given explicitly
     [[nodiscard]] static constexpr auto EncodedSize(std::size_t unencodedSize,
-                                                    [[maybe_unused]] bool withFlushBits)
-        -> std::size_t;
+                                                    bool withFlushBits,
+                                                    CodeRate codeRate) -> std::size_t;
     [[nodiscard]] static constexpr auto UnencodedSize(std::size_t encodedSize,
-                                                      [[maybe_unused]] bool withFlushBits)
-        -> std::size_t;
+                                                      bool withFlushBits,
+                                                      CodeRate codeRate) -> std::size_t;
+    // Return the parity bits for the given shift register content. The shift register contains the
+    // current input bit combined with the previous inputs, i.e., it is the index into the output
+    // table described below.
+    [[nodiscard]] static constexpr auto ComputeOutput(unsigned int shiftRegister) -> std::uint8_t;
 
     // Note about Polynomial Descriptor of a Convolutional Encoder / Decoder.
     // A generator polymonial is built as follows: Build a binary number
@@ -73,9 +89,15 @@ public:
     //    This representation is used by the Spiral Viterbi Decoder Software
     //    Generator. See http://www.spiral.net/software/viterbi.html
     // We use 2.
-    ViterbiCodec();
+    explicit ViterbiCodec(CodeRate codeRate = defaultCodeRate);
+    [[nodiscard]] auto GetCodeRate() const -> CodeRate;
     [[nodiscard]] auto Encode(std::span<Byte const> data, bool flush)
         -> etl::vector<Byte, maxEncodedSize>;
+    // Same as Encode() but write the encoded data to the given buffer instead of returning a
+    // vector. The buffer must have room for at least EncodedSize(data.size(), flush, GetCodeRate())
+    // bytes. Return the number of encoded bytes.
+    [[nodiscard]] auto EncodeTo(std::span<Byte const> data, std::span<Byte> encodedData, bool flush)
+        -> std::size_t;
 
 
 private:
@@ -87,55 +109,76 @@ private:
     // 6).
     static inline auto outputs = std::array<std::uint8_t, 1U << constraint>();
 
+    CodeRate codeRate_ = defaultCodeRate;
     unsigned int state_ = 0;
-    [[maybe_unused]] unsigned int bytes_ = 0;
-#ifdef USE_PUNCTURING
+    unsigned int bytes_ = 0;
     unsigned int nProcessedBytes_ = 0;
-#endif
 
     auto InitializeOutputs() -> void;
     [[nodiscard]] auto NextState(unsigned int currentState, unsigned int input) const
         -> unsigned int;
     [[nodiscard]] auto Output(unsigned int currentState, unsigned int input) const -> std::uint8_t;
     [[nodiscard]] auto ProcessTwoBits(std::uint8_t bit1, std::uint8_t bit2) -> std::uint8_t;
+    // Encode a whole byte with a table lookup and return the 16 (or 12 when puncturing) output bits
+    [[nodiscard]] auto ProcessByte(std::uint8_t inputBits) -> std::uint16_t;
 };
 
 
 constexpr auto ViterbiCodec::EncodedSize(std::size_t unencodedSize,
-                                         [[maybe_unused]] bool withFlushBits) -> std::size_t
+                                         bool withFlushBits,
+                                         CodeRate codeRate) -> std::size_t
 {
-#if defined(DISABLE_CHANNEL_CODING) || defined(DISABLE_CONVOLUTIONAL_CODING)
-    return unencodedSize;
-#else
+    if(codeRate == CodeRate::uncoded)
+    {
+        return unencodedSize;
+    }
     auto flushingBits = withFlushBits ? nFlushBits : 0U;
-    #ifdef USE_PUNCTURING
-    auto bits = (unencodedSize * CHAR_BIT + flushingBits) * 3 / 2;
-    #else
-    auto bits = (unencodedSize * CHAR_BIT + flushingBits) * 2;
-    #endif
+    auto bits = codeRate == CodeRate::twoThirds
+                  ? (unencodedSize * CHAR_BIT + flushingBits) * 3 / 2
+                  : (unencodedSize * CHAR_BIT + flushingBits) * 2;
     auto size = (bits + CHAR_BIT - 1) / CHAR_BIT;  // Round up
     return size;
-#endif
 }
 
 
 constexpr auto ViterbiCodec::UnencodedSize(std::size_t encodedSize,
-                                           [[maybe_unused]] bool withFlushBits) -> std::size_t
+                                           bool withFlushBits,
+                                           CodeRate codeRate) -> std::size_t
 {
-#if defined(DISABLE_CHANNEL_CODING) || defined(DISABLE_CONVOLUTIONAL_CODING)
-    return encodedSize;
-#else
+    if(codeRate == CodeRate::uncoded)
+    {
+        return encodedSize;
+    }
     auto flushingBits = withFlushBits ? nFlushBits : 0U;
-    #ifdef USE_PUNCTURING
-    auto size = (((encodedSize * CHAR_BIT) * 2 / 3) - flushingBits) / CHAR_BIT;
-    #else
-    auto size = (((encodedSize * CHAR_BIT) / 2) - flushingBits) / CHAR_BIT;
-    #endif
-    return size;
-#endif
+    auto nInputBits = codeRate == CodeRate::twoThirds ? (encodedSize * CHAR_BIT) * 2 / 3
+                                                      : (encodedSize * CHAR_BIT) / 2;
+    return (nInputBits - flushingBits) / CHAR_BIT;
+}
+
+
+constexpr auto ViterbiCodec::ComputeOutput(unsigned int shiftRegister) -> std::uint8_t
+{
+    std::uint8_t result = 0U;
+    for(auto polynomial : polynomials)
+    {
+        auto absolutePolynomial =
+            static_cast<std::uint8_t>(polynomial < 0 ? -polynomial : polynomial);
+        auto input = shiftRegister;
+        std::uint8_t output = 0U;
+        for(auto k = 0U; k < constraint; ++k)
+        {
+            output ^= static_cast<std::uint8_t>((polynomial < 0)
+                                                ^ ((input & 1U) & (absolutePolynomial & 1U)));
+            absolutePolynomial >>= 1U;
+            input >>= 1U;
+        }
+        result = static_cast<std::uint8_t>((result << 1U) | output);
+    }
+    return result;
 }
 
 
-static_assert(ViterbiCodec::maxEncodedSize
-              == ViterbiCodec::EncodedSize(ViterbiCodec::maxUnencodedSize, true));
+static_assert(
+    ViterbiCodec::maxEncodedSize
+    == ViterbiCodec::EncodedSize(ViterbiCodec::maxUnencodedSize, true, CodeRate::oneHalf));
 }
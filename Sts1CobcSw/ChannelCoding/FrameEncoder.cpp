@@ -0,0 +1,56 @@
+#include <Sts1CobcSw/ChannelCoding/FrameEncoder.hpp>
+
+
+namespace sts1cobcsw::tm
+{
+auto FrameEncoder::Start(std::span<Byte, channelAccessDataUnitLength> channelAccessDataUnit,
+                         CodingProfile profile) -> void
+{
+    auto encodedFrame = EncodeChannelAccessDataUnit(channelAccessDataUnit, profile);
+    StartConvolutionalCoding(encodedFrame, ToCodeRate(profile));
+}
+
+
+auto FrameEncoder::StartConvolutionalCoding(std::span<Byte const> data, cc::CodeRate codeRate)
+    -> void
+{
+    convolutionalCoder_ = cc::ViterbiCodec(codeRate);
+    remainingData_ = data;
+    isDone_ = false;
+}
+
+
+auto FrameEncoder::Read(std::span<Byte> encodedData) -> std::size_t
+{
+    if(isDone_)
+    {
+        return 0;
+    }
+    if(encodedData.size() < minReadSize)
+    {
+        return 0;
+    }
+    // Intermediate chunks don't need room for the flush bits but we don't care about squeezing out
+    // every last byte
+    auto codeRate = convolutionalCoder_.GetCodeRate();
+    auto maxChunkSize =
+        cc::ViterbiCodec::UnencodedSize(encodedData.size(), /*withFlushBits=*/true, codeRate);
+    if(remainingData_.size() <= maxChunkSize)
+    {
+        isDone_ = true;
+        return convolutionalCoder_.EncodeTo(remainingData_, encodedData, /*flush=*/true);
+    }
+    auto chunkSizeMultiple = codeRate == cc::CodeRate::twoThirds ? 2U : 1U;
+    auto chunkSize = maxChunkSize / chunkSizeMultiple * chunkSizeMultiple;
+    auto nEncodedBytes =
+        convolutionalCoder_.EncodeTo(remainingData_.first(chunkSize), encodedData, /*flush=*/false);
+    remainingData_ = remainingData_.subspan(chunkSize);
+    return nEncodedBytes;
+}
+
+
+auto FrameEncoder::IsDone() const -> bool
+{
+    return isDone_;
+}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+
+#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
+#include <Sts1CobcSw/ChannelCoding/External/ConvolutionalCoding.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+
+#include <cstddef>
+#include <span>
+
+
+namespace sts1cobcsw::tm
+{
+// Streaming encoder for the whole TM channel coding chain: Reed-Solomon, attached sync marker,
+// scrambling and convolutional coding. The convolutionally encoded bytes are produced on demand
+// directly into a caller-provided buffer, e.g., one with the size of the free space in the TX FIFO,
+// so no buffer for the fully encoded frame is needed.
+class FrameEncoder
+{
+public:
+    // With puncturing, a chunk with an odd number of bytes leaves 4 encoded bits behind that are
+    // only written with the next chunk. To keep the size of the last chunk predictable, all other
+    // chunks therefore contain an even number of bytes. The minimum read size must allow this for
+    // every code rate.
+    static constexpr auto minReadSize =
+        cc::ViterbiCodec::EncodedSize(2U, /*withFlushBits=*/true, cc::CodeRate::oneHalf);
+
+    // Apply Reed-Solomon coding, the attached sync marker and scrambling in place and start
+    // streaming the convolutionally encoded channel access data unit, all as selected by the coding
+    // profile. The block must contain a finished transfer frame and the buffer must stay valid
+    // until IsDone() returns true.
+    auto Start(std::span<Byte, channelAccessDataUnitLength> channelAccessDataUnit,
+               CodingProfile profile = defaultCodingProfile) -> void;
+    // Start streaming the convolutionally encoded data without applying the other coding steps,
+    // e.g., because the data is already RS encoded and scrambled. The data must stay valid until
+    // IsDone() returns true.
+    auto StartConvolutionalCoding(std::span<Byte const> data,
+                                  cc::CodeRate codeRate = cc::defaultCodeRate) -> void;
+    // Write as many encoded bytes as fit into encodedData and return their number. The last chunk
+    // includes the flush bits. Nothing is written if encodedData is smaller than minReadSize.
+    [[nodiscard]] auto Read(std::span<Byte> encodedData) -> std::size_t;
+    [[nodiscard]] auto IsDone() const -> bool;
+
+
+private:
+    std::span<Byte const> remainingData_ = {};
+    bool isDone_ = true;
+    cc::ViterbiCodec convolutionalCoder_ = cc::ViterbiCodec();
+};
+}
@@ -1,28 +1,390 @@
 #include <Sts1CobcSw/ChannelCoding/ReedSolomon.hpp>
 
-#include <libfec/fec.h>
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
 
 
 namespace sts1cobcsw::rs
 {
+namespace
+{
+// The parameters match those of libfec's CCSDS code: field generator polynomial x^8 + x^7 + x^2 +
+// x + 1, first consecutive root 112, and primitive element alpha^11
+using Symbol = std::uint8_t;
+
+constexpr auto fieldSize = 255U;
+constexpr auto fieldGeneratorPolynomial = 0x187U;
+constexpr auto firstConsecutiveRoot = 112U;
+constexpr auto primitiveElement = 11U;
+
+
+struct GaloisFieldTables
+{
+    // The powers are stored twice so that the sum of two logarithms can be used as an index
+    std::array<Symbol, 2 * fieldSize> powers = {};            // alpha^i
+    std::array<std::uint8_t, fieldSize + 1> logarithms = {};  // log_alpha(x), undefined for x = 0
+    std::array<Symbol, fieldSize + 1> fromDualBasis = {};
+    std::array<Symbol, fieldSize + 1> toDualBasis = {};
+};
+
+
+constexpr auto gf = []
+{
+    auto tables = GaloisFieldTables{};
+    auto x = 1U;
+    for(auto i = 0U; i < fieldSize; ++i)
+    {
+        tables.powers[i] = static_cast<Symbol>(x);
+        tables.powers[i + fieldSize] = static_cast<Symbol>(x);
+        tables.logarithms[x] = static_cast<std::uint8_t>(i);
+        x <<= 1U;
+        if(x > fieldSize)
+        {
+            x ^= fieldGeneratorPolynomial;
+        }
+    }
+    // Conversion matrix from CCSDS 131.0-B-5, Annex F
+    constexpr auto dualBasisMatrix =
+        std::array{0x8DU, 0xEFU, 0xECU, 0x86U, 0xFAU, 0x99U, 0xAFU, 0x7BU};
+    for(auto i = 0U; i <= fieldSize; ++i)
+    {
+        auto dualBasisSymbol = 0U;
+        for(auto row = 0U; row < dualBasisMatrix.size(); ++row)
+        {
+            if((i & (1U << row)) != 0U)
+            {
+                dualBasisSymbol ^= dualBasisMatrix[dualBasisMatrix.size() - 1 - row];
+            }
+        }
+        tables.toDualBasis[i] = static_cast<Symbol>(dualBasisSymbol);
+        tables.fromDualBasis[dualBasisSymbol] = static_cast<Symbol>(i);
+    }
+    return tables;
+}();
+
+
+constexpr auto Power(unsigned int exponent) -> Symbol
+{
+    return gf.powers[exponent % fieldSize];
+}
+
+
+constexpr auto Multiply(Symbol a, Symbol b) -> Symbol
+{
+    if(a == 0 or b == 0)
+    {
+        return 0;
+    }
+    return gf.powers[gf.logarithms[a] + gf.logarithms[b]];
+}
+
+
+constexpr auto Divide(Symbol a, Symbol b) -> Symbol
+{
+    if(a == 0)
+    {
+        return 0;
+    }
+    return gf.powers[gf.logarithms[a] + fieldSize - gf.logarithms[b]];
+}
+
+
+// The roots of the code generator polynomial are gamma^(firstConsecutiveRoot + i) with the
+// primitive element gamma = alpha^11. Return their logarithms to the base alpha.
+constexpr auto rootLogarithms = []
+{
+    auto logarithms = std::array<std::uint8_t, nParitySymbols>{};
+    for(auto i = 0U; i < logarithms.size(); ++i)
+    {
+        logarithms[i] = static_cast<std::uint8_t>(
+            (primitiveElement * (firstConsecutiveRoot + i)) % fieldSize);
+    }
+    return logarithms;
+}();
+
+
+// Coefficients of prod_i (x - root_i), the coefficient of x^i is stored at index i
+constexpr auto codeGeneratorPolynomial = []
+{
+    auto polynomial = std::array<Symbol, nParitySymbols + 1>{1};
+    for(auto i = 0U; i < rootLogarithms.size(); ++i)
+    {
+        auto root = gf.powers[rootLogarithms[i]];
+        for(auto j = i + 1; j > 0; --j)
+        {
+            polynomial[j] = polynomial[j - 1] ^ Multiply(polynomial[j], root);
+        }
+        polynomial[0] = Multiply(polynomial[0], root);
+    }
+    return polynomial;
+}();
+
+
+// The encoder is a shift register where the feedback symbol is multiplied with all coefficients of
+// the code generator polynomial. Precomputing all products replaces 32 multiplications per message
+// symbol with a single table lookup.
+constexpr auto parityFeedbackTable = []
+{
+    auto table = std::array<std::array<Symbol, nParitySymbols>, fieldSize + 1>{};
+    for(auto feedback = 0U; feedback <= fieldSize; ++feedback)
+    {
+        for(auto j = 0U; j < nParitySymbols; ++j)
+        {
+            table[feedback][j] = Multiply(static_cast<Symbol>(feedback),
+                                          codeGeneratorPolynomial[nParitySymbols - 1 - j]);
+        }
+    }
+    return table;
+}();
+
+
+// The locator of the symbol at the given index in the block is gamma^(blockLength - 1 - index).
+// Return its logarithm to the base alpha.
+constexpr auto LocatorLogarithm(unsigned int index) -> unsigned int
+{
+    return (primitiveElement * (blockLength - 1 - index)) % fieldSize;
+}
+
+
+auto Correct(std::span<Byte, blockLength> block,
+             std::span<Symbol const, nParitySymbols> syndromes,
+             std::span<std::uint8_t const> erasurePositions) -> Result<int>;
+}
+
+
 auto Encode(std::span<Byte, messageLength> message, std::span<Byte, nParitySymbols> paritySymbols)
     -> void
 {
-    // NOLINTBEGIN(*reinterpret-cast)
-    encode_rs_ccsds(reinterpret_cast<unsigned char *>(message.data()),
-                    reinterpret_cast<unsigned char *>(paritySymbols.data()));
-    // NOLINTEND(*reinterpret-cast)
+    auto parity = std::array<Symbol, nParitySymbols>{};
+    for(auto byte : message)
+    {
+        auto feedback = gf.fromDualBasis[static_cast<Symbol>(byte)] ^ parity[0];
+        std::ranges::copy(std::span(parity).subspan<1>(), parity.begin());
+        parity.back() = 0;
+        auto const & products = parityFeedbackTable[feedback];
+        for(auto j = 0U; j < parity.size(); ++j)
+        {
+            parity[j] ^= products[j];
+        }
+    }
+    for(auto j = 0U; j < parity.size(); ++j)
+    {
+        paritySymbols[j] = static_cast<Byte>(gf.toDualBasis[parity[j]]);
+    }
 }
 
 
 auto Decode(std::span<Byte, blockLength> block) -> Result<int>
 {
-    // NOLINTNEXTLINE(*reinterpret-cast)
-    auto nCorrectedErrors = decode_rs_ccsds(reinterpret_cast<unsigned char *>(block.data()));
-    if(nCorrectedErrors < 0)
+    return Decode(block, {});
+}
+
+
+auto Decode(std::span<Byte, blockLength> block, std::span<std::uint8_t const> erasurePositions)
+    -> Result<int>
+{
+    auto syndromeAccumulator = SyndromeAccumulator{};
+    syndromeAccumulator.Update(block);
+    return Decode(block, syndromeAccumulator, erasurePositions);
+}
+
+
+auto Decode(std::span<Byte, blockLength> block,
+            SyndromeAccumulator const & syndromeAccumulator,
+            std::span<std::uint8_t const> erasurePositions) -> Result<int>
+{
+    assert(syndromeAccumulator.IsComplete());
+    if(erasurePositions.size() > maxNErasures)
     {
         return ErrorCode::errorCorrectionFailed;
     }
-    return nCorrectedErrors;
+    if(std::ranges::any_of(erasurePositions,
+                           [](auto position) { return position >= blockLength; }))
+    {
+        return ErrorCode::invalidParameter;
+    }
+    auto syndromes = syndromeAccumulator.Syndromes();
+    if(std::ranges::all_of(syndromes, [](auto syndrome) { return syndrome == 0; }))
+    {
+        return 0;
+    }
+    return Correct(block, syndromes, erasurePositions);
+}
+
+
+auto SyndromeAccumulator::Reset() -> void
+{
+    syndromes_ = {};
+    nSymbols_ = 0;
+}
+
+
+auto SyndromeAccumulator::Update(std::span<Byte const> symbols) -> void
+{
+    assert(nSymbols_ + symbols.size() <= blockLength);
+    for(auto byte : symbols)
+    {
+        auto symbol = gf.fromDualBasis[static_cast<Symbol>(byte)];
+        // One step of Horner's method for the evaluation of the codeword polynomial at every root
+        for(auto i = 0U; i < nParitySymbols; ++i)
+        {
+            auto & syndrome = syndromes_[i];
+            if(syndrome != 0)
+            {
+                syndrome = gf.powers[gf.logarithms[syndrome] + rootLogarithms[i]];
+            }
+            syndrome ^= symbol;
+        }
+    }
+    nSymbols_ += symbols.size();
+}
+
+
+auto SyndromeAccumulator::IsComplete() const -> bool
+{
+    return nSymbols_ == blockLength;
+}
+
+
+auto SyndromeAccumulator::Syndromes() const -> std::span<std::uint8_t const, nParitySymbols>
+{
+    return syndromes_;
+}
+
+
+namespace
+{
+
+// Berlekamp-Massey with the erasure locator as the initial error locator, followed by a Chien
+// search and the Forney algorithm, see e.g. "Error Control Coding" by Lin and Costello
+auto Correct(std::span<Byte, blockLength> block,
+             std::span<Symbol const, nParitySymbols> syndromes,
+             std::span<std::uint8_t const> erasurePositions) -> Result<int>
+{
+    // Error locator polynomial, initialized with the erasure locator polynomial
+    // prod_k (1 - X_k x) where X_k are the locators of the erasures
+    auto locator = std::array<Symbol, nParitySymbols + 1>{1};
+    for(auto k = 0U; k < erasurePositions.size(); ++k)
+    {
+        auto erasureLocator = Power(LocatorLogarithm(erasurePositions[k]));
+        for(auto i = k + 1; i > 0; --i)
+        {
+            locator[i] ^= Multiply(erasureLocator, locator[i - 1]);
+        }
+    }
+    auto nErasures = static_cast<unsigned int>(erasurePositions.size());
+    auto previousLocator = locator;
+    auto locatorLength = nErasures;
+    for(auto r = nErasures + 1; r <= nParitySymbols; ++r)
+    {
+        auto discrepancy = Symbol{0};
+        for(auto i = 0U; i < r; ++i)
+        {
+            discrepancy ^= Multiply(locator[i], syndromes[r - i - 1]);
+        }
+        // previousLocator is always multiplied by x, so we shift it right away
+        std::ranges::copy_backward(std::span(previousLocator).first<nParitySymbols>(),
+                                   previousLocator.end());
+        previousLocator[0] = 0;
+        if(discrepancy == 0)
+        {
+            continue;
+        }
+        auto newLocator = locator;
+        for(auto i = 0U; i < locator.size(); ++i)
+        {
+            newLocator[i] ^= Multiply(discrepancy, previousLocator[i]);
+        }
+        if(2 * locatorLength <= r + nErasures - 1)
+        {
+            locatorLength = r + nErasures - locatorLength;
+            for(auto i = 0U; i < locator.size(); ++i)
+            {
+                previousLocator[i] = Divide(locator[i], discrepancy);
+            }
+        }
+        locator = newLocator;
+    }
+    auto locatorDegree = 0U;
+    for(auto i = 0U; i < locator.size(); ++i)
+    {
+        if(locator[i] != 0)
+        {
+            locatorDegree = i;
+        }
+    }
+
+    // Error evaluator polynomial = syndromes(x) * locator(x) mod x^nParitySymbols
+    auto evaluator = std::array<Symbol, nParitySymbols>{};
+    for(auto i = 0U; i < nParitySymbols; ++i)
+    {
+        for(auto j = 0U; j <= std::min(i, locatorDegree); ++j)
+        {
+            evaluator[i] ^= Multiply(locator[j], syndromes[i - j]);
+        }
+    }
+
+    // Chien search and Forney algorithm. The corrections are only applied once we know that the
+    // block is correctable.
+    auto errorPositions = std::array<std::uint8_t, nParitySymbols>{};
+    auto errorValues = std::array<Symbol, nParitySymbols>{};
+    auto nErrors = 0U;
+    for(auto position = 0U; position < blockLength; ++position)
+    {
+        // Evaluate at the inverse of the locator of the position
+        auto inverseLocatorLogarithm = fieldSize - LocatorLogarithm(position);
+        auto locatorValue = Symbol{0};
+        auto derivativeValue = Symbol{0};
+        for(auto i = 0U; i <= locatorDegree; ++i)
+        {
+            auto term = Multiply(locator[i], Power(i * inverseLocatorLogarithm));
+            locatorValue ^= term;
+            if(i % 2 == 1)
+            {
+                // Formal derivative times x
+                derivativeValue ^= term;
+            }
+        }
+        if(locatorValue != 0)
+        {
+            continue;
+        }
+        if(nErrors == nParitySymbols or derivativeValue == 0)
+        {
+            return ErrorCode::errorCorrectionFailed;
+        }
+        auto evaluatorValue = Symbol{0};
+        for(auto i = 0U; i < nParitySymbols; ++i)
+        {
+            evaluatorValue ^= Multiply(evaluator[i], Power(i * inverseLocatorLogarithm));
+        }
+        // e = X^(1 - firstConsecutiveRoot) * evaluator(X^-1) / derivative(X^-1) and derivativeValue
+        // = X^-1 * derivative(X^-1), i.e., e = X^-firstConsecutiveRoot * evaluatorValue /
+        // derivativeValue
+        auto scale = Power(firstConsecutiveRoot * inverseLocatorLogarithm);
+        errorPositions[nErrors] = static_cast<std::uint8_t>(position);
+        errorValues[nErrors] = Multiply(scale, Divide(evaluatorValue, derivativeValue));
+        ++nErrors;
+    }
+    if(nErrors != locatorDegree)
+    {
+        return ErrorCode::errorCorrectionFailed;
+    }
+    // Erasures that turn out to be correct have an error value of 0 and are not counted. Since the
+    // dual-basis conversion is linear, the error values can be converted and applied directly.
+    auto nCorrectedSymbols = 0;
+    for(auto i = 0U; i < nErrors; ++i)
+    {
+        if(errorValues[i] == 0)
+        {
+            continue;
+        }
+        block[errorPositions[i]] ^= static_cast<Byte>(gf.toDualBasis[errorValues[i]]);
+        ++nCorrectedSymbols;
+    }
+    return nCorrectedSymbols;
+}
 }
 }
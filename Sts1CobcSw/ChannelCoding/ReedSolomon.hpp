@@ -4,23 +4,70 @@
 #include <Sts1CobcSw/Outcome/Outcome.hpp>
 #include <Sts1CobcSw/Serial/Byte.hpp>
 
-#include <libfec/fixed.h>
-// The macro FCR that is defined in libfec/fec.h clashes with a struct member name in a CMSIS
-// header. Since we don't need the FCR macro, we can undefine it here to avoid the clash.
-#undef FCR
-
+#include <array>
+#include <cstddef>
+#include <cstdint>
 #include <span>
 
 
 namespace sts1cobcsw::rs
 {
-inline constexpr auto blockLength = NN;
-inline constexpr auto nParitySymbols = NROOTS;
-inline constexpr auto messageLength = NN - NROOTS;
+// The (255, 223) Reed-Solomon code from CCSDS 131.0-B-5, section 4, with symbols in dual-basis
+// representation. Encoding and decoding are bit-identical to libfec's encode_rs_ccsds() and
+// decode_rs_ccsds().
+inline constexpr auto blockLength = 255;
+inline constexpr auto nParitySymbols = 32;
+inline constexpr auto messageLength = blockLength - nParitySymbols;
+// Every erasure costs one parity symbol instead of two like an error
+inline constexpr auto maxNErasures = static_cast<std::size_t>(nParitySymbols);
+
+
+// Computes the syndromes of a block while its symbols are still arriving, one chunk at a time, so
+// that only the error correction is left once the last symbol is there
+class SyndromeAccumulator
+{
+public:
+    auto Reset() -> void;
+    // Add the next symbols of the block
+    auto Update(std::span<Byte const> symbols) -> void;
+    // Return true if all blockLength symbols were added
+    [[nodiscard]] auto IsComplete() const -> bool;
+    [[nodiscard]] auto Syndromes() const -> std::span<std::uint8_t const, nParitySymbols>;
+
+
+private:
+    std::array<std::uint8_t, nParitySymbols> syndromes_ = {};
+    std::size_t nSymbols_ = 0;
+};
 
 
 auto Encode(std::span<Byte, messageLength> message, std::span<Byte, nParitySymbols> paritySymbols)
     -> void;
-// Return the number of corrected errors
+// Return the number of corrected errors. Blocks without errors, i.e., the common case, are detected
+// early by checking if all syndromes are zero.
 auto Decode(std::span<Byte, blockLength> block) -> Result<int>;
+// Decode a block where the symbols at the given positions are known to be unreliable. Up to
+// nErrors errors and nErasures erasures can be corrected as long as 2 * nErrors + nErasures <=
+// nParitySymbols. Return the number of corrected symbols.
+auto Decode(std::span<Byte, blockLength> block, std::span<std::uint8_t const> erasurePositions)
+    -> Result<int>;
+// Like Decode() but with the syndromes that were already accumulated while the block was received.
+// All symbols of the block must have been added to the accumulator.
+auto Decode(std::span<Byte, blockLength> block,
+            SyndromeAccumulator const & syndromeAccumulator,
+            std::span<std::uint8_t const> erasurePositions) -> Result<int>;
+
+// Interleaved Reed-Solomon coding as described in CCSDS 131.0-B-5, section 4.3.4: The i-th symbol
+// of the j-th codeword is stored at index i * interleavingDepth + j, so a burst of up to
+// interleavingDepth * nParitySymbols / 2 corrupted bytes can be corrected.
+template<std::size_t interleavingDepth>
+auto EncodeInterleaved(std::span<Byte, interleavingDepth * messageLength> message,
+                       std::span<Byte, interleavingDepth * nParitySymbols> paritySymbols) -> void;
+// Return the total number of corrected errors. Decoding fails if any of the codewords cannot be
+// corrected.
+template<std::size_t interleavingDepth>
+auto DecodeInterleaved(std::span<Byte, interleavingDepth * blockLength> block) -> Result<int>;
 }
+
+
+#include <Sts1CobcSw/ChannelCoding/ReedSolomon.ipp>
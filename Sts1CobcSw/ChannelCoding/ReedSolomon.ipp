@@ -0,0 +1,80 @@
+#pragma once
+
+
+#include <Sts1CobcSw/ChannelCoding/ReedSolomon.hpp>
+
+#include <array>
+
+
+namespace sts1cobcsw::rs
+{
+template<std::size_t interleavingDepth>
+auto EncodeInterleaved(std::span<Byte, interleavingDepth * messageLength> message,
+                       std::span<Byte, interleavingDepth * nParitySymbols> paritySymbols) -> void
+{
+    static_assert(interleavingDepth >= 1);
+    if constexpr(interleavingDepth == 1)
+    {
+        Encode(message, paritySymbols);
+    }
+    else
+    {
+        auto codewordMessage = std::array<Byte, messageLength>{};
+        auto codewordParitySymbols = std::array<Byte, nParitySymbols>{};
+        for(auto j = 0U; j < interleavingDepth; ++j)
+        {
+            for(auto i = 0U; i < messageLength; ++i)
+            {
+                codewordMessage[i] = message[i * interleavingDepth + j];
+            }
+            Encode(codewordMessage, codewordParitySymbols);
+            for(auto i = 0U; i < nParitySymbols; ++i)
+            {
+                paritySymbols[i * interleavingDepth + j] = codewordParitySymbols[i];
+            }
+        }
+    }
+}
+
+
+template<std::size_t interleavingDepth>
+auto DecodeInterleaved(std::span<Byte, interleavingDepth * blockLength> block) -> Result<int>
+{
+    static_assert(interleavingDepth >= 1);
+    if constexpr(interleavingDepth == 1)
+    {
+        return Decode(block);
+    }
+    else
+    {
+        auto codeword = std::array<Byte, blockLength>{};
+        auto nCorrectedErrors = 0;
+        auto decodingFailed = false;
+        for(auto j = 0U; j < interleavingDepth; ++j)
+        {
+            for(auto i = 0U; i < blockLength; ++i)
+            {
+                codeword[i] = block[i * interleavingDepth + j];
+            }
+            auto decodeResult = Decode(codeword);
+            if(decodeResult.has_error())
+            {
+                // Keep decoding the other codewords so that as much of the block as possible is
+                // corrected
+                decodingFailed = true;
+                continue;
+            }
+            nCorrectedErrors += decodeResult.value();
+            for(auto i = 0U; i < blockLength; ++i)
+            {
+                block[i * interleavingDepth + j] = codeword[i];
+            }
+        }
+        if(decodingFailed)
+        {
+            return ErrorCode::errorCorrectionFailed;
+        }
+        return nCorrectedErrors;
+    }
+}
+}
@@ -1,8 +1,11 @@
 #pragma once
 
 
+#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
+#include <Sts1CobcSw/ChannelCoding/ReedSolomon.hpp>
 #include <Sts1CobcSw/Serial/Byte.hpp>
 
+#include <cstddef>
 #include <span>
 
 
@@ -12,11 +15,19 @@ namespace tc
 {
 auto Scramble(std::span<Byte> data) -> void;
 auto Unscramble(std::span<Byte> data) -> void;
+// Unscramble the part of a block that starts at the given offset, e.g., a chunk that was just
+// received
+auto Unscramble(std::span<Byte> data, std::size_t offset) -> void;
 }
 
 namespace tm
 {
 auto Scramble(std::span<Byte> data) -> void;
 auto Unscramble(std::span<Byte> data) -> void;
+// Write the attached sync marker to the beginning of the channel access data unit and scramble the
+// Reed-Solomon block after it in a single pass
+auto AttachSynchMarkerAndScramble(
+    std::span<Byte, attachedSynchMarker.size() + interleavingDepth * rs::blockLength>
+        channelAccessDataUnit) -> void;
 }
 }
@@ -0,0 +1,169 @@
+#include <Sts1CobcSw/ChannelCoding/SynchMarkerCorrelator.hpp>
+
+#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <climits>
+#include <cstdint>
+
+
+namespace sts1cobcsw
+{
+namespace
+{
+constexpr auto synchMarkerWord = []
+{
+    auto word = std::uint32_t{0};
+    for(auto byte : attachedSynchMarker)
+    {
+        word = (word << CHAR_BIT) | static_cast<std::uint8_t>(byte);
+    }
+    return word;
+}();
+constexpr auto nSynchMarkerBits = std::size_t{32};
+static_assert(attachedSynchMarker.size() * CHAR_BIT == nSynchMarkerBits);
+static_assert(synchMarkerWord == 0x1ACF'FC1DU);
+
+
+[[nodiscard]] auto GetBit(std::span<Byte const> stream, std::size_t bitOffset) -> std::uint32_t;
+[[nodiscard]] auto ReadWord(std::span<Byte const> stream, std::size_t bitOffset) -> std::uint32_t;
+[[nodiscard]] auto NBitErrors(std::uint32_t word) -> unsigned int;
+}
+
+
+auto FindSynchMarker(std::span<Byte const> stream,
+                     std::size_t startBitOffset,
+                     unsigned int maxNBitErrors) -> Result<SynchMarkerPosition>
+{
+    auto nBits = stream.size() * CHAR_BIT;
+    if(startBitOffset + nSynchMarkerBits > nBits)
+    {
+        return ErrorCode::synchMarkerNotFound;
+    }
+    // Shift the stream bit by bit through a 32-bit window instead of reading 4 or 5 bytes for every
+    // bit offset
+    auto window = ReadWord(stream, startBitOffset);
+    for(auto bitOffset = startBitOffset;; ++bitOffset)
+    {
+        auto nBitErrors = NBitErrors(window);
+        if(nBitErrors <= maxNBitErrors)
+        {
+            return SynchMarkerPosition{.bitOffset = bitOffset, .nBitErrors = nBitErrors};
+        }
+        auto iNextBit = bitOffset + nSynchMarkerBits;
+        if(iNextBit >= nBits)
+        {
+            break;
+        }
+        window = (window << 1U) | GetBit(stream, iNextBit);
+    }
+    return ErrorCode::synchMarkerNotFound;
+}
+
+
+auto FindSynchMarkerNear(std::span<Byte const> stream,
+                         std::size_t expectedBitOffset,
+                         std::size_t maxNSlippedBits,
+                         unsigned int maxNBitErrors) -> Result<SynchMarkerPosition>
+{
+    auto nBits = stream.size() * CHAR_BIT;
+    if(nBits < nSynchMarkerBits)
+    {
+        return ErrorCode::synchMarkerNotFound;
+    }
+    auto firstBitOffset = expectedBitOffset - std::min(expectedBitOffset, maxNSlippedBits);
+    auto lastBitOffset = std::min(expectedBitOffset + maxNSlippedBits, nBits - nSynchMarkerBits);
+    auto bestPosition = SynchMarkerPosition{.bitOffset = 0, .nBitErrors = maxNBitErrors + 1U};
+    auto bestDistance = std::size_t{0};
+    for(auto bitOffset = firstBitOffset; bitOffset <= lastBitOffset; ++bitOffset)
+    {
+        auto nBitErrors = NBitErrors(ReadWord(stream, bitOffset));
+        auto distance = bitOffset < expectedBitOffset ? expectedBitOffset - bitOffset
+                                                      : bitOffset - expectedBitOffset;
+        if(nBitErrors < bestPosition.nBitErrors
+           or (nBitErrors == bestPosition.nBitErrors and distance < bestDistance))
+        {
+            bestPosition = {.bitOffset = bitOffset, .nBitErrors = nBitErrors};
+            bestDistance = distance;
+        }
+    }
+    if(bestPosition.nBitErrors > maxNBitErrors)
+    {
+        return ErrorCode::synchMarkerNotFound;
+    }
+    return bestPosition;
+}
+
+
+auto CopyBits(std::span<Byte const> stream, std::size_t bitOffset, std::span<Byte> destination)
+    -> void
+{
+    assert(bitOffset + destination.size() * CHAR_BIT <= stream.size() * CHAR_BIT);
+    auto iFirstByte = bitOffset / CHAR_BIT;
+    auto shift = static_cast<unsigned>(bitOffset % CHAR_BIT);
+    if(shift == 0U)
+    {
+        std::copy_n(stream.begin() + static_cast<std::ptrdiff_t>(iFirstByte),
+                    destination.size(),
+                    destination.begin());
+        return;
+    }
+    for(auto i = 0U; i < destination.size(); ++i)
+    {
+        auto high = static_cast<unsigned>(stream[iFirstByte + i]) << shift;
+        // The last destination byte might not need any bits from the byte after it
+        auto iNextByte = iFirstByte + i + 1U;
+        auto low = iNextByte < stream.size()
+                     ? static_cast<unsigned>(stream[iNextByte]) >> (CHAR_BIT - shift)
+                     : 0U;
+        destination[i] = static_cast<Byte>((high | low) & 0xFFU);
+    }
+}
+
+
+auto ShiftBitsLeft(std::span<Byte> data, unsigned int nBits, Byte nextByte) -> void
+{
+    assert(nBits < CHAR_BIT);
+    if(nBits == 0U or data.empty())
+    {
+        return;
+    }
+    for(auto i = 0U; i < data.size(); ++i)
+    {
+        auto next = i + 1U < data.size() ? data[i + 1U] : nextByte;
+        auto high = static_cast<unsigned>(data[i]) << nBits;
+        auto low = static_cast<unsigned>(next) >> (CHAR_BIT - nBits);
+        data[i] = static_cast<Byte>((high | low) & 0xFFU);
+    }
+}
+
+
+namespace
+{
+auto GetBit(std::span<Byte const> stream, std::size_t bitOffset) -> std::uint32_t
+{
+    return (static_cast<std::uint32_t>(stream[bitOffset / CHAR_BIT])
+            >> (CHAR_BIT - 1U - (bitOffset % CHAR_BIT)))
+         & 1U;
+}
+
+
+auto ReadWord(std::span<Byte const> stream, std::size_t bitOffset) -> std::uint32_t
+{
+    auto word = std::uint32_t{0};
+    for(auto i = 0U; i < nSynchMarkerBits; ++i)
+    {
+        word = (word << 1U) | GetBit(stream, bitOffset + i);
+    }
+    return word;
+}
+
+
+auto NBitErrors(std::uint32_t word) -> unsigned int
+{
+    return static_cast<unsigned int>(std::popcount(word ^ synchMarkerWord));
+}
+}
+}
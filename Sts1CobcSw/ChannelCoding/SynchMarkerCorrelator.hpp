@@ -0,0 +1,48 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+
+#include <cstddef>
+#include <span>
+
+
+namespace sts1cobcsw
+{
+// A received attached sync marker is accepted if it differs from the real one in at most this many
+// bits. The probability that 32 random bits are accepted is then about 1.3e-6 per bit position.
+inline constexpr auto maxNSynchMarkerBitErrors = 3U;
+
+
+struct SynchMarkerPosition
+{
+    std::size_t bitOffset = 0;  // Offset of the first bit of the sync marker, MSB first
+    unsigned int nBitErrors = 0;
+};
+
+
+// Search the bit stream for the attached sync marker, starting at the given bit offset. Return the
+// first position at which the marker is found with at most maxNBitErrors wrong bits. Since the
+// search is done bit by bit, frames need not be aligned to byte boundaries.
+[[nodiscard]] auto FindSynchMarker(std::span<Byte const> stream,
+                                   std::size_t startBitOffset = 0,
+                                   unsigned int maxNBitErrors = maxNSynchMarkerBitErrors)
+    -> Result<SynchMarkerPosition>;
+// Search for the attached sync marker only within maxNSlippedBits of the expected bit offset, e.g.,
+// right after the end of the previous frame, and return the best match. On ties, the position
+// closest to the expected one wins. This allows following back-to-back frames through bit slips.
+[[nodiscard]] auto FindSynchMarkerNear(std::span<Byte const> stream,
+                                       std::size_t expectedBitOffset,
+                                       std::size_t maxNSlippedBits,
+                                       unsigned int maxNBitErrors = maxNSynchMarkerBitErrors)
+    -> Result<SynchMarkerPosition>;
+// Copy destination.size() bytes starting at an arbitrary bit offset from the stream to the
+// destination, i.e., realign the data to byte boundaries. The stream must contain enough bits.
+auto CopyBits(std::span<Byte const> stream, std::size_t bitOffset, std::span<Byte> destination)
+    -> void;
+// Realign data that starts nBits < CHAR_BIT into its first byte in place by shifting it to the
+// left. The gap at the end is filled with the high bits of nextByte, i.e., the stream byte after
+// data.
+auto ShiftBitsLeft(std::span<Byte> data, unsigned int nBits, Byte nextByte) -> void;
+}
@@ -0,0 +1,246 @@
+#include <Sts1CobcSw/ChannelCoding/ViterbiDecoder.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <limits>
+
+
+namespace sts1cobcsw::cc
+{
+using sts1cobcsw::operator""_b;
+
+
+namespace
+{
+// Marks a punctured, i.e., not transmitted, code bit. It does not contribute to any branch metric.
+constexpr auto erasure = ViterbiDecoder::SoftBit{0xFF};
+// All states except 0 start with this metric because the encoder always starts in state 0
+constexpr auto initialPathMetric = std::uint16_t{0x1000};
+// Path metrics only grow, so we subtract the minimum from all of them before they can overflow
+constexpr auto renormalizationThreshold = std::uint16_t{0x8000};
+
+constexpr auto outputs = []
+{
+    auto outputs = std::array<std::uint8_t, 2U * ViterbiDecoder::nStates>{};
+    for(auto i = 0U; i < outputs.size(); ++i)
+    {
+        outputs[i] = ViterbiCodec::ComputeOutput(i);
+    }
+    return outputs;
+}();
+
+
+[[nodiscard]] constexpr auto NDecodableBytes(std::size_t nCodeBits, CodeRate codeRate)
+    -> std::size_t;
+[[nodiscard]] constexpr auto Distance(unsigned int bit, ViterbiDecoder::SoftBit softBit)
+    -> std::uint16_t;
+}
+
+
+ViterbiDecoder::ViterbiDecoder(CodeRate codeRate) : codeRate_(codeRate)
+{}
+
+
+auto ViterbiDecoder::Decode(std::span<Byte const> encodedData, std::span<Byte> decodedData)
+    -> std::size_t
+{
+    auto nDecodedBytes = NDecodableBytes(encodedData.size() * CHAR_BIT, codeRate_);
+    assert(decodedData.size() >= nDecodedBytes);
+    if(codeRate_ == CodeRate::uncoded)
+    {
+        std::copy_n(encodedData.begin(), nDecodedBytes, decodedData.begin());
+        return nDecodedBytes;
+    }
+    DoDecode(
+        nDecodedBytes,
+        [&](std::size_t i)
+        {
+            auto bit = static_cast<unsigned>(encodedData[i / CHAR_BIT])
+                    >> (CHAR_BIT - 1U - (i % CHAR_BIT));
+            return (bit & 1U) == 1U ? maxSoftBit : SoftBit{0};
+        },
+        decodedData);
+    return nDecodedBytes;
+}
+
+
+auto ViterbiDecoder::DecodeSoft(std::span<SoftBit const> softBits, std::span<Byte> decodedData)
+    -> std::size_t
+{
+    auto nDecodedBytes = NDecodableBytes(softBits.size(), codeRate_);
+    assert(decodedData.size() >= nDecodedBytes);
+    if(codeRate_ == CodeRate::uncoded)
+    {
+        std::fill_n(decodedData.begin(), nDecodedBytes, 0x00_b);
+        for(auto i = 0U; i < nDecodedBytes * CHAR_BIT; ++i)
+        {
+            if(softBits[i] > maxSoftBit / 2)
+            {
+                decodedData[i / CHAR_BIT] |=
+                    static_cast<Byte>(1U << (CHAR_BIT - 1U - (i % CHAR_BIT)));
+            }
+        }
+        return nDecodedBytes;
+    }
+    DoDecode(
+        nDecodedBytes, [&](std::size_t i) { return softBits[i]; }, decodedData);
+    return nDecodedBytes;
+}
+
+
+template<typename GetSoftBit>
+auto ViterbiDecoder::DoDecode(std::size_t nDecodedBytes,
+                              GetSoftBit getSoftBit,
+                              std::span<Byte> decodedData) -> void
+{
+    Reset();
+    decodedData = decodedData.first(nDecodedBytes);
+    std::ranges::fill(decodedData, 0x00_b);
+    auto nSteps = nDecodedBytes * CHAR_BIT + ViterbiCodec::nFlushBits;
+    auto iFirstUndecidedStep = std::size_t{0};
+    for(auto iStep = std::size_t{0}; iStep < nSteps; ++iStep)
+    {
+        if(codeRate_ == CodeRate::twoThirds)
+        {
+            // Every two input bits are encoded into three code bits, because the first parity bit
+            // of every second input bit is punctured
+            auto iCodeBit = iStep / 2U * 3U;
+            if(iStep % 2U == 0U)
+            {
+                Step(getSoftBit(iCodeBit), getSoftBit(iCodeBit + 1U), iStep);
+            }
+            else
+            {
+                Step(erasure, getSoftBit(iCodeBit + 2U), iStep);
+            }
+        }
+        else
+        {
+            Step(getSoftBit(2U * iStep), getSoftBit(2U * iStep + 1U), iStep);
+        }
+        if(iStep + 1U - iFirstUndecidedStep == decisions_.size())
+        {
+            auto bestState = std::ranges::min_element(pathMetrics_) - pathMetrics_.begin();
+            Traceback(static_cast<unsigned int>(bestState),
+                      iStep + 1U,
+                      iFirstUndecidedStep,
+                      nBitsPerTraceback,
+                      decodedData);
+            iFirstUndecidedStep += nBitsPerTraceback;
+        }
+    }
+    // The flush bits always drive the encoder back to state 0
+    Traceback(0U, nSteps, iFirstUndecidedStep, nSteps - iFirstUndecidedStep, decodedData);
+}
+
+
+auto ViterbiDecoder::Reset() -> void
+{
+    pathMetrics_.fill(initialPathMetric);
+    pathMetrics_[0] = 0;
+}
+
+
+// Add-compare-select for all states of a single trellis step
+auto ViterbiDecoder::Step(SoftBit softBit0, SoftBit softBit1, std::size_t iStep) -> void
+{
+    static constexpr auto inputShift = ViterbiCodec::constraint - 1U;
+    // The index is the expected output, i.e., the two parity bits
+    auto branchMetrics = std::array<PathMetric, 4>{};
+    for(auto i = 0U; i < branchMetrics.size(); ++i)
+    {
+        branchMetrics[i] =
+            static_cast<PathMetric>(Distance(i >> 1U, softBit0) + Distance(i & 1U, softBit1));
+    }
+    auto newPathMetrics = decltype(pathMetrics_){};
+    auto decisions = Decisions{0};
+    auto minPathMetric = std::numeric_limits<PathMetric>::max();
+    for(auto state = 0U; state < nStates; ++state)
+    {
+        // The newest input bit is the MSB of the state and the oldest one is shifted out on the
+        // right, so every state has two predecessors that only differ in their LSB
+        auto input = state >> (inputShift - 1U);
+        auto previousState0 = (state << 1U) & (nStates - 1U);
+        auto previousState1 = previousState0 | 1U;
+        auto pathMetric0 = static_cast<PathMetric>(
+            pathMetrics_[previousState0]
+            + branchMetrics[outputs[previousState0 | (input << inputShift)]]);
+        auto pathMetric1 = static_cast<PathMetric>(
+            pathMetrics_[previousState1]
+            + branchMetrics[outputs[previousState1 | (input << inputShift)]]);
+        if(pathMetric1 < pathMetric0)
+        {
+            newPathMetrics[state] = pathMetric1;
+            decisions |= Decisions{1} << state;
+        }
+        else
+        {
+            newPathMetrics[state] = pathMetric0;
+        }
+        minPathMetric = std::min(minPathMetric, newPathMetrics[state]);
+    }
+    if(minPathMetric >= renormalizationThreshold)
+    {
+        for(auto & pathMetric : newPathMetrics)
+        {
+            pathMetric -= minPathMetric;
+        }
+    }
+    pathMetrics_ = newPathMetrics;
+    decisions_[iStep % decisions_.size()] = decisions;
+}
+
+
+// Trace back from the given state at step iEndStep - 1 to step iBeginStep and write the input bits
+// of the first nBits steps to decodedData. Bits beyond the end of decodedData (the flush bits) are
+// dropped.
+auto ViterbiDecoder::Traceback(unsigned int state,
+                               std::size_t iEndStep,
+                               std::size_t iBeginStep,
+                               std::size_t nBits,
+                               std::span<Byte> decodedData) const -> void
+{
+    static constexpr auto inputShift = ViterbiCodec::constraint - 2U;
+    for(auto iStep = iEndStep; iStep-- > iBeginStep;)
+    {
+        if(iStep < iBeginStep + nBits and iStep < decodedData.size() * CHAR_BIT
+           and (state >> inputShift) == 1U)
+        {
+            decodedData[iStep / CHAR_BIT] |=
+                static_cast<Byte>(1U << (CHAR_BIT - 1U - (iStep % CHAR_BIT)));
+        }
+        auto decision = static_cast<unsigned int>(decisions_[iStep % decisions_.size()] >> state)
+                      & 1U;
+        state = ((state << 1U) & (nStates - 1U)) | decision;
+    }
+}
+
+
+namespace
+{
+constexpr auto NDecodableBytes(std::size_t nCodeBits, CodeRate codeRate) -> std::size_t
+{
+    if(codeRate == CodeRate::uncoded)
+    {
+        return nCodeBits / CHAR_BIT;
+    }
+    auto nInputBits = codeRate == CodeRate::twoThirds ? nCodeBits * 2U / 3U : nCodeBits / 2U;
+    if(nInputBits < ViterbiCodec::nFlushBits)
+    {
+        return 0;
+    }
+    return (nInputBits - ViterbiCodec::nFlushBits) / CHAR_BIT;
+}
+
+
+constexpr auto Distance(unsigned int bit, ViterbiDecoder::SoftBit softBit) -> std::uint16_t
+{
+    if(softBit == erasure)
+    {
+        return 0;
+    }
+    softBit = std::min(softBit, ViterbiDecoder::maxSoftBit);
+    return bit == 1U ? ViterbiDecoder::maxSoftBit - softBit : softBit;
+}
+}
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+
+#include <Sts1CobcSw/ChannelCoding/External/ConvolutionalCoding.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+namespace sts1cobcsw::cc
+{
+// Viterbi decoder for the convolutional code produced by ViterbiCodec, i.e., K = 7, r = 1/2 or the
+// punctured r = 2/3 code. Only flushed data, i.e., data encoded with Encode(data, /*flush=*/true),
+// can be decoded. The traceback is done in a sliding window of fixed
+// length, so the amount of memory used is independent of the length of the decoded data.
+class ViterbiDecoder
+{
+public:
+    // A soft bit is a 3-bit value where 0 means "certainly a 0" and maxSoftBit means "certainly a
+    // 1". The values in between express how confident the demodulator is.
+    using SoftBit = std::uint8_t;
+    static constexpr auto maxSoftBit = SoftBit{7};
+
+    static constexpr auto nStates = 1U << (ViterbiCodec::constraint - 1U);
+    // The traceback length should be at least 5 * constraint. Every time the window is full, the
+    // oldest nBitsPerTraceback bits are decided.
+    static constexpr auto tracebackLength = 64U;
+    static constexpr auto nBitsPerTraceback = 32U;
+
+    explicit ViterbiDecoder(CodeRate codeRate = defaultCodeRate);
+
+    // Decode hard-decision data and return the number of decoded bytes. decodedData must have room
+    // for at least UnencodedSize(encodedData.size(), /*withFlushBits=*/true, codeRate) bytes, where
+    // codeRate is the one the decoder was constructed with.
+    [[nodiscard]] auto Decode(std::span<Byte const> encodedData, std::span<Byte> decodedData)
+        -> std::size_t;
+    // Decode soft-decision data with one soft bit per transmitted code bit and return the number of
+    // decoded bytes. Punctured bits are not transmitted and must therefore not be part of softBits.
+    [[nodiscard]] auto DecodeSoft(std::span<SoftBit const> softBits, std::span<Byte> decodedData)
+        -> std::size_t;
+
+
+private:
+    using PathMetric = std::uint16_t;
+    // Since there are only 64 states, the decisions of one trellis step fit into a single integer
+    using Decisions = std::uint64_t;
+    static_assert(nStates <= sizeof(Decisions) * CHAR_BIT);
+
+    CodeRate codeRate_ = defaultCodeRate;
+    std::array<PathMetric, nStates> pathMetrics_ = {};
+    std::array<Decisions, tracebackLength + nBitsPerTraceback> decisions_ = {};
+
+    template<typename GetSoftBit>
+    auto DoDecode(std::size_t nDecodedBytes, GetSoftBit getSoftBit, std::span<Byte> decodedData)
+        -> void;
+    auto Reset() -> void;
+    auto Step(SoftBit softBit0, SoftBit softBit1, std::size_t iStep) -> void;
+    auto Traceback(unsigned int state,
+                   std::size_t iEndStep,
+                   std::size_t iBeginStep,
+                   std::size_t nBits,
+                   std::span<Byte> decodedData) const -> void;
+};
+}
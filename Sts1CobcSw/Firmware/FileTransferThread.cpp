@@ -1,6 +1,5 @@
 #include <Sts1CobcSw/Firmware/FileTransferThread.hpp>
 
-#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
 #include <Sts1CobcSw/ErrorDetectionAndCorrection/EdacVariable.hpp>
 #include <Sts1CobcSw/FileSystem/File.hpp>
 #include <Sts1CobcSw/Firmware/RfCommunicationThread.hpp>
@@ -12,6 +11,7 @@
 #include <Sts1CobcSw/FramSections/PersistentVariables.hpp>
 #include <Sts1CobcSw/Mailbox/Mailbox.hpp>
 #include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/Rf/TcBlockPool.hpp>
 #include <Sts1CobcSw/RfProtocols/CcsdsFileDeliveryProtocol.hpp>
 #include <Sts1CobcSw/RfProtocols/Configuration.hpp>
 #include <Sts1CobcSw/RfProtocols/FileTransferTimer.hpp>
@@ -72,12 +72,17 @@ enum class InterruptCondition : std::uint8_t
 
 
 constexpr auto stackSize = 6000U;
+// How long we wait for room in the CFDP frame queue before checking the received PDUs again
+constexpr auto frameQueuePollingInterval = 1 * s;
 
-auto encodedFrame = std::array<Byte, blockLength>{};
-auto frame = tm::TransferFrame(std::span(encodedFrame).first<tm::transferFrameLength>());
+auto frameBuffer = std::array<Byte, tm::transferFrameLength>{};
+auto frame = tm::TransferFrame(std::span(frameBuffer));
 
 auto missingFileData =
     etl::vector<SegmentRequest, maxNNaksPerSequence * NakPdu::maxNSegmentRequests>{};
+// The data field of the last taken PDU points into this block, so we keep it until we take the next
+// one
+rf::ReceivedTcBlock * blockOfTakenPdu = nullptr;
 
 
 auto SendFile(FileTransferMetadata const & fileTransferMetadata) -> void;
@@ -124,11 +129,12 @@ auto AbandonTransfer() -> void;
 
 template<typename Pdu>
     requires std::is_same_v<Pdu, FileDataPdu> or requires { Pdu::directiveCode; }
-auto PackageAndEncode(Pdu const & pdu, EntityId sourceEntityId) -> void;
-auto PackageAndEncode(Payload const & pdu, PduType pduType, EntityId sourceEntityId) -> void;
+auto Package(Pdu const & pdu, EntityId sourceEntityId) -> void;
+auto Package(Payload const & pdu, PduType pduType, EntityId sourceEntityId) -> void;
 auto SuspendUntilFrameCanBePublished(CancelCondition cancelCondition,
                                      InterruptCondition interruptCondition) -> Result<void>;
 auto SuspendUntilFileTransferWindowIsOpen() -> void;
+auto TakeReceivedPdu() -> Result<tc::ProtocolDataUnit>;
 auto GetReceivedFileDirectivePdu() -> Result<FileDirectivePdu>;
 auto Check(FileDirectivePdu const & fileDirectivePdu,
            CancelCondition cancelCondition,
@@ -335,10 +341,16 @@ auto Send(Payload const & pdu,
           CancelCondition cancelCondition,
           InterruptCondition interruptCondition) -> Result<void>
 {
-    PackageAndEncode(pdu, pduType, sourceEntityId);
+    Package(pdu, pduType, sourceEntityId);
     OUTCOME_TRY(SuspendUntilFrameCanBePublished(cancelCondition, interruptCondition));
-    encodedCfdpFrameMailbox.Overwrite(encodedFrame);
-    ResumeRfCommunicationThread();
+    // The file transfer thread is the only producer, so the queue is still not full
+    (void)cfdpFrameQueue.Put(frameBuffer);
+    // File data is sent in bursts, so the RF communication thread only needs to start sending once
+    // the queue is full. Send(File) takes care of the last, incomplete burst.
+    if(pduType != fileDataPduType or cfdpFrameQueue.IsFull())
+    {
+        ResumeRfCommunicationThread();
+    }
     return outcome_v2::success();
 }
 
@@ -377,6 +389,7 @@ auto Send(fs::File const & file,
             i += fileData.size();
         }
     }
+    ResumeRfCommunicationThread();
     return outcome_v2::success();
 }
 
@@ -459,11 +472,28 @@ auto Acknowledge(DirectiveCode directiveCode, ConditionCode conditionCode) -> vo
 {
     auto sourceEndityId =
         directiveCode == DirectiveCode::finished ? cubeSatEntityId : groundStationEntityId;
-    PackageAndEncode(AckPdu(directiveCode, conditionCode, activeTransactionStatus), sourceEndityId);
-    (void)encodedCfdpFrameMailbox.Get();  // Empty the mailbox
+    Package(AckPdu(directiveCode, conditionCode, activeTransactionStatus), sourceEndityId);
     SuspendUntilFileTransferWindowIsOpen();
+    // A Finished PDU or a canceling EOF PDU ends the transaction, so the queued frames are stale
+    if(directiveCode == DirectiveCode::finished or conditionCode != noErrorConditionCode)
+    {
+        cfdpFrameQueue.Clear();
+    }
     DEBUG_PRINT("Sending ACK PDU\n");
-    encodedCfdpFrameMailbox.Overwrite(encodedFrame);
+    // The ACK does not depend on the queued frames, so it jumps ahead of them. If there is no room
+    // until the peer retransmits the acknowledged PDU anyway, we drop it and acknowledge the
+    // retransmission instead.
+    auto deadline = CurrentRodosTime() + positiveAckTimerInterval;
+    while(cfdpFrameQueue.PutFront(frameBuffer).has_error())
+    {
+        if(CurrentRodosTime() >= deadline)
+        {
+            DEBUG_PRINT("Dropping ACK PDU because the CFDP frame queue is full\n");
+            return;
+        }
+        ResumeRfCommunicationThread();
+        (void)cfdpFrameQueue.SuspendUntilNotFullOr(deadline);
+    }
     ResumeRfCommunicationThread();  // Immediately send the PDU
 }
 
@@ -554,7 +584,9 @@ auto SendMissingDataUntilFinished(fs::File const & file, std::uint32_t fileSize)
 auto SendMissingFileData(fs::File const & file, std::uint32_t fileSize) -> Result<void>
 {
     DEBUG_PRINT("Sending %d missing file data\n", static_cast<int>(missingFileData.size()));
-    (void)encodedCfdpFrameMailbox.Get();  // Empty the mailbox to immediately send the new data
+    // The NAKs list everything the receiver is still missing, so the file data that is still queued
+    // from the previous pass is stale
+    cfdpFrameQueue.Clear();
     auto sendResult = Send(file, fileSize, missingFileData, InterruptCondition::receivedNakPdu);
     missingFileData.clear();
     if(sendResult.has_error() and sendResult.error() != ErrorCode::fileTransferInterrupted)
@@ -585,7 +617,7 @@ auto ReceiveInitialFileData(fs::File * file, fw::Partition const & partition)
         // that parse correctly and are expected
         inactivityTimer = FileTransferTimer(transactionInactivityLimit,
                                             persistentVariables.Load<"fileTransferWindowEnd">());
-        auto receivedPdu = receivedPduMailbox.Get().value();
+        auto receivedPdu = TakeReceivedPdu().value();
         // Handle File Data PDU
         if(receivedPdu.header.pduType == fileDataPduType)
         {
@@ -687,7 +719,7 @@ auto ReceiveMissingFileData(fs::File * file, fw::Partition const & partition) ->
                 persistentVariables.Load<"fileTransferWindowEnd">());
             continue;
         }
-        auto receivedPdu = receivedPduMailbox.Get().value();
+        auto receivedPdu = TakeReceivedPdu().value();
         // Handle File Data PDU
         if(receivedPdu.header.pduType == fileDataPduType)
         {
@@ -824,6 +856,7 @@ auto CancelTransfer(auto const & pdu) -> void
 {
     DEBUG_PRINT("  -> canceling transfer\n");
     fileTransferStatus.Store(FileTransferStatus::canceled);
+    cfdpFrameQueue.Clear();
     auto sendAndWaitResult = SendAndWaitForAck(pdu);
     if(sendAndWaitResult.has_error())
     {
@@ -837,45 +870,46 @@ auto AbandonTransfer() -> void
 {
     DEBUG_PRINT("  -> abandoning transfer\n");
     fileTransferStatus.Store(FileTransferStatus::abandoned);
+    cfdpFrameQueue.Clear();
 }
 
 
 template<typename Pdu>
     requires std::is_same_v<Pdu, FileDataPdu> or requires { Pdu::directiveCode; }
-auto PackageAndEncode(Pdu const & pdu, EntityId sourceEntityId) -> void
+auto Package(Pdu const & pdu, EntityId sourceEntityId) -> void
 {
     if constexpr(std::is_same_v<Pdu, FileDataPdu>)
     {
-        PackageAndEncode(pdu, fileDataPduType, sourceEntityId);
+        Package(pdu, fileDataPduType, sourceEntityId);
     }
     else
     {
-        PackageAndEncode(pdu, fileDirectivePduType, sourceEntityId);
+        Package(pdu, fileDirectivePduType, sourceEntityId);
     }
 }
 
 
-auto PackageAndEncode(Payload const & pdu, PduType pduType, EntityId sourceEntityId) -> void
+auto Package(Payload const & pdu, PduType pduType, EntityId sourceEntityId) -> void
 {
     frame.StartNew(cfdpVcid);
     // We know that we only get PDUs here and that they have a valid size so AddPduTo() never fails
     (void)AddPduTo(
         &frame.GetDataField(), pduType, sourceEntityId, transactionSequenceNumber.Load(), pdu);
     frame.Finish();
-    tm::Encode(encodedFrame);
 }
 
 
 auto SuspendUntilFrameCanBePublished(CancelCondition cancelCondition,
                                      InterruptCondition interruptCondition) -> Result<void>
 {
-    // TODO: We do not check the received PDUs if the encodedCfdpFrameMailbox is not full
-    // FIXME: We do not check the received PDUs if the encodedCfdpFrameMailbox is not full
-    while(encodedCfdpFrameMailbox.IsFull())
+    // TODO: We do not check the received PDUs if the cfdpFrameQueue is not full
+    // FIXME: We do not check the received PDUs if the cfdpFrameQueue is not full
+    while(cfdpFrameQueue.IsFull())
     {
         // TODO: Think about the correct reactivation time for all suspend functions
         // FIXME: Think about the correct reactivation time for all suspend functions
-        (void)encodedCfdpFrameMailbox.SuspendUntilEmptyOr(endOfTime);
+        // Receiving a PDU does not resume us, so we must not wait for room forever
+        (void)cfdpFrameQueue.SuspendUntilNotFullOr(CurrentRodosTime() + frameQueuePollingInterval);
         auto getFileDirectivePduResult = GetReceivedFileDirectivePdu();
         if(getFileDirectivePduResult.has_error())
         {
@@ -898,9 +932,20 @@ auto SuspendUntilFileTransferWindowIsOpen() -> void
 }
 
 
-auto GetReceivedFileDirectivePdu() -> Result<FileDirectivePdu>
+// Release the block of the previously taken PDU and take the next one from the mailbox
+auto TakeReceivedPdu() -> Result<tc::ProtocolDataUnit>
 {
+    tcBlockPool.Release(blockOfTakenPdu);
+    blockOfTakenPdu = nullptr;
     OUTCOME_TRY(auto receivedPdu, receivedPduMailbox.Get());
+    blockOfTakenPdu = receivedPdu.block;
+    return receivedPdu.pdu;
+}
+
+
+auto GetReceivedFileDirectivePdu() -> Result<FileDirectivePdu>
+{
+    OUTCOME_TRY(auto receivedPdu, TakeReceivedPdu());
     if(receivedPdu.header.pduType != fileDirectivePduType)
     {
         return ErrorCode::wrongPduType;
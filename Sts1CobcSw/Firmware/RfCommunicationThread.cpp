@@ -10,6 +10,7 @@
 #include <Sts1CobcSw/FileSystem/FileSystem.hpp>
 #include <Sts1CobcSw/Firmware/EduProgramQueueThread.hpp>
 #include <Sts1CobcSw/Firmware/FileTransferThread.hpp>
+#include <Sts1CobcSw/Firmware/RfDriverThread.hpp>
 #include <Sts1CobcSw/Firmware/StartupAndSpiSupervisorThread.hpp>
 #include <Sts1CobcSw/Firmware/ThreadPriorities.hpp>
 #include <Sts1CobcSw/Firmware/TopicsAndSubscribers.hpp>
@@ -22,7 +23,10 @@
 #include <Sts1CobcSw/Mailbox/Mailbox.hpp>
 #include <Sts1CobcSw/Outcome/Outcome.hpp>
 #include <Sts1CobcSw/RealTime/RealTime.hpp>
+#include <Sts1CobcSw/Rf/AirtimeScheduler.hpp>
+#include <Sts1CobcSw/Rf/DataRateController.hpp>
 #include <Sts1CobcSw/Rf/Rf.hpp>
+#include <Sts1CobcSw/Rf/TcBlockPool.hpp>
 #include <Sts1CobcSw/RfProtocols/Configuration.hpp>
 #include <Sts1CobcSw/RfProtocols/Id.hpp>
 #include <Sts1CobcSw/RfProtocols/Payload.hpp>
@@ -40,9 +44,11 @@
 #include <Sts1CobcSw/Serial/UInt.hpp>
 #include <Sts1CobcSw/Telemetry/TelemetryMemory.hpp>
 #include <Sts1CobcSw/Telemetry/TelemetryRecord.hpp>
+#include <Sts1CobcSw/TmTransmission/TmTransmission.hpp>
 #include <Sts1CobcSw/Utility/DebugPrint.hpp>
 #include <Sts1CobcSw/Vocabulary/FileTransfer.hpp>
 #include <Sts1CobcSw/Vocabulary/Ids.hpp>  // IWYU pragma: keep
+#include <Sts1CobcSw/Vocabulary/LinkStatistics.hpp>
 #include <Sts1CobcSw/Vocabulary/MessageTypeIdFields.hpp>
 #include <Sts1CobcSw/Vocabulary/Time.hpp>
 #include <Sts1CobcSw/WatchdogTimers/WatchdogTimers.hpp>
@@ -64,8 +70,10 @@
 #include <cinttypes>  // IWYU pragma: keep
 #include <climits>
 #include <compare>
+#include <cstddef>
 #include <cstdint>
 #include <iterator>
+#include <limits>
 #include <span>
 #include <type_traits>
 #include <utility>
@@ -76,31 +84,74 @@ namespace sts1cobcsw
 namespace
 {
 // FIXME: const value correct in whole file?
-constexpr auto stackSize = 6000;
-constexpr auto rxTimeoutAfterTelemetryRecord = 5 * s;
-constexpr auto rxTimeoutForAdditionalData = 3 * s;
-constexpr auto minRxTimeout = 1 * s;
+constexpr auto stackSize = 5600;
 constexpr auto estimatedMaxDataProcessingDuration = 100 * ms;
+// Reading several telemetry records at once saves FRAM round trips, but every record costs RAM
+constexpr auto nTelemetryRecordsPerRead = 4U;
+// Max. time to wait for the file transfer thread to take the previous PDU when a burst contains
+// more than one CFDP frame
+constexpr auto pduHandoverTimeout = 100 * ms;
+// If a burst fills the whole queue, the ground station is probably still sending. We then keep
+// receiving in the background while handling the received blocks, for at most this long.
+constexpr auto burstContinuationRxTimeout = 1 * s;
+// A cancellation that arrives right before the background reception starts has no effect, so it is
+// repeated at this interval
+constexpr auto rxCancelRetryInterval = 10 * ms;
 // The ground station needs some time to switch from TX to RX so we need to wait for that when
 // switching from RX to TX
 constexpr auto rxToTxSwitchDuration = 300 * ms;
-constexpr auto maxNFramesToSendContinously = rf::maxTxDataLength / fullyEncodedFrameLength;
-
-auto tcBuffer = std::array<Byte, blockLength>{};
-auto tmBuffer = std::array<Byte, channelAccessDataUnitLength>{};
-auto tmBlock = std::span(tmBuffer).subspan<attachedSynchMarkerLength, blockLength>();
-auto tmFrame = tm::TransferFrame(tmBlock.first<tm::transferFrameLength>());
+static_assert(rf::maxTxDataLength / tm::maxFullyEncodedFrameLength >= 1);
+// Two full queues plus the block that the file transfer thread holds and the one that waits in
+// receivedPduMailbox must fit into the pool
+static_assert(rf::nTcBlockBuffers >= 2 * rf::maxNBlocksPerBurst + 2);
+// The MAC that is computed while a block is received must cover exactly what the parser checks
+static_assert(rf::nAuthenticatedTcBytes
+              == tc::transferFrameLength - tc::securityTrailerLength);
+
+// One queue is handled while the next one is filled in the background
+auto receivedTcBlocks = std::array<rf::ReceivedTcBlocks, 2>{};
+auto backgroundRxIsRunning = false;
 auto lastRxTime = RodosTime(0);
-std::uint16_t nFramesToSend = 0U;
-std::uint16_t nSentFrames = 0U;
+// The time when we last received something from the ground station. After a reset, we have not
+// received anything in the current pass.
+auto lastUplinkTime = RodosTime(0) - rf::maxPassDuration;
+// The housekeeping dumps read the telemetry records and build the compressed reports here instead
+// of on the stack of the RF communication thread, which would otherwise need to be sized for them
+auto telemetryRecords = std::array<TelemetryRecord, nTelemetryRecordsPerRead>{};
+auto compressedReport = CompressedHousekeepingParameterReport{};
+
+
+// Persistent uplink counters at the last evaluation of the adaptive TX data rate
+struct UplinkCounters
+{
+    std::uint16_t nGoodFrames = 0;
+    std::uint16_t nBadFrames = 0;
+    std::uint16_t nCorrectedErrors = 0;
+};
+
+
+auto uplinkCountersAtLastEvaluation = UplinkCounters{};
 
 
 auto SuspendUntilNewTelemetryRecordIsAvailable() -> void;
+[[nodiscard]] auto CurrentLinkState(bool uplinkIsActive) -> rf::LinkState;
 auto EstimateDataHandlingDuration() -> Duration;
 auto ReceiveAndHandleData(Duration rxTimeout) -> Result<void>;
-auto SendCfdpFrames() -> void;
-auto HandleReceivedData() -> void;
-auto HandleCfdpFrame(tc::TransferFrame const & frame) -> void;
+// Must be called before the RF module is used directly, e.g., to send something
+auto StopBackgroundRx() -> void;
+auto CancelAndCollectRfOperation() -> void;
+auto FinishBackgroundRx() -> void;
+auto RestoreTxDataRate() -> void;
+auto RestoreTxCodingProfile() -> void;
+[[nodiscard]] auto LoadUplinkCounters() -> UplinkCounters;
+[[nodiscard]] auto EvaluateUplinkQuality() -> rf::UplinkQuality;
+auto AdaptTxDataRate(rf::UplinkQuality const & quality) -> void;
+auto ChangeTxDataRate(std::uint32_t dataRate) -> void;
+auto HandleReceivedData(rf::ReceivedTcBlock * block) -> void;
+auto GetErasurePositions(rf::ReceivedTcBlock const & block)
+    -> etl::vector<std::uint8_t, rs::maxNErasures>;
+[[nodiscard]] auto HandleCfdpFrame(tc::TransferFrame const & frame, rf::ReceivedTcBlock * block)
+    -> bool;
 auto PduHeaderMatchesTransferInfo(ProtocolDataUnitHeader const & pduHeader,
                                   std::uint16_t transactionSequenceNumber,
                                   FileTransferStatus fileTransferStatus) -> bool;
@@ -129,12 +180,16 @@ auto VerifyAndHandle(PerformAFunctionRequest const & request, RequestId const &
 // As above, not all functions need the requestId, but it's easier if we pass it to all handlers
 auto Handle(ReportHousekeepingParameterReportFunction const & function, RequestId const & requestId)
     -> void;
+auto Handle(ReportCompressedHousekeepingParameterReportFunction const & function,
+            RequestId const & requestId) -> void;
 auto Handle(EnableFileTransferFunction const & function, RequestId const & requestId) -> void;
 auto Handle(SynchronizeTimeFunction const & function, RequestId const & requestId) -> void;
 auto Handle(UpdateEduQueueFunction const & function, RequestId const & requestId) -> void;
 auto Handle(SetActiveFirmwareFunction const & function, RequestId const & requestId) -> void;
 auto Handle(SetBackupFirmwareFunction const & function, RequestId const & requestId) -> void;
 auto Handle(CheckFirmwareIntegrityFunction const & function, RequestId const & requestId) -> void;
+template<typename Send>
+auto CompressTelemetryRecords(std::uint16_t iBegin, std::uint16_t iEnd, Send const & send) -> void;
 
 [[nodiscard]] auto ToRequestId(SpacePacketPrimaryHeader const & header) -> RequestId;
 [[nodiscard]] auto GetValue(Parameter::Id parameterId) -> Parameter::Value;
@@ -143,17 +198,7 @@ auto Set(Parameter parameter) -> void;
     -> Result<FileTransferMetadata>;
 [[nodiscard]] auto GetPartitionId(fs::Path const & filePath) -> Result<PartitionId>;
 
-// Must be called before SendAndContinue()
-auto SetTxDataLength(std::uint16_t nFrames) -> void;
-auto SendAndWait(Payload const & report) -> void;
-auto SendAndContinue(Payload const & report) -> void;
-auto PackageAndEncode(Payload const & report) -> void;
-auto SendAndWait(std::span<Byte const, channelAccessDataUnitLength> channelAccessDataUnit) -> void;
-auto SendAndContinue(std::span<Byte const, channelAccessDataUnitLength> channelAccessDataUnit)
-    -> void;
 auto SuspendUntilEarliestTxTime() -> void;
-// Must be called after SendAndContinue()
-auto FinalizeTransmission() -> void;
 
 
 class RfCommunicationThread : public RODOS::StaticThread<stackSize>
@@ -164,54 +209,41 @@ public:
 
 
 private:
-    auto init() -> void override
-    {
-        if constexpr(attachedSynchMarkerLength == attachedSynchMarker.size())
-        {
-            std::ranges::copy(attachedSynchMarker, tmBuffer.begin());
-        }
-    }
-
-
     auto run() -> void override
     {
         SuspendFor(totalStartupTestTimeout);  // Wait for the startup tests to complete
         DEBUG_PRINT("Starting RF communication thread\n");
-        auto moreDataShouldBeReceived = false;
+        RestoreTxDataRate();
+        RestoreTxCodingProfile();
+        uplinkCountersAtLastEvaluation = LoadUplinkCounters();
+        auto scheduler = rf::AirtimeScheduler{};
+        auto uplinkIsActive = false;
         while(true)
         {
-            if(telemetryRecordMailbox.IsFull())
+            auto slot = scheduler.Schedule(CurrentLinkState(uplinkIsActive));
+            schedulerStatisticsTopic.publish(scheduler.Statistics());
+            switch(slot.activity)
             {
-                DEBUG_PRINT("Sending housekeeping parameter report\n");
-                SendAndWait(HousekeepingParameterReport(telemetryRecordMailbox.Get().value()));
-                DEBUG_PRINT("Receiving for %" PRIi64 " s\n", rxTimeoutAfterTelemetryRecord / s);
-                auto receiveResult = ReceiveAndHandleData(rxTimeoutAfterTelemetryRecord);
-                DEBUG_PRINT("\n");
-                moreDataShouldBeReceived = receiveResult.has_value();
-                DEBUG_PRINT_STACK_USAGE();
-                continue;
-            }
-            if(encodedCfdpFrameMailbox.IsFull())
-            {
-                SendCfdpFrames();
-                SuspendUntilNewTelemetryRecordIsAvailable();
-                continue;
-            }
-            if(moreDataShouldBeReceived)
-            {
-                auto remainingRxDuration = nextTelemetryRecordTimeMailbox.Peek().value()
-                                         - CurrentRodosTime() - EstimateDataHandlingDuration();
-                if(remainingRxDuration > minRxTimeout)
-                {
-                    auto rxTimeout = std::min(remainingRxDuration, rxTimeoutForAdditionalData);
-                    DEBUG_PRINT("Receiving for %" PRIi64 " s\n", rxTimeout / s);
-                    auto receiveResult = ReceiveAndHandleData(rxTimeout);
+                case rf::Activity::sendHousekeeping:
+                    DEBUG_PRINT("Sending housekeeping parameter report\n");
+                    SendAndWait(HousekeepingParameterReport(telemetryRecordMailbox.Get().value()));
+                    DEBUG_PRINT_STACK_USAGE();
+                    break;
+                case rf::Activity::receive:
+                    DEBUG_PRINT("Receiving for %" PRIi64 " ms\n", slot.duration / ms);
+                    uplinkIsActive = ReceiveAndHandleData(slot.duration).has_value();
                     DEBUG_PRINT("\n");
-                    moreDataShouldBeReceived = receiveResult.has_value();
-                    continue;
-                }
+                    break;
+                case rf::Activity::sendCfdpFrames:
+                    SendCfdpFrames(&cfdpFrameQueue,
+                                   &telemetryRecordMailbox,
+                                   CurrentRodosTime() + slot.duration);
+                    ResumeFileTransferThread();
+                    break;
+                case rf::Activity::idle:
+                    SuspendUntilNewTelemetryRecordIsAvailable();
+                    break;
             }
-            SuspendUntilNewTelemetryRecordIsAvailable();
         }
     }
 } rfCommunicationThread;
@@ -224,6 +256,13 @@ auto ResumeRfCommunicationThread() -> void
 }
 
 
+auto PrepareForTx() -> void
+{
+    StopBackgroundRx();
+    SuspendUntilEarliestTxTime();
+}
+
+
 namespace
 {
 auto SuspendUntilNewTelemetryRecordIsAvailable() -> void
@@ -232,75 +271,226 @@ auto SuspendUntilNewTelemetryRecordIsAvailable() -> void
 }
 
 
+auto CurrentLinkState(bool uplinkIsActive) -> rf::LinkState
+{
+    auto now = CurrentRodosTime();
+    // The telemetry thread has a higher priority and writes the time of the next record before we
+    // start, so the mailbox is never empty in practice
+    auto peekResult = nextTelemetryRecordTimeMailbox.Peek();
+    auto nextTelemetryRecordTime = peekResult.has_value() ? peekResult.value() : now;
+    return rf::LinkState{
+        .housekeepingIsPending = telemetryRecordMailbox.IsFull(),
+        .remainingIntervalDuration = nextTelemetryRecordTime - now,
+        .remainingFileTransferWindowDuration =
+            persistentVariables.Load<"fileTransferWindowEnd">() - now,
+        .frameSendDuration = FrameSendDuration(),
+        .dataHandlingDuration = EstimateDataHandlingDuration(),
+        .nQueuedCfdpFrames = cfdpFrameQueue.Size(),
+        .uplinkIsActive = uplinkIsActive,
+        .timeSinceLastUplink = now - lastUplinkTime,
+    };
+}
+
+
 auto EstimateDataHandlingDuration() -> Duration
 {
     // Worst case is that we receive a request and need to send two reports in response
-    auto frameSendDuration = fullyEncodedFrameLength * CHAR_BIT * s / rf::GetTxDataRate();
-    return 2 * frameSendDuration + estimatedMaxDataProcessingDuration;
+    return 2 * FrameSendDuration() + estimatedMaxDataProcessingDuration;
 }
 
 
 auto ReceiveAndHandleData(Duration rxTimeout) -> Result<void>
 {
-    auto nReceivedBytes = rf::Receive(tcBuffer, rxTimeout);
+    // All blocks of a burst are received back to back in a single RX window and handled afterwards
+    auto * blocks = &receivedTcBlocks[0];
+    auto * nextBlocks = &receivedTcBlocks[1];
+    blocks->clear();
+    auto startResult = StartRfReceive(blocks, rxTimeout);
+    if(startResult.has_error())
+    {
+        // This only happens if the previous operation was not collected. We end it and try again.
+        DEBUG_PRINT("Failed to start RF reception: %s\n", ToCZString(startResult.error()));
+        CancelAndCollectRfOperation();
+        startResult = StartRfReceive(blocks, rxTimeout);
+    }
+    if(startResult.has_error())
+    {
+        DEBUG_PRINT("Failed to start RF reception again: %s\n", ToCZString(startResult.error()));
+        lastRxTime = CurrentRodosTime();
+        return startResult.error();
+    }
+    auto nReceivedBlocks = SuspendUntilRfOperationIsCompleteOr(endOfTime).value();
     lastRxTime = CurrentRodosTime();
-    if(nReceivedBytes < tcBuffer.size())
+    if(nReceivedBlocks == 0)
     {
         return ErrorCode::timeout;
     }
-    HandleReceivedData();
+    lastUplinkTime = lastRxTime;
+    while(not blocks->empty())
+    {
+        nextBlocks->clear();
+        if(blocks->full())
+        {
+            backgroundRxIsRunning =
+                StartRfReceive(nextBlocks, burstContinuationRxTimeout).has_value();
+        }
+        for(auto * block : *blocks)
+        {
+            HandleReceivedData(block);
+        }
+        // The rest of the burst is received until the ground station stops sending, unless sending
+        // a report in between already stopped the background reception
+        FinishBackgroundRx();
+        std::swap(blocks, nextBlocks);
+    }
+    AdaptTxDataRate(EvaluateUplinkQuality());
+    // If we handed over a PDU, give the file transfer thread time to process it
+    if(receivedPduMailbox.IsFull())
+    {
+        SuspendUntilNewTelemetryRecordIsAvailable();
+    }
     return outcome_v2::success();
 }
 
 
-auto SendCfdpFrames() -> void
+auto StopBackgroundRx() -> void
 {
-    static constexpr auto sendWindowMargin = 1 * s;
-    // We know that the nextTelemetryRecordTimeMailbox is never empty here, because the telemetry
-    // thread has a higher priority and will always write to it before we read it.
-    auto sendWindowEnd = std::min(nextTelemetryRecordTimeMailbox.Peek().value(),
-                                  persistentVariables.Load<"fileTransferWindowEnd">())
-                       - sendWindowMargin;
-    auto frameSendDuration = fullyEncodedFrameLength * CHAR_BIT * s / rf::GetTxDataRate();
-    auto nFrames =
-        static_cast<std::uint16_t>((CurrentRodosTime() - sendWindowEnd) / frameSendDuration);
-    if(nFrames > 0)
-    {
-        SetTxDataLength(nFrames);
-    }
-    while(encodedCfdpFrameMailbox.IsFull()
-          and CurrentRodosTime() + frameSendDuration < sendWindowEnd)
-    {
-        // This wakes up the file transfer thread if it is waiting to send a new CFDP frame
-        std::ranges::copy(encodedCfdpFrameMailbox.Get().value(), tmBlock.begin());
-        // Write the attached sync marker to the beginning of the buffer every time because the
-        // constant is stored in flash and therefore not corrupted as fast as the buffer in RAM.
-        if constexpr(attachedSynchMarkerLength == attachedSynchMarker.size())
-        {
-            std::ranges::copy(attachedSynchMarker, tmBuffer.begin());
-        }
-        SendAndContinue(tmBuffer);
-        // In case radiation affects the while condition, we add this additional check to break once
-        // a new telemetry record is available
-        if(telemetryRecordMailbox.IsFull())
-        {
-            return;
-        }
+    if(not backgroundRxIsRunning)
+    {
+        return;
     }
-    // TODO: It looks like we are missing a FinalizeTransmission() are something here. Having just a
-    // SendAndContinue() seems wrong.
-    // FIXME: see text above
-    ResumeFileTransferThread();
+    CancelAndCollectRfOperation();
+    backgroundRxIsRunning = false;
+    lastRxTime = CurrentRodosTime();
+}
+
+
+// If the operation is already complete, canceling it has no effect
+auto CancelAndCollectRfOperation() -> void
+{
+    CancelRfOperation();
+    while(SuspendUntilRfOperationIsCompleteOr(CurrentRodosTime() + rxCancelRetryInterval)
+              .has_error())
+    {
+        CancelRfOperation();
+    }
+}
+
+
+auto FinishBackgroundRx() -> void
+{
+    if(not backgroundRxIsRunning)
+    {
+        return;
+    }
+    (void)SuspendUntilRfOperationIsCompleteOr(endOfTime);
+    backgroundRxIsRunning = false;
+    lastRxTime = CurrentRodosTime();
+}
+
+
+auto RestoreTxDataRate() -> void
+{
+    // If the TX data rate is not adaptive, the default data rate after a reset serves as a fallback
+    if(not rf::DataRateIsAdaptive(persistentVariables.Load<"minTxDataRate">(),
+                                  persistentVariables.Load<"maxTxDataRate">()))
+    {
+        return;
+    }
+    ChangeTxDataRate(persistentVariables.Load<"txDataRate">());
+    // Without any uplink data, this only clamps the data rate in case the bounds changed
+    AdaptTxDataRate(rf::UplinkQuality{});
 }
 
 
-auto HandleReceivedData() -> void
+// Invalid profiles are ignored, e.g., if the FRAM is broken. The default profile then stays active.
+auto RestoreTxCodingProfile() -> void
+{
+    if(not persistentVariables.Load<"txCodingProfileIsSet">())
+    {
+        return;
+    }
+    auto profile = static_cast<CodingProfile>(persistentVariables.Load<"txCodingProfile">());
+    if(IsValid(profile))
+    {
+        rf::SetTxCodingProfile(profile);
+    }
+}
+
+
+auto LoadUplinkCounters() -> UplinkCounters
+{
+    return UplinkCounters{
+        .nGoodFrames = persistentVariables.Load<"nGoodTransferFrames">(),
+        .nBadFrames = persistentVariables.Load<"nBadTransferFrames">(),
+        .nCorrectedErrors = persistentVariables.Load<"nCorrectableUplinkErrors">()};
+}
+
+
+// Return the uplink quality since the last evaluation. The RSSI is taken from the link statistics
+// of the current pass.
+auto EvaluateUplinkQuality() -> rf::UplinkQuality
+{
+    auto counters = LoadUplinkCounters();
+    auto const & last = uplinkCountersAtLastEvaluation;
+    auto linkStatistics = rf::GetLinkStatistics();
+    // The counters might wrap around, which unsigned arithmetic handles correctly
+    auto quality = rf::UplinkQuality{
+        .nGoodFrames = static_cast<std::uint16_t>(counters.nGoodFrames - last.nGoodFrames),
+        .nBadFrames = static_cast<std::uint16_t>(counters.nBadFrames - last.nBadFrames),
+        .nCorrectedErrors =
+            static_cast<std::uint16_t>(counters.nCorrectedErrors - last.nCorrectedErrors),
+        .nRssiSamples = linkStatistics.nSamples,
+        .meanRssi = linkStatistics.meanRssi};
+    uplinkCountersAtLastEvaluation = counters;
+    return quality;
+}
+
+
+auto AdaptTxDataRate(rf::UplinkQuality const & quality) -> void
+{
+    auto state = rf::DataRateControllerState{
+        .dataRate = rf::GetTxDataRate(),
+        .nGoodEvaluations = persistentVariables.Load<"nGoodTxDataRateEvaluations">()};
+    auto decision = rf::AdaptDataRate(&state,
+                                      quality,
+                                      persistentVariables.Load<"minTxDataRate">(),
+                                      persistentVariables.Load<"maxTxDataRate">());
+    persistentVariables.Store<"nGoodTxDataRateEvaluations">(state.nGoodEvaluations);
+    if(decision == rf::DataRateDecision::keep)
+    {
+        return;
+    }
+    DEBUG_PRINT("Changing TX data rate from %" PRIu32 " to %" PRIu32 " baud\n",
+                rf::GetTxDataRate(),
+                state.dataRate);
+    ChangeTxDataRate(state.dataRate);
+    txDataRateDecisionTopic.publish(decision);
+}
+
+
+auto ChangeTxDataRate(std::uint32_t dataRate) -> void
+{
+    rf::SetTxDataRate(dataRate);
+    persistentVariables.Store<"txDataRate">(rf::GetTxDataRate());
+    txDataRateTopic.publish(rf::GetTxDataRate());
+}
+
+
+// Take ownership of the block and release it to the pool unless a PDU in it was handed over to the
+// file transfer thread
+auto HandleReceivedData(rf::ReceivedTcBlock * block) -> void
 {
     rdt::Feed();
     persistentVariables.Store<"nResetsSinceRf">(0);
+    auto blockIsHandedOver = false;
     auto result = [&]() -> Result<void>
     {
-        auto decodeResult = tc::Decode(tcBuffer);
+        auto erasurePositions = GetErasurePositions(*block);
+        // Blocks that were decoded while they were received only need the error correction
+        auto blockIsDecoded = block->decoder.IsComplete();
+        auto decodeResult = blockIsDecoded ? block->decoder.Finish(block->data, erasurePositions)
+                                           : tc::Decode(block->data, erasurePositions);
         if(decodeResult.has_error())
         {
             persistentVariables.Increment<"nUncorrectableUplinkErrors">();
@@ -308,14 +498,18 @@ auto HandleReceivedData() -> void
         }
         persistentVariables.Add<"nCorrectableUplinkErrors">(
             static_cast<std::uint16_t>(decodeResult.value()));
+        auto frameBytes = std::span(block->data).first<tc::transferFrameLength>();
+        // The MAC computed during reception is only valid if no byte had to be corrected
         OUTCOME_TRY(auto tcFrame,
-                    tc::ParseAsTransferFrame(std::span(tcBuffer).first<tc::transferFrameLength>()));
+                    blockIsDecoded and decodeResult.value() == 0
+                        ? tc::ParseAsTransferFrame(frameBytes, block->messageAuthenticationCode)
+                        : tc::ParseAsTransferFrame(frameBytes));
         persistentVariables.Increment<"nGoodTransferFrames">();
         persistentVariables.Store<"lastFrameSequenceNumber">(
             tcFrame.primaryHeader.frameSequenceNumber);
         if(tcFrame.primaryHeader.vcid == cfdpVcid)
         {
-            HandleCfdpFrame(tcFrame);
+            blockIsHandedOver = HandleCfdpFrame(tcFrame, block);
         }
         else
         {
@@ -328,10 +522,38 @@ auto HandleReceivedData() -> void
         DEBUG_PRINT("Error in HandleReceivedData(): %s\n", ToCZString(result.error()));
         persistentVariables.Increment<"nBadTransferFrames">();
     }
+    if(not blockIsHandedOver)
+    {
+        tcBlockPool.Release(block);
+    }
+}
+
+
+// Return the positions of the bytes in the TC block that the receiver flagged as suspect. If there
+// are more than the Reed-Solomon decoder can handle, the rest is ignored.
+auto GetErasurePositions(rf::ReceivedTcBlock const & block)
+    -> etl::vector<std::uint8_t, rs::maxNErasures>
+{
+    auto erasurePositions = etl::vector<std::uint8_t, rs::maxNErasures>{};
+    for(auto const & range : block.suspectByteRanges)
+    {
+        auto end = std::min<std::size_t>(range.end, block.data.size());
+        for(auto position = std::size_t{range.begin}; position < end; ++position)
+        {
+            if(erasurePositions.full())
+            {
+                return erasurePositions;
+            }
+            erasurePositions.push_back(static_cast<std::uint8_t>(position));
+        }
+    }
+    return erasurePositions;
 }
 
 
-auto HandleCfdpFrame(tc::TransferFrame const & frame) -> void
+// Return true if the PDU and with it the block it lives in was handed over to the file transfer
+// thread
+auto HandleCfdpFrame(tc::TransferFrame const & frame, rf::ReceivedTcBlock * block) -> bool
 {
     auto transferStatus = fileTransferStatus.Load();
     if(transferStatus != FileTransferStatus::sending
@@ -339,14 +561,14 @@ auto HandleCfdpFrame(tc::TransferFrame const & frame) -> void
        and transferStatus != FileTransferStatus::canceled)
     {
         DEBUG_PRINT("Discarding CFDP frame because no file transfer is ongoing\n");
-        return;
+        return false;
     }
     auto parseAsProtocolDataUnitResult = ParseAsProtocolDataUnit(frame.dataField);
     if(parseAsProtocolDataUnitResult.has_error())
     {
         DEBUG_PRINT("Error parsing as Protocol Data Unit: %s\n",
                     ToCZString(parseAsProtocolDataUnitResult.error()));
-        return;
+        return false;
     }
     auto const & pdu = parseAsProtocolDataUnitResult.value();
     auto sequenceNumber = transactionSequenceNumber.Load();
@@ -359,11 +581,25 @@ auto HandleCfdpFrame(tc::TransferFrame const & frame) -> void
     }
     if(not PduHeaderMatchesTransferInfo(pdu.header, sequenceNumber, transferStatus))
     {
-        return;
+        return false;
+    }
+    // The file transfer thread has a lower priority, so it can only take the previous PDU of the
+    // same burst while we wait here
+    if(receivedPduMailbox.IsFull())
+    {
+        (void)receivedPduMailbox.SuspendUntilEmptyOr(CurrentRodosTime() + pduHandoverTimeout);
+    }
+    // If the previous PDU was still not taken, the new one is dropped instead of overwriting it.
+    // The drop shows up in the telemetry, and CFDP retransmits the missing data anyway.
+    if(receivedPduMailbox.IsFull())
+    {
+        DEBUG_PRINT("Dropping CFDP PDU because the previous one was not taken in time\n");
+        persistentVariables.Increment<"nDroppedPdus">();
+        return false;
     }
     // This wakes up the file transfer thread if it is waiting for a new PDU
-    receivedPduMailbox.Overwrite(pdu);
-    SuspendUntilNewTelemetryRecordIsAvailable();
+    receivedPduMailbox.Overwrite(ReceivedPdu{.pdu = pdu, .block = block});
+    return true;
 }
 
 
@@ -546,6 +782,10 @@ auto Handle(PerformAFunctionRequest const & request, RequestId const & requestId
         case FunctionId::requestHousekeepingParameterReports:
             VerifyAndHandle<ParseAsReportHousekeepingParameterReportFunction>(request, requestId);
             return;
+        case FunctionId::requestCompressedHousekeepingParameterReports:
+            VerifyAndHandle<ParseAsReportCompressedHousekeepingParameterReportFunction>(request,
+                                                                                         requestId);
+            return;
         case FunctionId::disableCubeSatTx:
             rf::DisableTx();
             DEBUG_PRINT("Disabled CubeSat TX\n");
@@ -785,14 +1025,61 @@ auto Handle(ReportHousekeepingParameterReportFunction const & function,
     DEBUG_PRINT(
         "Sending housekeeping parameter reports %" PRIu16 " to %" PRIu16 "\n", iBegin, iEnd - 1U);
     SetTxDataLength(iEnd - iBegin);
-    for(auto i = iBegin; i < iEnd; ++i)
+    for(auto i = iBegin; i < iEnd and not telemetryRecordMailbox.IsFull();)
     {
-        SendAndContinue(HousekeepingParameterReport(telemetryMemory.Get(i)));
-        if(telemetryRecordMailbox.IsFull())
+        auto nRecords =
+            std::min<unsigned>(telemetryMemory.GetRange(i, std::span(telemetryRecords)), iEnd - i);
+        if(nRecords == 0U)
         {
             break;
         }
+        for(auto j = 0U; j < nRecords and not telemetryRecordMailbox.IsFull(); ++j, ++i)
+        {
+            SendAndContinue(HousekeepingParameterReport(telemetryRecords[j]));
+        }
+    }
+    FinalizeTransmission();
+}
+
+
+// The number of compressed reports is not known in advance. To send them in one continuous
+// transmission anyway, the records are compressed twice: once to count the reports and once to send
+// them. Keeping all reports in RAM instead would cost one TM message per report.
+auto Handle(ReportCompressedHousekeepingParameterReportFunction const & function,
+            [[maybe_unused]] RequestId const & requestId) -> void
+{
+    auto nTelemetryRecords = static_cast<std::uint16_t>(telemetryMemory.Size());
+    auto iBegin = std::min<std::uint16_t>(function.firstReportIndex, nTelemetryRecords);
+    auto iEnd = std::min<std::uint16_t>(function.lastReportIndex + 1U, nTelemetryRecords);
+    if(iBegin == iEnd)
+    {
+        DEBUG_PRINT("No housekeeping parameter reports to send\n");
+        return;
     }
+    std::uint16_t nReports = 0;
+    CompressTelemetryRecords(iBegin, iEnd, [&](Payload const & /*report*/) { ++nReports; });
+    if(nReports == 0U)
+    {
+        return;
+    }
+    DEBUG_PRINT("Sending housekeeping parameter reports %" PRIu16 " to %" PRIu16
+                " in %" PRIu16 " compressed reports\n",
+                iBegin,
+                iEnd - 1U,
+                nReports);
+    std::uint16_t nSentReports = 0;
+    SetTxDataLength(nReports);
+    CompressTelemetryRecords(iBegin,
+                             iEnd,
+                             [&](Payload const & report)
+                             {
+                                 // The announced TX data length must not be exceeded
+                                 if(nSentReports < nReports)
+                                 {
+                                     SendAndContinue(report);
+                                     ++nSentReports;
+                                 }
+                             });
     FinalizeTransmission();
 }
 
@@ -868,6 +1155,46 @@ auto Handle(CheckFirmwareIntegrityFunction const & function, RequestId const & r
 }
 
 
+// Calls send() with every report that is needed to dump the telemetry records [iBegin, iEnd)
+template<typename Send>
+auto CompressTelemetryRecords(std::uint16_t iBegin, std::uint16_t iEnd, Send const & send) -> void
+{
+    compressedReport = CompressedHousekeepingParameterReport{};
+    for(auto i = iBegin; i < iEnd and not telemetryRecordMailbox.IsFull();)
+    {
+        auto nRecords =
+            std::min<unsigned>(telemetryMemory.GetRange(i, std::span(telemetryRecords)), iEnd - i);
+        if(nRecords == 0U)
+        {
+            break;
+        }
+        for(auto j = 0U; j < nRecords and not telemetryRecordMailbox.IsFull();)
+        {
+            if(compressedReport.Add(telemetryRecords[j]))
+            {
+                ++j;
+                ++i;
+                continue;
+            }
+            if(compressedReport.NRecords() == 0U)
+            {
+                // The record changed too much to fit into a report even on its own
+                send(HousekeepingParameterReport(telemetryRecords[j]));
+                ++j;
+                ++i;
+                continue;
+            }
+            send(compressedReport);
+            compressedReport = CompressedHousekeepingParameterReport{};
+        }
+    }
+    if(compressedReport.NRecords() > 0U)
+    {
+        send(compressedReport);
+    }
+}
+
+
 auto ToRequestId(SpacePacketPrimaryHeader const & header) -> RequestId
 {
     return RequestId{.packetVersionNumber = header.versionNumber,
@@ -891,6 +1218,32 @@ auto GetValue(Parameter::Id parameterId) -> Parameter::Value
             return static_cast<std::uint32_t>(persistentVariables.Load<"maxEduIdleDuration">() / s);
         case Parameter::Id::newEduResultIsAvailable:
             return persistentVariables.Load<"newEduResultIsAvailable">() ? 1 : 0;
+        case Parameter::Id::txCodingProfile:
+            return static_cast<std::uint32_t>(rf::GetTxCodingProfile());
+        case Parameter::Id::linkRssi:
+        {
+            auto statistics = rf::GetLinkStatistics();
+            return (static_cast<std::uint32_t>(statistics.minRssi) << (2U * CHAR_BIT))
+                 | (static_cast<std::uint32_t>(statistics.meanRssi) << CHAR_BIT)
+                 | statistics.maxRssi;
+        }
+        case Parameter::Id::linkAfcOffset:
+            return static_cast<std::uint32_t>(
+                static_cast<std::int32_t>(rf::GetLinkStatistics().meanAfcOffset));
+        case Parameter::Id::nRfFifoErrors:
+        {
+            auto statistics = rf::GetLinkStatistics();
+            return (static_cast<std::uint32_t>(statistics.nRxFifoOverflows) << (2U * CHAR_BIT))
+                 | statistics.nTxFifoUnderruns;
+        }
+        case Parameter::Id::nReceivedBytes:
+            return rf::GetLinkStatistics().nReceivedBytes;
+        case Parameter::Id::nSentBytes:
+            return rf::GetLinkStatistics().nSentBytes;
+        case Parameter::Id::minTxDataRate:
+            return persistentVariables.Load<"minTxDataRate">();
+        case Parameter::Id::maxTxDataRate:
+            return persistentVariables.Load<"maxTxDataRate">();
     }
     return 0;  // Should never be reached
 }
@@ -905,8 +1258,10 @@ auto Set(Parameter parameter) -> void
             rxDataRateTopic.publish(parameter.value);
             break;
         case Parameter::Id::txDataRate:
-            rf::SetTxDataRate(parameter.value);
-            txDataRateTopic.publish(parameter.value);
+            // The new data rate is used as the starting point for the adaptive data rate
+            ChangeTxDataRate(parameter.value);
+            persistentVariables.Store<"nGoodTxDataRateEvaluations">(0);
+            AdaptTxDataRate(rf::UplinkQuality{});
             break;
         case Parameter::Id::newEduResultIsAvailable:
             persistentVariables.Store<"newEduResultIsAvailable">(parameter.value != 0U);
@@ -914,6 +1269,34 @@ auto Set(Parameter parameter) -> void
         case Parameter::Id::maxEduIdleDuration:
             persistentVariables.Store<"maxEduIdleDuration">(parameter.value * s);
             break;
+        case Parameter::Id::txCodingProfile:
+        {
+            // Invalid profiles are ignored. The parameter value report then shows the old one.
+            auto profile = static_cast<CodingProfile>(parameter.value);
+            if(parameter.value <= std::numeric_limits<std::uint8_t>::max() and IsValid(profile))
+            {
+                rf::SetTxCodingProfile(profile);
+                persistentVariables.Store<"txCodingProfile">(static_cast<std::uint8_t>(profile));
+                persistentVariables.Store<"txCodingProfileIsSet">(true);
+            }
+            break;
+        }
+        // The link statistics are read-only. The parameter value report shows the current values.
+        case Parameter::Id::linkRssi:
+        case Parameter::Id::linkAfcOffset:
+        case Parameter::Id::nRfFifoErrors:
+        case Parameter::Id::nReceivedBytes:
+        case Parameter::Id::nSentBytes:
+            break;
+        // Apply the new bounds right away instead of waiting for the next uplink
+        case Parameter::Id::minTxDataRate:
+            persistentVariables.Store<"minTxDataRate">(parameter.value);
+            AdaptTxDataRate(rf::UplinkQuality{});
+            break;
+        case Parameter::Id::maxTxDataRate:
+            persistentVariables.Store<"maxTxDataRate">(parameter.value);
+            AdaptTxDataRate(rf::UplinkQuality{});
+            break;
     }
 }
 
@@ -984,68 +1367,6 @@ auto GetPartitionId(fs::Path const & filePath) -> Result<PartitionId>
 }
 
 
-auto SetTxDataLength(std::uint16_t nFrames) -> void
-{
-    nFramesToSend = nFrames;
-    nSentFrames = 0;
-    rf::SetTxDataLength(std::min<std::uint16_t>(nFrames, maxNFramesToSendContinously)
-                        * fullyEncodedFrameLength);
-}
-
-
-auto SendAndWait(Payload const & report) -> void
-{
-    PackageAndEncode(report);
-    SendAndWait(tmBuffer);
-}
-
-
-auto SendAndContinue(Payload const & report) -> void
-{
-    PackageAndEncode(report);
-    SendAndContinue(tmBuffer);
-}
-
-
-auto PackageAndEncode(Payload const & report) -> void
-{
-    tmFrame.StartNew(pusVcid);
-    auto result = AddSpacePacketTo(&tmFrame.GetDataField(), normalApid, report);
-    if(result.has_error())
-    {
-        DEBUG_PRINT("Failed to package report: %s\n", ToCZString(result.error()));
-    }
-    tmFrame.Finish();
-    tm::Encode(tmBlock);
-    // Write the attached sync marker to the beginning of the buffer every time because the constant
-    // is stored in flash and therefore not corrupted as fast as the buffer in RAM.
-    if constexpr(attachedSynchMarkerLength == attachedSynchMarker.size())
-    {
-        std::ranges::copy(attachedSynchMarker, tmBuffer.begin());
-    }
-}
-
-
-auto SendAndWait(std::span<Byte const, channelAccessDataUnitLength> channelAccessDataUnit) -> void
-{
-    SuspendUntilEarliestTxTime();
-    rf::SendAndWait(channelAccessDataUnit);
-}
-
-
-auto SendAndContinue(std::span<Byte const, channelAccessDataUnitLength> channelAccessDataUnit)
-    -> void
-{
-    if(nSentFrames >= maxNFramesToSendContinously)
-    {
-        FinalizeTransmission();
-        SetTxDataLength(nFramesToSend - nSentFrames);
-    }
-    SuspendUntilEarliestTxTime();
-    rf::SendAndContinue(channelAccessDataUnit);
-}
-
-
 auto SuspendUntilEarliestTxTime() -> void
 {
     auto earliestTxTime = lastRxTime + rxToTxSwitchDuration;
@@ -1054,15 +1375,5 @@ auto SuspendUntilEarliestTxTime() -> void
         SuspendUntil(earliestTxTime);
     }
 }
-
-
-auto FinalizeTransmission() -> void
-{
-    // TX FIFO buffer size <= 128 B, slowest data rate = 1.2 kbps → max. send time = 128 B * 8 b/B /
-    // 1200 b/s = 0.853 s → timeout = 1 s
-    static constexpr auto timeout = 1 * s;
-    rf::SuspendUntilDataSent(timeout);
-    rf::EnterStandbyMode();
-}
 }
 }
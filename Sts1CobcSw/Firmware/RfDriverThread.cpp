@@ -0,0 +1,169 @@
+#include <Sts1CobcSw/Firmware/RfDriverThread.hpp>
+
+#include <Sts1CobcSw/Firmware/ThreadPriorities.hpp>
+#include <Sts1CobcSw/Firmware/TopicsAndSubscribers.hpp>
+#include <Sts1CobcSw/Mailbox/Mailbox.hpp>
+#include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/Rf/Rf.hpp>
+#include <Sts1CobcSw/RodosTime/RodosTime.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <strong_type/difference.hpp>
+#include <strong_type/type.hpp>
+
+#include <rodos_no_using_namespace.h>
+
+#include <cstddef>
+#include <span>
+#include <utility>
+
+
+namespace sts1cobcsw
+{
+namespace
+{
+constexpr auto stackSize = 2000U;
+
+
+struct RfRequest
+{
+    std::span<Byte const> txData;
+    rf::ReceivedTcBlocks * rxBlocks = nullptr;  // If this is nullptr, txData is sent
+    Duration rxTimeout = 0 * s;
+    RfCompletionHandler onComplete = nullptr;
+};
+
+
+auto requestMailbox = Mailbox<RfRequest>{};
+auto completionMailbox = Mailbox<std::size_t>{};
+// Protects operationIsPending and operationIsCanceled, which are shared with the caller threads
+auto operationSemaphore = RODOS::Semaphore{};
+auto operationIsPending = false;
+auto operationIsCanceled = false;
+
+
+[[nodiscard]] auto Start(RfRequest const & request) -> Result<void>;
+[[nodiscard]] auto OperationIsCanceled() -> bool;
+auto EndOperation(std::size_t nReceivedBlocks) -> void;
+
+
+class RfDriverThread : public RODOS::StaticThread<stackSize>
+{
+public:
+    RfDriverThread() : StaticThread("RfDriverThread", rfDriverThreadPriority)
+    {}
+
+
+private:
+    auto run() -> void override
+    {
+        while(true)
+        {
+            (void)requestMailbox.SuspendUntilFullOr(endOfTime);
+            auto getResult = requestMailbox.Get();
+            if(getResult.has_error())
+            {
+                continue;
+            }
+            auto const & request = getResult.value();
+            auto nReceivedBlocks = std::size_t{0};
+            if(request.rxBlocks == nullptr)
+            {
+                rf::SendAndWait(request.txData);
+            }
+            // The operation might have been canceled before it even started
+            else if(not OperationIsCanceled())
+            {
+                nReceivedBlocks =
+                    rf::ReceiveBurst(&tcBlockPool, request.rxBlocks, request.rxTimeout);
+            }
+            if(request.onComplete != nullptr)
+            {
+                request.onComplete(nReceivedBlocks);
+            }
+            EndOperation(nReceivedBlocks);
+        }
+    }
+} rfDriverThread;
+}
+
+
+auto StartRfSend(std::span<Byte const> data, RfCompletionHandler onComplete) -> Result<void>
+{
+    return Start(RfRequest{.txData = data, .onComplete = onComplete});
+}
+
+
+auto StartRfReceive(rf::ReceivedTcBlocks * blocks, Duration timeout, RfCompletionHandler onComplete)
+    -> Result<void>
+{
+    return Start(RfRequest{.rxBlocks = blocks, .rxTimeout = timeout, .onComplete = onComplete});
+}
+
+
+auto RfOperationIsComplete() -> bool
+{
+    return completionMailbox.IsFull();
+}
+
+
+auto SuspendUntilRfOperationIsCompleteOr(RodosTime time) -> Result<std::size_t>
+{
+    // Other threads resume the caller for their own reasons, so being resumed does not mean that
+    // the operation is complete
+    while(not completionMailbox.IsFull())
+    {
+        OUTCOME_TRY(completionMailbox.SuspendUntilFullOr(time));
+    }
+    return completionMailbox.Get();
+}
+
+
+auto CancelRfOperation() -> void
+{
+    auto protector = RODOS::ScopeProtector(&operationSemaphore);  // NOLINT(*readability-casting)
+    if(operationIsPending)
+    {
+        operationIsCanceled = true;
+        rf::CancelReceive();
+    }
+}
+
+
+namespace
+{
+auto Start(RfRequest const & request) -> Result<void>
+{
+    {
+        auto protector = RODOS::ScopeProtector(&operationSemaphore);
+        if(operationIsPending)
+        {
+            return ErrorCode::rfIsBusy;
+        }
+        operationIsPending = true;
+        operationIsCanceled = false;
+    }
+    // Discard the result of the previous operation if nobody collected it
+    (void)completionMailbox.Get();
+    return requestMailbox.Put(request);
+}
+
+
+auto OperationIsCanceled() -> bool
+{
+    auto protector = RODOS::ScopeProtector(&operationSemaphore);  // NOLINT(*readability-casting)
+    return operationIsCanceled;
+}
+
+
+// The result is published together with the end of the operation. Otherwise, a new operation could
+// be started in between and mistake the old result for its own.
+auto EndOperation(std::size_t nReceivedBlocks) -> void
+{
+    auto protector = RODOS::ScopeProtector(&operationSemaphore);  // NOLINT(*readability-casting)
+    operationIsPending = false;
+    completionMailbox.Overwrite(nReceivedBlocks);
+}
+}
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/Rf/Rf.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <cstddef>
+#include <span>
+
+
+// The RF driver thread runs RF operations in the background so that the caller can do something
+// else in the meantime. Only one operation can be pending at a time and the caller must not use the
+// blocking rf:: functions until it is complete.
+namespace sts1cobcsw
+{
+// Called from the RF driver thread when an operation is complete. The argument is the number of
+// received TC blocks, which is always 0 for sending.
+using RfCompletionHandler = void (*)(std::size_t nReceivedBlocks);
+
+
+// Start sending the data and return immediately. The data must stay valid until the operation is
+// complete. Sending cannot be canceled since the data is already on its way.
+[[nodiscard]] auto StartRfSend(std::span<Byte const> data, RfCompletionHandler onComplete = nullptr)
+    -> Result<void>;
+// Start receiving a burst of TC blocks from the TC block pool like rf::ReceiveBurst() and return
+// immediately. The block vector must stay valid until the operation is complete. Afterward, the
+// caller owns the received blocks and must release them to the pool.
+[[nodiscard]] auto StartRfReceive(rf::ReceivedTcBlocks * blocks,
+                                  Duration timeout,
+                                  RfCompletionHandler onComplete = nullptr) -> Result<void>;
+// Return true if the last started operation is complete and its result has not been collected yet
+[[nodiscard]] auto RfOperationIsComplete() -> bool;
+// Collect the result of the last started operation, i.e., the number of received blocks. Only
+// returns early if the time is reached, not when the calling thread is resumed for another reason.
+[[nodiscard]] auto SuspendUntilRfOperationIsCompleteOr(RodosTime time) -> Result<std::size_t>;
+// End a pending reception early. The operation still completes normally with everything that was
+// received until then.
+auto CancelRfOperation() -> void;
+}
@@ -14,6 +14,9 @@
 #include <Sts1CobcSw/Mailbox/Mailbox.hpp>
 #include <Sts1CobcSw/Outcome/Outcome.hpp>  // IWYU pragma: keep
 #include <Sts1CobcSw/RealTime/RealTime.hpp>
+#include <Sts1CobcSw/Rf/AirtimeScheduler.hpp>
+#include <Sts1CobcSw/Rf/DataRateController.hpp>
+#include <Sts1CobcSw/Rf/Rf.hpp>
 #include <Sts1CobcSw/RodosTime/RodosTime.hpp>
 #include <Sts1CobcSw/Sensors/Eps.hpp>
 #include <Sts1CobcSw/Sensors/TemperatureSensor.hpp>
@@ -22,6 +25,7 @@
 #include <Sts1CobcSw/Telemetry/TelemetryRecord.hpp>
 #include <Sts1CobcSw/Utility/DebugPrint.hpp>
 #include <Sts1CobcSw/Vocabulary/Ids.hpp>
+#include <Sts1CobcSw/Vocabulary/LinkStatistics.hpp>
 #include <Sts1CobcSw/Vocabulary/MessageTypeIdFields.hpp>
 #include <Sts1CobcSw/Vocabulary/Time.hpp>
 
@@ -145,6 +149,10 @@ auto CollectTelemetryData() -> TelemetryRecord
     rxDataRateBuffer.get(rxDataRate);
     std::uint32_t txDataRate = 0;
     txDataRateBuffer.get(txDataRate);
+    auto lastTxDataRateDecision = rf::DataRateDecision::keep;
+    txDataRateDecisionBuffer.get(lastTxDataRateDecision);
+    auto schedulerStatistics = rf::SchedulerStatistics{};
+    schedulerStatisticsBuffer.get(schedulerStatistics);
     return TelemetryRecord{
         // Booleans: byte 1
         .eduShouldBePowered = persistentVariables.Load<"eduShouldBePowered">() ? 1 : 0,
@@ -193,10 +201,14 @@ auto CollectTelemetryData() -> TelemetryRecord
         .nUncorrectableUplinkErrors = persistentVariables.Load<"nUncorrectableUplinkErrors">(),
         .nGoodTransferFrames = persistentVariables.Load<"nGoodTransferFrames">(),
         .nBadTransferFrames = persistentVariables.Load<"nBadTransferFrames">(),
+        .nDroppedPdus = persistentVariables.Load<"nDroppedPdus">(),
         .lastFrameSequenceNumber = persistentVariables.Load<"lastFrameSequenceNumber">(),
         .lastMessageTypeId = persistentVariables.Load<"lastMessageTypeId">(),
         .fileTransferStatus = fileTransferStatus.Load(),
-        .transactionSequenceNumber = transactionSequenceNumber.Load()};
+        .transactionSequenceNumber = transactionSequenceNumber.Load(),
+        .linkStatistics = rf::GetLinkStatistics(),
+        .lastTxDataRateDecision = lastTxDataRateDecision,
+        .schedulerStatistics = schedulerStatistics};
 }
 }
 }
@@ -19,6 +19,8 @@ inline constexpr auto eduHeartbeatThreadPriority = 260;
 inline constexpr auto fileTransferThreadPriority = 800;
 inline constexpr auto rfCommunicationThreadPriority = 900;
 inline constexpr auto telemetryThreadPriority = 910;
+// Higher than the RF communication thread so that RX and TX interrupts are handled right away
+inline constexpr auto rfDriverThreadPriority = 920;
 inline constexpr auto startupAndSpiSupervisorThreadPriority = MAX_THREAD_PRIORITY;
 static_assert(MAX_THREAD_PRIORITY == 1000);  // NOLINT(*magic-numbers)
 }
@@ -34,5 +34,11 @@ RODOS::Subscriber programIdOfCurrentEduProgramQueueEntrySubscriber(
     "programIdOfCurrentEduProgramQueueEntrySubscriber");
 RODOS::Subscriber rxDataRateSubscriber(rxDataRateTopic, rxDataRateBuffer, "rxDataRateSubscriber");
 RODOS::Subscriber txDataRateSubscriber(txDataRateTopic, txDataRateBuffer, "txDataRateSubscriber");
+RODOS::Subscriber txDataRateDecisionSubscriber(txDataRateDecisionTopic,
+                                               txDataRateDecisionBuffer,
+                                               "txDataRateDecisionSubscriber");
+RODOS::Subscriber schedulerStatisticsSubscriber(schedulerStatisticsTopic,
+                                                schedulerStatisticsBuffer,
+                                                "schedulerStatisticsSubscriber");
 }
 }
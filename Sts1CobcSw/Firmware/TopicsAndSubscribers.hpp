@@ -1,21 +1,22 @@
 #pragma once
 
 
-#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
 #include <Sts1CobcSw/ErrorDetectionAndCorrection/EdacVariable.hpp>
 #include <Sts1CobcSw/Firmware/FileTransferThread.hpp>
 #include <Sts1CobcSw/Mailbox/Mailbox.hpp>
+#include <Sts1CobcSw/Rf/TcBlockPool.hpp>
 #include <Sts1CobcSw/RfProtocols/ProtocolDataUnits.hpp>
-#include <Sts1CobcSw/Serial/Byte.hpp>
 #include <Sts1CobcSw/Serial/UInt.hpp>
 #include <Sts1CobcSw/Telemetry/TelemetryRecord.hpp>
+#include <Sts1CobcSw/TmTransmission/TmTransmission.hpp>
+#include <Sts1CobcSw/Vocabulary/DataRateDecision.hpp>
 #include <Sts1CobcSw/Vocabulary/FileTransfer.hpp>
 #include <Sts1CobcSw/Vocabulary/Ids.hpp>
+#include <Sts1CobcSw/Vocabulary/SchedulerStatistics.hpp>
 #include <Sts1CobcSw/Vocabulary/Time.hpp>
 
 #include <rodos_no_using_namespace.h>
 
-#include <array>
 #include <cstdint>
 
 
@@ -23,6 +24,15 @@
 // InterprocessCommunication, or something similar.
 namespace sts1cobcsw
 {
+// A received PDU still lives in the TC block it was parsed from. Whoever takes it from the mailbox
+// owns the block and must release it to the pool when the PDU is no longer needed.
+struct ReceivedPdu
+{
+    tc::ProtocolDataUnit pdu;
+    rf::ReceivedTcBlock * block = nullptr;
+};
+
+
 // Topics and subscribers must be defined in the same file to prevent a static initialization order
 // fiasco
 inline auto eduIsAliveTopic = RODOS::Topic<bool>(-1, "eduIsAliveTopic");
@@ -47,13 +57,23 @@ inline auto rxDataRateBuffer = RODOS::CommBuffer<std::uint32_t>{};
 inline auto txDataRateTopic = RODOS::Topic<std::uint32_t>(-1, "txDataRateTopic");
 inline auto txDataRateBuffer = RODOS::CommBuffer<std::uint32_t>{};
 
+inline auto txDataRateDecisionTopic =
+    RODOS::Topic<rf::DataRateDecision>(-1, "txDataRateDecisionTopic");
+inline auto txDataRateDecisionBuffer = RODOS::CommBuffer<rf::DataRateDecision>{};
+
+inline auto schedulerStatisticsTopic =
+    RODOS::Topic<rf::SchedulerStatistics>(-1, "schedulerStatisticsTopic");
+inline auto schedulerStatisticsBuffer = RODOS::CommBuffer<rf::SchedulerStatistics>{};
+
 // We only send the telemetry records from the telemetry thread to the RF communication thread, so
 // we don't need the whole publisher/subscriber mechanism here. A simple mailbox is enough.
 inline auto telemetryRecordMailbox = Mailbox<TelemetryRecord>{};
 inline auto nextTelemetryRecordTimeMailbox = Mailbox<RodosTime>{};
 inline auto fileTransferMetadataMailbox = Mailbox<FileTransferMetadata>{};
-inline auto receivedPduMailbox = Mailbox<tc::ProtocolDataUnit>{};
-inline auto encodedCfdpFrameMailbox = Mailbox<std::array<Byte, blockLength>>{};
+inline auto receivedPduMailbox = Mailbox<ReceivedPdu>{};
+inline auto cfdpFrameQueue = CfdpFrameQueue{};
+
+inline auto tcBlockPool = rf::TcBlockPool{};
 
 inline auto fileTransferStatus = EdacVariable<FileTransferStatus>{};
 inline auto transactionSequenceNumber = EdacVariable<std::uint16_t>{};
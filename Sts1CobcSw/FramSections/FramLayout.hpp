@@ -58,11 +58,21 @@ inline constexpr auto persistentVariables =
                         PersistentVariableInfo<"nUncorrectableUplinkErrors", std::uint16_t>,
                         PersistentVariableInfo<"nGoodTransferFrames", std::uint16_t>,
                         PersistentVariableInfo<"nBadTransferFrames", std::uint16_t>,
+                        PersistentVariableInfo<"nDroppedPdus", std::uint16_t>,
                         PersistentVariableInfo<"lastFrameSequenceNumber", std::uint8_t>,
                         PersistentVariableInfo<"lastMessageTypeId", MessageTypeIdFields>,
                         PersistentVariableInfo<"lastMessageTypeIdWasInvalid", bool>,
                         PersistentVariableInfo<"lastApplicationDataWasInvalid", bool>,
                         // TODO: Find a better name to not confuse it with transactionSequenceNumber
                         // in TopicsAndSubscribers.hpp
-                        PersistentVariableInfo<"transactionSequenceNumber", std::uint16_t>>{};
+                        PersistentVariableInfo<"transactionSequenceNumber", std::uint16_t>,
+                        // Adaptive TX data rate, see rf::AdaptDataRate()
+                        PersistentVariableInfo<"txDataRate", std::uint32_t>,
+                        PersistentVariableInfo<"minTxDataRate", std::uint32_t>,
+                        PersistentVariableInfo<"maxTxDataRate", std::uint32_t>,
+                        PersistentVariableInfo<"nGoodTxDataRateEvaluations", std::uint8_t>,
+                        // TX coding profile. It is only restored if it was ever set, since a zero
+                        // would otherwise turn off all channel coding.
+                        PersistentVariableInfo<"txCodingProfileIsSet", bool>,
+                        PersistentVariableInfo<"txCodingProfile", std::uint8_t>>{};
 }
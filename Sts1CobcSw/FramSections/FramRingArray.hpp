@@ -7,6 +7,7 @@
 #include <Sts1CobcSw/FramSections/Section.hpp>
 #include <Sts1CobcSw/FramSections/SubsectionInfo.hpp>
 #include <Sts1CobcSw/FramSections/Subsections.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
 #include <Sts1CobcSw/Serial/Serial.hpp>
 #include <Sts1CobcSw/Utility/Span.hpp>
 #include <Sts1CobcSw/Vocabulary/Time.hpp>
@@ -45,6 +46,13 @@ public:
     [[nodiscard]] static auto Size() -> SizeType;
     // Return the last element if index >= size and T{} if the ring is empty
     [[nodiscard]] static auto Get(IndexType index) -> T;
+    // Get up to elements.size() consecutive elements starting at firstIndex and return how many
+    // there were. The indexes are loaded only once, and the elements are read with at most two FRAM
+    // accesses, one before and one after the wrap-around of the ring.
+    template<std::size_t extent>
+        requires(extent != std::dynamic_extent)
+    [[nodiscard]] static auto GetRange(IndexType firstIndex, std::span<T, extent> elements)
+        -> SizeType;
     // Return T{} if the ring is empty
     [[nodiscard]] static auto Front() -> T;
     // Return T{} if the ring is empty
@@ -93,6 +101,8 @@ private:
     [[nodiscard]] static auto LoadIndexes() -> Indexes;
     // NOLINTNEXTLINE(*unnecessary-value-param)
     [[nodiscard]] static auto LoadElement(RingIndex index) -> T;
+    // NOLINTNEXTLINE(*unnecessary-value-param)
+    static auto LoadElements(RingIndex firstIndex, std::span<Byte> data) -> void;
     static auto StoreIndexes(Indexes const & indexes) -> void;
     // NOLINTNEXTLINE(*unnecessary-value-param)
     static auto StoreElement(RingIndex index, T const & t) -> void;
@@ -6,6 +6,9 @@
 #include <Sts1CobcSw/Utility/DebugPrint.hpp>
 #include <Sts1CobcSw/Utility/Span.hpp>
 
+#include <algorithm>
+#include <array>
+
 
 namespace sts1cobcsw
 {
@@ -54,6 +57,51 @@ auto FramRingArray<T, framRingArraySection, nCachedElements>::Get(IndexType inde
 }
 
 
+template<typename T, Section framRingArraySection, std::uint32_t nCachedElements>
+    requires(serialSize<T> > 0)
+template<std::size_t extent>
+    requires(extent != std::dynamic_extent)
+auto FramRingArray<T, framRingArraySection, nCachedElements>::GetRange(
+    IndexType firstIndex, std::span<T, extent> elements) -> SizeType
+{
+    auto protector = RODOS::ScopeProtector(&semaphore);  // NOLINT(google-readability-casting)
+    if(not framIsWorking.Load())
+    {
+        auto cacheSize = static_cast<SizeType>(cache.size());
+        auto nElements =
+            firstIndex < cacheSize ? std::min<SizeType>(extent, cacheSize - firstIndex) : 0U;
+        for(SizeType i = 0; i < nElements; ++i)
+        {
+            elements[i] = Deserialize<endianness, T>(cache[firstIndex + i]);
+        }
+        return nElements;
+    }
+    auto indexes = LoadIndexes();
+    auto framArraySize = FramArraySize(indexes);
+    if(firstIndex >= framArraySize)
+    {
+        return 0;
+    }
+    auto nElements = std::min<SizeType>(extent, framArraySize - firstIndex);
+    auto i = indexes.iBegin;
+    i.advance(static_cast<int>(firstIndex));
+    auto nElementsBeforeWrapAround = std::min<SizeType>(nElements, framCapacity + 1 - i.get());
+    auto buffer = std::array<Byte, extent * serialSize<T>>{};
+    auto data = std::span<Byte>(buffer).first(nElements * serialSize<T>);
+    LoadElements(i, data.first(nElementsBeforeWrapAround * serialSize<T>));
+    if(nElementsBeforeWrapAround < nElements)
+    {
+        LoadElements(RingIndex{}, data.subspan(nElementsBeforeWrapAround * serialSize<T>));
+    }
+    for(SizeType j = 0; j < nElements; ++j)
+    {
+        elements[j] = Deserialize<endianness, T>(
+            SerialBufferView<T>(data.subspan(j * serialSize<T>).template first<serialSize<T>>()));
+    }
+    return nElements;
+}
+
+
 template<typename T, Section framRingArraySection, std::uint32_t nCachedElements>
     requires(serialSize<T> > 0)
 auto FramRingArray<T, framRingArraySection, nCachedElements>::Front() -> T
@@ -299,6 +347,19 @@ auto FramRingArray<T, framRingArraySection, nCachedElements>::LoadElement(RingIn
 }
 
 
+// Load consecutive array elements from the FRAM without wrapping around
+template<typename T, Section framRingArraySection, std::uint32_t nCachedElements>
+    requires(serialSize<T> > 0)
+auto FramRingArray<T, framRingArraySection, nCachedElements>::LoadElements(RingIndex firstIndex,
+                                                                           std::span<Byte> data)
+    -> void
+{
+    auto address = subsections.template Get<"array">().begin + firstIndex.get() * elementSize;
+    auto timeout = data.size() < 300U ? 1 * ms : static_cast<std::int64_t>(data.size()) * 3 * us;
+    fram::ReadFrom(address, data, timeout);
+}
+
+
 // Store the begin and end indexes on the FRAM
 template<typename T, Section framRingArraySection, std::uint32_t nCachedElements>
     requires(serialSize<T> > 0)
@@ -0,0 +1,420 @@
+#include <Sts1CobcSw/Hal/DmaSpi.hpp>
+
+#include <Sts1CobcSw/CmsisDevice/stm32f411xe.h>
+#include <Sts1CobcSw/RodosTime/RodosTime.hpp>
+
+#include <strong_type/affine_point.hpp>
+#include <strong_type/difference.hpp>
+
+#include <array>
+#include <climits>
+#include <cstdint>
+
+
+namespace sts1cobcsw::hal
+{
+// NOLINTBEGIN(*no-int-to-ptr, *cstyle-cast, *reinterpret-cast)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wold-style-cast"
+
+namespace
+{
+// Both directions of an SPI always use the same DMA channel. The streams are chosen such that they
+// do not collide with those that RODOS uses for UART DMA (USART1: DMA2 streams 5 and 7, USART2:
+// DMA1 streams 5 and 6, USART6: DMA2 streams 1 and 6).
+struct DmaStreams
+{
+    SPI_TypeDef * spi = nullptr;
+    DMA_TypeDef * dma = nullptr;
+    DMA_Stream_TypeDef * rxStream = nullptr;
+    DMA_Stream_TypeDef * txStream = nullptr;
+    unsigned int iRxStream = 0;
+    unsigned int iTxStream = 0;
+    std::uint32_t channel = 0;
+    IRQn_Type rxInterrupt = DMA1_Stream0_IRQn;
+    IRQn_Type txInterrupt = DMA1_Stream0_IRQn;
+};
+
+
+// The interrupt flags of stream i start at bit flagOffsets[i % 4] of the LISR/HISR registers
+constexpr auto flagOffsets = std::array{0U, 6U, 16U, 22U};
+// TCIF, HTIF, TEIF, DMEIF and FEIF
+constexpr auto allStreamFlags = 0x3DU;
+constexpr auto transferCompleteFlag = 0x20U;
+constexpr auto transferErrorFlag = 0x08U;
+constexpr auto nStreamsPerFlagRegister = 4U;
+constexpr auto nvicIserAddress = 0xE000'E100U;
+constexpr auto nvicIprAddress = 0xE000'E400U;
+constexpr auto nInterruptsPerIserRegister = 32U;
+// The interrupt only resumes a thread, so it gets the second lowest priority. It must still be
+// higher than that of PendSV, which RODOS uses for context switches and which has the lowest one.
+constexpr auto dmaInterruptPriority = (1U << __NVIC_PRIO_BITS) - 2U;
+
+auto dmaSpis = std::array<DmaSpi *, 4>{};
+
+
+[[nodiscard]] auto GetDmaStreams(RODOS::SPI_IDX spiIndex) -> DmaStreams;
+[[nodiscard]] auto StreamFlags(DmaStreams const & streams, unsigned int iStream) -> std::uint32_t;
+auto ClearStreamFlags(DmaStreams const & streams, unsigned int iStream) -> void;
+auto ConfigureStream(DmaStreams const & streams,
+                     DMA_Stream_TypeDef * stream,
+                     std::uint32_t direction,
+                     void const * memory,
+                     bool incrementMemory,
+                     std::size_t nBytes) -> void;
+auto DisableStream(DMA_Stream_TypeDef * stream) -> void;
+auto EnableInterrupt(IRQn_Type interrupt, std::uint32_t priority) -> void;
+auto DisableInterrupts() -> void;
+auto EnableInterrupts() -> void;
+auto HandleDmaInterrupt(RODOS::SPI_IDX spiIndex) -> void;
+}
+
+
+DmaSpi::DmaSpi(RODOS::SPI_IDX spiIndex,
+               RODOS::GPIO_PIN sckPin,
+               RODOS::GPIO_PIN misoPin,
+               RODOS::GPIO_PIN mosiPin)
+    : spi_(spiIndex, sckPin, misoPin, mosiPin), spiIndex_(spiIndex)
+{
+    dmaSpis[spiIndex] = this;
+}
+
+
+// The flags are set before the thread is resumed, so it sees them as soon as it runs again
+auto DmaSpi::OnTransferEnd(bool transferFailed) -> void
+{
+    transferFailed_ = transferFailed;
+    transferHasEnded_ = true;
+    if(waitingThread_ != nullptr)
+    {
+        waitingThread_->resume();
+    }
+}
+
+
+auto DmaSpi::DoInitialize(std::uint32_t baudRate, bool useOpenDrainOutputs) -> void
+{
+    // spi.init() only returns -1 if the SPI_IDX is out of range. Since we can check that statically
+    // we do not need to report that error at runtime.
+    spi_.init(baudRate, /*slave=*/false, /*tiMode=*/false, useOpenDrainOutputs);
+    auto streams = GetDmaStreams(spiIndex_);
+    RCC->AHB1ENR |= streams.dma == DMA1 ? RCC_AHB1ENR_DMA1EN : RCC_AHB1ENR_DMA2EN;
+    EnableInterrupt(streams.rxInterrupt, dmaInterruptPriority);
+    EnableInterrupt(streams.txInterrupt, dmaInterruptPriority);
+    SetTransferEnd(endOfTime);
+}
+
+
+auto DmaSpi::Read(void * data, std::size_t nBytes, Duration timeout) -> void
+{
+    if(nBytes == 0)
+    {
+        return;
+    }
+    SetTransferEnd(CurrentRodosTime() + timeout);
+    if(nBytes < minDmaTransferLength)
+    {
+        // spi.read() only returns -1 or the given buffer length. It only returns -1 if the SPI is
+        // not initialized, which we can check/ensure statically.
+        spi_.read(data, nBytes);
+    }
+    else if(Transfer(data, nullptr, nBytes).has_error())
+    {
+        return;
+    }
+    SetTransferEnd(endOfTime);
+}
+
+
+auto DmaSpi::Write(void const * data, std::size_t nBytes, Duration timeout) -> void
+{
+    if(nBytes == 0)
+    {
+        // spi_.write() can get stuck in an infinite loop if nBytes is 0, so we return early
+        return;
+    }
+    SetTransferEnd(CurrentRodosTime() + timeout);
+    if(nBytes < minDmaTransferLength)
+    {
+        // spi.write() only returns -1 or the given buffer length. It only returns -1 if the SPI is
+        // not initialized, which we can check/ensure statically.
+        spi_.write(data, nBytes);
+    }
+    else if(Transfer(nullptr, data, nBytes).has_error())
+    {
+        return;
+    }
+    SetTransferEnd(endOfTime);
+}
+
+
+auto DmaSpi::DoTransferEnd() const -> RodosTime
+{
+    auto protector = RODOS::ScopeProtector(&transferEndSemaphore_);
+    return transferEnd_;
+}
+
+
+auto DmaSpi::DoBaudRate() const -> std::int32_t
+{
+    return spi_.status(RODOS::SPI_STATUS_BAUDRATE);
+}
+
+
+auto DmaSpi::SetTransferEnd(RodosTime transferEnd) -> void
+{
+    auto protector = RODOS::ScopeProtector(&transferEndSemaphore_);
+    transferEnd_ = transferEnd;
+}
+
+
+auto DmaSpi::Transfer(void * rxData, void const * txData, std::size_t nBytes) -> Result<void>
+{
+    auto streams = GetDmaStreams(spiIndex_);
+    // Discard the data and the overrun flag that HAL_SPI or the last transfer might have left
+    (void)streams.spi->DR;
+    (void)streams.spi->SR;
+    ClearStreamFlags(streams, streams.iRxStream);
+    ClearStreamFlags(streams, streams.iTxStream);
+    // The transfer is always finished by the RX stream since the last byte is only received after
+    // it was completely sent. Errors of both streams end it early.
+    ConfigureStream(streams,
+                    streams.rxStream,
+                    /*direction=*/0U,
+                    rxData == nullptr ? &rxDummyByte_ : rxData,
+                    /*incrementMemory=*/rxData != nullptr,
+                    nBytes);
+    ConfigureStream(streams,
+                    streams.txStream,
+                    DMA_SxCR_DIR_0,
+                    txData == nullptr ? &txDummyByte_ : txData,
+                    /*incrementMemory=*/txData != nullptr,
+                    nBytes);
+    streams.rxStream->CR |= DMA_SxCR_TCIE | DMA_SxCR_TEIE;
+    streams.txStream->CR |= DMA_SxCR_TEIE;
+    waitingThread_ = RODOS::Thread::getCurrentThread();
+    transferFailed_ = false;
+    transferHasEnded_ = false;
+    streams.spi->CR2 |= SPI_CR2_RXDMAEN;
+    streams.rxStream->CR |= DMA_SxCR_EN;
+    streams.txStream->CR |= DMA_SxCR_EN;
+    streams.spi->CR2 |= SPI_CR2_TXDMAEN;
+    auto result = SuspendUntilTransferEndOr(DoTransferEnd());
+    waitingThread_ = nullptr;
+    // After an error or a timeout, the other stream might still be running
+    DisableStream(streams.rxStream);
+    DisableStream(streams.txStream);
+    // HAL_SPI does not expect the DMA requests to be enabled
+    streams.spi->CR2 &= ~(SPI_CR2_RXDMAEN | SPI_CR2_TXDMAEN);
+    return result;
+}
+
+
+// If the interrupt came between checking the flag and suspending, its wake-up would be lost. While
+// interrupts are disabled, suspending only marks the thread as suspended and requests a context
+// switch with PendSV. Once they are enabled again, a pending DMA interrupt is handled first because
+// it has a higher priority than PendSV, so the thread is resumed before the scheduler runs.
+auto DmaSpi::SuspendUntilTransferEndOr(RodosTime time) -> Result<void>
+{
+    while(true)
+    {
+        DisableInterrupts();
+        if(transferHasEnded_)
+        {
+            EnableInterrupts();
+            break;
+        }
+        if(CurrentRodosTime() >= time)
+        {
+            EnableInterrupts();
+            return ErrorCode::timeout;
+        }
+        SuspendUntil(time);
+        EnableInterrupts();
+    }
+    if(transferFailed_)
+    {
+        return ErrorCode::spiTransferFailed;
+    }
+    return outcome_v2::success();
+}
+
+
+namespace
+{
+auto GetDmaStreams(RODOS::SPI_IDX spiIndex) -> DmaStreams
+{
+    static constexpr auto channel0 = 0U;
+    static constexpr auto channel3 = 3U << DMA_SxCR_CHSEL_Pos;
+    switch(spiIndex)
+    {
+        case RODOS::SPI_IDX1:
+            return DmaStreams{.spi = SPI1,
+                              .dma = DMA2,
+                              .rxStream = DMA2_Stream0,
+                              .txStream = DMA2_Stream3,
+                              .iRxStream = 0,
+                              .iTxStream = 3,
+                              .channel = channel3,
+                              .rxInterrupt = DMA2_Stream0_IRQn,
+                              .txInterrupt = DMA2_Stream3_IRQn};
+        case RODOS::SPI_IDX2:
+            return DmaStreams{.spi = SPI2,
+                              .dma = DMA1,
+                              .rxStream = DMA1_Stream3,
+                              .txStream = DMA1_Stream4,
+                              .iRxStream = 3,
+                              .iTxStream = 4,
+                              .channel = channel0,
+                              .rxInterrupt = DMA1_Stream3_IRQn,
+                              .txInterrupt = DMA1_Stream4_IRQn};
+        default:
+            return DmaStreams{.spi = SPI3,
+                              .dma = DMA1,
+                              .rxStream = DMA1_Stream0,
+                              .txStream = DMA1_Stream7,
+                              .iRxStream = 0,
+                              .iTxStream = 7,
+                              .channel = channel0,
+                              .rxInterrupt = DMA1_Stream0_IRQn,
+                              .txInterrupt = DMA1_Stream7_IRQn};
+    }
+}
+
+
+auto StreamFlags(DmaStreams const & streams, unsigned int iStream) -> std::uint32_t
+{
+    auto flags = iStream < nStreamsPerFlagRegister ? streams.dma->LISR : streams.dma->HISR;
+    return (flags >> flagOffsets[iStream % nStreamsPerFlagRegister]) & allStreamFlags;
+}
+
+
+auto ClearStreamFlags(DmaStreams const & streams, unsigned int iStream) -> void
+{
+    auto flags = allStreamFlags << flagOffsets[iStream % nStreamsPerFlagRegister];
+    if(iStream < nStreamsPerFlagRegister)
+    {
+        streams.dma->LIFCR = flags;
+    }
+    else
+    {
+        streams.dma->HIFCR = flags;
+    }
+}
+
+
+// Configure a byte-wise, normal-mode transfer between the SPI data register and memory
+auto ConfigureStream(DmaStreams const & streams,
+                     DMA_Stream_TypeDef * stream,
+                     std::uint32_t direction,
+                     void const * memory,
+                     bool incrementMemory,
+                     std::size_t nBytes) -> void
+{
+    stream->CR = 0;
+    while((stream->CR & DMA_SxCR_EN) != 0) {}
+    stream->PAR = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(&streams.spi->DR));
+    stream->M0AR = static_cast<std::uint32_t>(reinterpret_cast<std::uintptr_t>(memory));
+    stream->NDTR = static_cast<std::uint32_t>(nBytes);
+    stream->FCR = 0;  // Direct mode
+    stream->CR = streams.channel | direction | (incrementMemory ? DMA_SxCR_MINC : 0U);
+}
+
+
+auto DisableStream(DMA_Stream_TypeDef * stream) -> void
+{
+    stream->CR &= ~DMA_SxCR_EN;
+    while((stream->CR & DMA_SxCR_EN) != 0) {}
+}
+
+
+// core_cm4.h is not part of our CMSIS device files, so we write to the NVIC directly. The priority
+// is in the upper bits of the byte-wide priority register.
+auto EnableInterrupt(IRQn_Type interrupt, std::uint32_t priority) -> void
+{
+    auto iInterrupt = static_cast<std::uint32_t>(interrupt);
+    auto * ipr = reinterpret_cast<std::uint8_t volatile *>(nvicIprAddress + iInterrupt);
+    *ipr = static_cast<std::uint8_t>(priority << (CHAR_BIT - __NVIC_PRIO_BITS));
+    auto * iser = reinterpret_cast<std::uint32_t volatile *>(
+        nvicIserAddress + (iInterrupt / nInterruptsPerIserRegister) * sizeof(std::uint32_t));
+    *iser = 1U << (iInterrupt % nInterruptsPerIserRegister);
+}
+
+
+// For the same reason, we use the instructions instead of __disable_irq() and __enable_irq()
+auto DisableInterrupts() -> void
+{
+    asm volatile("cpsid i" ::: "memory");
+}
+
+
+auto EnableInterrupts() -> void
+{
+    asm volatile("cpsie i" ::: "memory");
+}
+
+
+// The RX and TX streams of an SPI share this handler
+auto HandleDmaInterrupt(RODOS::SPI_IDX spiIndex) -> void
+{
+    auto streams = GetDmaStreams(spiIndex);
+    auto rxFlags = StreamFlags(streams, streams.iRxStream);
+    auto txFlags = StreamFlags(streams, streams.iTxStream);
+    ClearStreamFlags(streams, streams.iRxStream);
+    ClearStreamFlags(streams, streams.iTxStream);
+    if(dmaSpis[spiIndex] == nullptr)
+    {
+        return;
+    }
+    if(((rxFlags | txFlags) & transferErrorFlag) != 0U)
+    {
+        dmaSpis[spiIndex]->OnTransferEnd(/*transferFailed=*/true);
+    }
+    else if((rxFlags & transferCompleteFlag) != 0U)
+    {
+        dmaSpis[spiIndex]->OnTransferEnd(/*transferFailed=*/false);
+    }
+}
+}
+
+#pragma GCC diagnostic pop
+// NOLINTEND(*no-int-to-ptr, *cstyle-cast, *reinterpret-cast)
+}
+
+
+// NOLINTBEGIN(*identifier-naming, *use-internal-linkage)
+extern "C" auto DMA2_Stream0_IRQHandler() -> void
+{
+    sts1cobcsw::hal::HandleDmaInterrupt(RODOS::SPI_IDX1);
+}
+
+
+extern "C" auto DMA2_Stream3_IRQHandler() -> void
+{
+    sts1cobcsw::hal::HandleDmaInterrupt(RODOS::SPI_IDX1);
+}
+
+
+extern "C" auto DMA1_Stream3_IRQHandler() -> void
+{
+    sts1cobcsw::hal::HandleDmaInterrupt(RODOS::SPI_IDX2);
+}
+
+
+extern "C" auto DMA1_Stream4_IRQHandler() -> void
+{
+    sts1cobcsw::hal::HandleDmaInterrupt(RODOS::SPI_IDX2);
+}
+
+
+extern "C" auto DMA1_Stream0_IRQHandler() -> void
+{
+    sts1cobcsw::hal::HandleDmaInterrupt(RODOS::SPI_IDX3);
+}
+
+
+extern "C" auto DMA1_Stream7_IRQHandler() -> void
+{
+    sts1cobcsw::hal::HandleDmaInterrupt(RODOS::SPI_IDX3);
+}
+// NOLINTEND(*identifier-naming, *use-internal-linkage)
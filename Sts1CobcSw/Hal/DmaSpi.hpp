@@ -0,0 +1,76 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Hal/Spi.hpp>
+#include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <strong_type/type.hpp>
+
+#include <rodos_no_using_namespace.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+
+namespace sts1cobcsw::hal
+{
+// Shorter transfers are done by HAL_SPI since setting up the DMA and switching threads would take
+// longer than busy-waiting on the few bytes
+inline constexpr auto minDmaTransferLength = 16U;
+
+
+// An SPI that moves the data with DMA instead of having the CPU busy-wait on every byte like
+// HAL_SPI does. The calling thread is suspended until the transfer-complete interrupt of the DMA
+// resumes it, so lower-priority threads can run in the meantime. Pins, clock and baud rate are
+// still configured by HAL_SPI.
+//
+// The Spi interface cannot report errors. If a DMA transfer fails, its transfer end is therefore
+// not reset, so that the SPI supervisor thread resets the COBC just like for a stuck transfer.
+class DmaSpi : public Spi
+{
+public:
+    DmaSpi(RODOS::SPI_IDX spiIndex,
+           RODOS::GPIO_PIN sckPin,
+           RODOS::GPIO_PIN misoPin,
+           RODOS::GPIO_PIN mosiPin);
+    DmaSpi(DmaSpi const &) = delete;
+    DmaSpi(DmaSpi &&) = delete;
+    auto operator=(DmaSpi const &) -> DmaSpi & = delete;
+    auto operator=(DmaSpi &&) -> DmaSpi & = delete;
+    ~DmaSpi() override = default;
+
+    // Must only be called by the DMA interrupt handler
+    auto OnTransferEnd(bool transferFailed) -> void;
+
+
+private:
+    // Do not call this in the init() function of a thread. The semaphore doesn't work correctly
+    // there, making other SPIs silently fail to get initialized afterwards.
+    auto DoInitialize(std::uint32_t baudRate, bool useOpenDrainOutputs) -> void override;
+    auto Read(void * data, std::size_t nBytes, Duration timeout) -> void override;
+    auto Write(void const * data, std::size_t nBytes, Duration timeout) -> void override;
+    [[nodiscard]] auto DoTransferEnd() const -> RodosTime override;
+    [[nodiscard]] auto DoBaudRate() const -> std::int32_t override;
+
+    auto SetTransferEnd(RodosTime transferEnd) -> void;
+    // Either rxData or txData may be nullptr, in which case a dummy byte is used instead
+    [[nodiscard]] auto Transfer(void * rxData, void const * txData, std::size_t nBytes)
+        -> Result<void>;
+    [[nodiscard]] auto SuspendUntilTransferEndOr(RodosTime time) -> Result<void>;
+
+    mutable RODOS::HAL_SPI spi_;
+    RODOS::SPI_IDX spiIndex_;
+    // Written by the interrupt handler
+    bool volatile transferHasEnded_ = true;
+    bool volatile transferFailed_ = false;
+    RODOS::Thread * volatile waitingThread_ = nullptr;
+    std::uint8_t rxDummyByte_ = 0;
+    std::uint8_t txDummyByte_ = 0;
+    // This should actually be an atomic variable. Since they don't exist in Rodos, we protect it
+    // with a semaphore instead.
+    mutable RodosTime transferEnd_ = endOfTime;
+    mutable RODOS::Semaphore transferEndSemaphore_;
+};
+}
@@ -0,0 +1,91 @@
+#include <Sts1CobcSw/Hal/DmaSpiMock.hpp>
+
+#include <Sts1CobcSw/RodosTime/RodosTime.hpp>
+
+#include <strong_type/affine_point.hpp>
+#include <strong_type/difference.hpp>
+
+#include <climits>
+#include <cstring>
+
+
+namespace sts1cobcsw::hal
+{
+auto DmaSpiMock::SetLatency(std::int32_t baudRate, Duration overhead) -> void
+{
+    baudRate_ = baudRate;
+    overhead_ = overhead;
+}
+
+
+auto DmaSpiMock::SetUseDma(bool useDma) -> void
+{
+    useDma_ = useDma;
+}
+
+
+auto DmaSpiMock::NTransferredBytes() const -> std::size_t
+{
+    return nTransferredBytes_;
+}
+
+
+auto DmaSpiMock::DoInitialize(std::uint32_t baudRate,
+                              [[maybe_unused]] bool useOpenDrainOutputs) -> void
+{
+    baudRate_ = static_cast<std::int32_t>(baudRate);
+    transferEnd_ = endOfTime;
+}
+
+
+auto DmaSpiMock::Read(void * data, std::size_t nBytes, Duration timeout) -> void
+{
+    std::memset(data, 0, nBytes);
+    Transfer(nBytes, timeout);
+}
+
+
+auto DmaSpiMock::Write([[maybe_unused]] void const * data, std::size_t nBytes, Duration timeout)
+    -> void
+{
+    Transfer(nBytes, timeout);
+}
+
+
+auto DmaSpiMock::DoTransferEnd() const -> RodosTime
+{
+    return transferEnd_;
+}
+
+
+auto DmaSpiMock::DoBaudRate() const -> std::int32_t
+{
+    return baudRate_;
+}
+
+
+auto DmaSpiMock::Transfer(std::size_t nBytes, Duration timeout) -> void
+{
+    if(nBytes == 0)
+    {
+        return;
+    }
+    auto start = CurrentRodosTime();
+    transferEnd_ = start + timeout;
+    auto duration = overhead_;
+    if(baudRate_ > 0)
+    {
+        duration += static_cast<std::int64_t>(nBytes) * CHAR_BIT * s / baudRate_;
+    }
+    if(useDma_)
+    {
+        SuspendUntil(start + duration);
+    }
+    else
+    {
+        BusyWaitUntil(start + duration);
+    }
+    nTransferredBytes_ += nBytes;
+    transferEnd_ = endOfTime;
+}
+}
@@ -0,0 +1,50 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Hal/Spi.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <strong_type/type.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+
+namespace sts1cobcsw::hal
+{
+// Models the transfer latency of a real SPI to measure how much CPU time is left for other threads.
+// A transfer takes nBytes * CHAR_BIT / baudRate plus a fixed overhead, e.g., for setting up the
+// DMA. With DMA, the calling thread is suspended for that long, like with DmaSpi. Without it, the
+// CPU busy-waits, like with HardwareSpi. Read data is all zeros.
+class DmaSpiMock : public Spi
+{
+public:
+    DmaSpiMock() = default;
+    DmaSpiMock(DmaSpiMock const &) = delete;
+    DmaSpiMock(DmaSpiMock &&) = default;
+    auto operator=(DmaSpiMock const &) -> DmaSpiMock & = delete;
+    auto operator=(DmaSpiMock &&) -> DmaSpiMock & = default;
+    ~DmaSpiMock() override = default;
+
+    auto SetLatency(std::int32_t baudRate, Duration overhead) -> void;
+    auto SetUseDma(bool useDma) -> void;
+    [[nodiscard]] auto NTransferredBytes() const -> std::size_t;
+
+
+private:
+    auto DoInitialize(std::uint32_t baudRate, bool useOpenDrainOutputs) -> void override;
+    auto Read(void * data, std::size_t nBytes, Duration timeout) -> void override;
+    auto Write(void const * data, std::size_t nBytes, Duration timeout) -> void override;
+    [[nodiscard]] auto DoTransferEnd() const -> RodosTime override;
+    [[nodiscard]] auto DoBaudRate() const -> std::int32_t override;
+
+    auto Transfer(std::size_t nBytes, Duration timeout) -> void;
+
+    std::int32_t baudRate_ = 0;
+    Duration overhead_ = Duration(0);
+    bool useDma_ = true;
+    std::size_t nTransferredBytes_ = 0;
+    RodosTime transferEnd_ = endOfTime;
+};
+}
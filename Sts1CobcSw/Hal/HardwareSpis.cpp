@@ -1,4 +1,4 @@
-#include <Sts1CobcSw/Hal/HardwareSpi.hpp>
+#include <Sts1CobcSw/Hal/DmaSpi.hpp>
 #include <Sts1CobcSw/Hal/IoNames.hpp>
 #include <Sts1CobcSw/Hal/Spis.hpp>  // IWYU pragma: associated
 
@@ -7,12 +7,14 @@ namespace sts1cobcsw
 {
 namespace
 {
-auto hardwareFlashSpi = hal::HardwareSpi(
+// The DMA keeps the CPU free for other threads while FIFO bursts, flash pages and FRAM blocks are
+// transferred
+auto hardwareFlashSpi = hal::DmaSpi(
     hal::flashSpiIndex, hal::flashSpiSckPin, hal::flashSpiMisoPin, hal::flashSpiMosiPin);
-auto hardwareFramEpsSpi = hal::HardwareSpi(
+auto hardwareFramEpsSpi = hal::DmaSpi(
     hal::framEpsSpiIndex, hal::framEpsSpiSckPin, hal::framEpsSpiMisoPin, hal::framEpsSpiMosiPin);
 auto hardwareRfSpi =
-    hal::HardwareSpi(hal::rfSpiIndex, hal::rfSpiSckPin, hal::rfSpiMisoPin, hal::rfSpiMosiPin);
+    hal::DmaSpi(hal::rfSpiIndex, hal::rfSpiSckPin, hal::rfSpiMisoPin, hal::rfSpiMosiPin);
 }
 
 hal::Spi & flashSpi = hardwareFlashSpi;
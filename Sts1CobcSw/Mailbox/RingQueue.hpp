@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <rodos_no_using_namespace.h>
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sts1cobcsw
+{
+// A bounded queue for one producer and one consumer thread. Unlike a Mailbox, it can hold several
+// messages, so the producer can work ahead of the consumer. Each side can suspend until the other
+// one made room or added a message. Since the queue is never full and empty at the same time, at
+// most one thread can wait for it.
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+class RingQueue
+{
+public:
+    [[nodiscard]] auto IsEmpty() const -> bool;
+    [[nodiscard]] auto IsFull() const -> bool;
+    [[nodiscard]] auto Size() const -> std::size_t;
+    [[nodiscard]] static constexpr auto Capacity() -> std::size_t;
+
+    // Must only be called by the producer
+    [[nodiscard]] auto SuspendUntilNotFullOr(RodosTime time) -> Result<void>;
+    [[nodiscard]] auto Put(Message const & message) -> Result<void>;
+    // Put the message in front of all others so that it is the next one to get
+    [[nodiscard]] auto PutFront(Message const & message) -> Result<void>;
+    // Drop all messages that the consumer did not get yet
+    auto Clear() -> void;
+
+    // Must only be called by the consumer
+    [[nodiscard]] auto SuspendUntilNotEmptyOr(RodosTime time) -> Result<void>;
+    [[nodiscard]] auto Get() -> Result<Message>;
+    [[nodiscard]] auto Peek() const -> Result<Message>;
+
+
+private:
+    [[nodiscard]] auto UnprotectedSize() const -> std::size_t;
+    auto ResumeWaitingThread() -> void;
+
+    // The indexes run freely and wrap around. Since the capacity is a power of two, the difference
+    // is still the number of messages in the queue.
+    using Index = std::uint32_t;
+
+    std::array<Message, capacity> messages_ = {};
+    Index writeIndex_ = 0;
+    Index readIndex_ = 0;
+
+    RODOS::Thread * thread_ = nullptr;
+    mutable RODOS::Semaphore semaphore_;
+};
+}
+
+#include <Sts1CobcSw/Mailbox/RingQueue.ipp>  // IWYU pragma: keep
@@ -0,0 +1,169 @@
+#pragma once
+
+#include <Sts1CobcSw/Mailbox/RingQueue.hpp>
+
+#include <Sts1CobcSw/RodosTime/RodosTime.hpp>
+
+
+namespace sts1cobcsw
+{
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::IsEmpty() const -> bool
+{
+    return Size() == 0;
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::IsFull() const -> bool
+{
+    return Size() >= capacity;
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::Size() const -> std::size_t
+{
+    auto protector = RODOS::ScopeProtector(&semaphore_);  // NOLINT(*readability-casting)
+    return UnprotectedSize();
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+constexpr auto RingQueue<Message, capacity>::Capacity() -> std::size_t
+{
+    return capacity;
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::SuspendUntilNotFullOr(RodosTime time) -> Result<void>
+{
+    semaphore_.enter();
+    if(UnprotectedSize() < capacity)
+    {
+        semaphore_.leave();
+        return outcome_v2::success();
+    }
+    thread_ = RODOS::Thread::getCurrentThread();
+    RODOS::PRIORITY_CEILER_IN_SCOPE();
+    semaphore_.leave();
+    auto result = SuspendUntilResumedOr(time);
+    thread_ = nullptr;
+    return result;
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::Put(Message const & message) -> Result<void>
+{
+    auto protector = RODOS::ScopeProtector(&semaphore_);  // NOLINT(*readability-casting)
+    if(UnprotectedSize() >= capacity)
+    {
+        return ErrorCode::full;
+    }
+    messages_[writeIndex_ % capacity] = message;
+    ++writeIndex_;
+    ResumeWaitingThread();
+    return outcome_v2::success();
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::PutFront(Message const & message) -> Result<void>
+{
+    auto protector = RODOS::ScopeProtector(&semaphore_);  // NOLINT(*readability-casting)
+    if(UnprotectedSize() >= capacity)
+    {
+        return ErrorCode::full;
+    }
+    --readIndex_;
+    messages_[readIndex_ % capacity] = message;
+    ResumeWaitingThread();
+    return outcome_v2::success();
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::Clear() -> void
+{
+    auto protector = RODOS::ScopeProtector(&semaphore_);  // NOLINT(*readability-casting)
+    readIndex_ = writeIndex_;
+    ResumeWaitingThread();
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::SuspendUntilNotEmptyOr(RodosTime time) -> Result<void>
+{
+    semaphore_.enter();
+    if(UnprotectedSize() != 0)
+    {
+        semaphore_.leave();
+        return outcome_v2::success();
+    }
+    thread_ = RODOS::Thread::getCurrentThread();
+    RODOS::PRIORITY_CEILER_IN_SCOPE();
+    semaphore_.leave();
+    auto result = SuspendUntilResumedOr(time);
+    thread_ = nullptr;
+    return result;
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::Get() -> Result<Message>
+{
+    auto protector = RODOS::ScopeProtector(&semaphore_);  // NOLINT(*readability-casting)
+    if(UnprotectedSize() == 0)
+    {
+        return ErrorCode::empty;
+    }
+    auto const & message = messages_[readIndex_ % capacity];
+    ++readIndex_;
+    ResumeWaitingThread();
+    return message;
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::Peek() const -> Result<Message>
+{
+    auto protector = RODOS::ScopeProtector(&semaphore_);  // NOLINT(*readability-casting)
+    if(UnprotectedSize() == 0)
+    {
+        return ErrorCode::empty;
+    }
+    return messages_[readIndex_ % capacity];
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::UnprotectedSize() const -> std::size_t
+{
+    return static_cast<Index>(writeIndex_ - readIndex_);
+}
+
+
+template<typename Message, std::size_t capacity>
+    requires(std::has_single_bit(capacity))
+auto RingQueue<Message, capacity>::ResumeWaitingThread() -> void
+{
+    if(thread_ != nullptr)
+    {
+        thread_->resume();
+    }
+}
+}
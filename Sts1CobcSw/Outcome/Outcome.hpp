@@ -107,6 +107,11 @@ enum class ErrorCode : std::int8_t  // NOLINT
     programFailed,
     // RF
     receivedInvalidData,
+    synchMarkerNotFound,
+    rfIsBusy,
+    receiveCanceled,
+    // SPI
+    spiTransferFailed,
 };
 
 
@@ -186,6 +186,15 @@ constexpr auto ToCZString(ErrorCode errorCode) -> char const *
         // RF
         case ErrorCode::receivedInvalidData:
             return "receivedInvalidData";
+        case ErrorCode::synchMarkerNotFound:
+            return "synchMarkerNotFound";
+        case ErrorCode::rfIsBusy:
+            return "rfIsBusy";
+        case ErrorCode::receiveCanceled:
+            return "receiveCanceled";
+        // SPI
+        case ErrorCode::spiTransferFailed:
+            return "spiTransferFailed";
     }
     return "unknown error code";
 }
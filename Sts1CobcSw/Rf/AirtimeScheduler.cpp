@@ -0,0 +1,133 @@
+#include <Sts1CobcSw/Rf/AirtimeScheduler.hpp>
+
+#include <strong_type/ordered.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+
+namespace sts1cobcsw::rf
+{
+namespace
+{
+static_assert(minRxTimeout <= rxTimeoutForAdditionalData);
+static_assert(rxTimeoutForAdditionalData <= rxTimeoutAfterTelemetryRecord);
+static_assert(groundActivityTimeout < maxPassDuration);
+
+
+template<typename T>
+auto IncrementSaturated(T * counter) -> void;
+[[nodiscard]] auto ToSecondsSaturated(Duration duration) -> std::uint32_t;
+}
+
+
+auto AirtimeScheduler::Schedule(LinkState const & state) -> Slot
+{
+    if(state.housekeepingIsPending)
+    {
+        rxIsDueAfterHousekeeping_ = true;
+        rxIsDueAfterDownlink_ = false;
+        auto slot = Slot{.activity = Activity::sendHousekeeping};
+        Count(slot);
+        return slot;
+    }
+    auto groundIsActive = state.timeSinceLastUplink < groundActivityTimeout;
+    auto groundTalkedToUsInThisPass = state.timeSinceLastUplink < maxPassDuration;
+    auto rxDuration = state.remainingIntervalDuration - state.dataHandlingDuration;
+    auto rxIsDue = std::exchange(rxIsDueAfterHousekeeping_, false);
+    auto rxIsDueAfterDownlink = std::exchange(rxIsDueAfterDownlink_, false);
+    if(rxIsDue and rxDuration >= minRxTimeout)
+    {
+        auto slot = Slot{.activity = Activity::receive,
+                         .duration = std::min(rxDuration, rxTimeoutAfterTelemetryRecord)};
+        if(state.nQueuedCfdpFrames > 0 and groundTalkedToUsInThisPass and not groundIsActive)
+        {
+            slot.duration = minRxTimeout;
+            IncrementSaturated(&statistics_.nShortenedRxSlots);
+        }
+        Count(slot);
+        return slot;
+    }
+    if((state.uplinkIsActive or rxIsDueAfterDownlink) and rxDuration >= minRxTimeout)
+    {
+        auto rxTimeout = state.uplinkIsActive ? rxTimeoutForAdditionalData : minRxTimeout;
+        auto slot =
+            Slot{.activity = Activity::receive, .duration = std::min(rxDuration, rxTimeout)};
+        Count(slot);
+        return slot;
+    }
+    auto sendDuration =
+        std::min(state.remainingIntervalDuration, state.remainingFileTransferWindowDuration)
+        - sendWindowMargin;
+    if(groundIsActive)
+    {
+        // Leave room to receive the ACK and NAK PDUs after the frames are sent
+        sendDuration = sendDuration - minRxTimeout;
+    }
+    if(state.nQueuedCfdpFrames > 0 and sendDuration >= state.frameSendDuration)
+    {
+        rxIsDueAfterDownlink_ = groundIsActive;
+        // Only the airtime of the frames that are already queued is counted
+        auto queuedFramesDuration =
+            static_cast<std::int64_t>(state.nQueuedCfdpFrames) * state.frameSendDuration;
+        Count({.activity = Activity::sendCfdpFrames,
+               .duration = std::min(sendDuration, queuedFramesDuration)});
+        return Slot{.activity = Activity::sendCfdpFrames, .duration = sendDuration};
+    }
+    auto slot = Slot{.activity = Activity::idle, .duration = state.remainingIntervalDuration};
+    Count(slot);
+    return slot;
+}
+
+
+auto AirtimeScheduler::Statistics() const -> SchedulerStatistics
+{
+    auto statistics = statistics_;
+    statistics.rxDurationInS = ToSecondsSaturated(rxDuration_);
+    statistics.cfdpDurationInS = ToSecondsSaturated(cfdpDuration_);
+    return statistics;
+}
+
+
+auto AirtimeScheduler::Count(Slot const & slot) -> void
+{
+    switch(slot.activity)
+    {
+        case Activity::sendHousekeeping:
+            IncrementSaturated(&statistics_.nHousekeepingSlots);
+            return;
+        case Activity::receive:
+            IncrementSaturated(&statistics_.nRxSlots);
+            rxDuration_ += slot.duration;
+            return;
+        case Activity::sendCfdpFrames:
+            IncrementSaturated(&statistics_.nCfdpSlots);
+            cfdpDuration_ += slot.duration;
+            return;
+        case Activity::idle:
+            IncrementSaturated(&statistics_.nIdleSlots);
+            return;
+    }
+}
+
+
+namespace
+{
+template<typename T>
+auto IncrementSaturated(T * counter) -> void
+{
+    if(*counter < std::numeric_limits<T>::max())
+    {
+        ++(*counter);
+    }
+}
+
+
+auto ToSecondsSaturated(Duration duration) -> std::uint32_t
+{
+    return static_cast<std::uint32_t>(
+        std::min<std::int64_t>(duration / s, std::numeric_limits<std::uint32_t>::max()));
+}
+}
+}
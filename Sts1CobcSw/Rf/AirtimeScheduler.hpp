@@ -0,0 +1,86 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Vocabulary/SchedulerStatistics.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <strong_type/difference.hpp>
+#include <strong_type/type.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sts1cobcsw::rf
+{
+inline constexpr auto rxTimeoutAfterTelemetryRecord = 5 * s;
+inline constexpr auto rxTimeoutForAdditionalData = 3 * s;
+inline constexpr auto minRxTimeout = 1 * s;
+// CFDP frames are only sent until this long before the next housekeeping report is due
+inline constexpr auto sendWindowMargin = 1 * s;
+// The ground station counts as active if we received something from it within this time
+inline constexpr auto groundActivityTimeout = 60 * s;
+// Passes are shorter and the gaps between them are longer than this, so if we received something
+// within this time, it was in the current pass
+inline constexpr auto maxPassDuration = 15 * 60 * s;
+
+
+enum class Activity : std::uint8_t
+{
+    sendHousekeeping,
+    receive,
+    sendCfdpFrames,
+    idle,
+};
+
+
+// What the RF communication thread could do next
+struct LinkState
+{
+    bool housekeepingIsPending = false;
+    // The time until the next housekeeping report is due and until the file transfer window closes
+    Duration remainingIntervalDuration = Duration(0);
+    Duration remainingFileTransferWindowDuration = Duration(0);
+    Duration frameSendDuration = Duration(0);
+    // Time that must be left after an RX window to handle the received data
+    Duration dataHandlingDuration = Duration(0);
+    std::size_t nQueuedCfdpFrames = 0;
+    // The last RX window received something
+    bool uplinkIsActive = false;
+    Duration timeSinceLastUplink = Duration(0);
+};
+
+
+// For an RX window, the duration is the RX timeout. For sending CFDP frames, it is the time until
+// the send window ends.
+struct Slot
+{
+    Activity activity = Activity::idle;
+    Duration duration = Duration(0);
+};
+
+
+// Divides the time between two housekeeping reports into housekeeping, RX and CFDP slots. The
+// housekeeping report always comes first and is always followed by an RX window, since the ground
+// station can only start talking to us after it heard from us. As long as the ground station keeps
+// sending, we keep receiving. While it is active, every CFDP burst is followed by a short RX window
+// for ACK and NAK PDUs. If it already talked to us in the current pass but is not active anymore,
+// the RX window after the housekeeping report is shortened so that the time goes to the downlink
+// instead. Until it talked to us, the RX window keeps its full length so that it can reach us.
+class AirtimeScheduler
+{
+public:
+    [[nodiscard]] auto Schedule(LinkState const & state) -> Slot;
+    [[nodiscard]] auto Statistics() const -> SchedulerStatistics;
+
+
+private:
+    auto Count(Slot const & slot) -> void;
+
+    bool rxIsDueAfterHousekeeping_ = false;
+    bool rxIsDueAfterDownlink_ = false;
+    SchedulerStatistics statistics_ = {};
+    Duration rxDuration_ = Duration(0);
+    Duration cfdpDuration_ = Duration(0);
+};
+}
@@ -0,0 +1,132 @@
+#include <Sts1CobcSw/Rf/DataRateController.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+
+
+namespace sts1cobcsw::rf
+{
+namespace
+{
+static_assert(std::ranges::is_sorted(supportedDataRates));
+static_assert(maxNCorrectedErrorsPerGoodFrame < maxNCorrectedErrorsPerFrame);
+static_assert(minRssi < minRssiToStepUp);
+
+
+struct IndexBounds
+{
+    std::size_t iMin = 0;
+    std::size_t iEnd = 0;
+};
+
+
+[[nodiscard]] auto ToIndexBounds(std::uint32_t minDataRate, std::uint32_t maxDataRate)
+    -> IndexBounds;
+[[nodiscard]] auto IndexOfClosestDataRate(std::uint32_t dataRate) -> std::size_t;
+[[nodiscard]] auto IsBad(UplinkQuality const & quality) -> bool;
+[[nodiscard]] auto IsGood(UplinkQuality const & quality) -> bool;
+}
+
+
+auto DataRateIsAdaptive(std::uint32_t minDataRate, std::uint32_t maxDataRate) -> bool
+{
+    auto bounds = ToIndexBounds(minDataRate, maxDataRate);
+    return bounds.iMin < bounds.iEnd;
+}
+
+
+auto AdaptDataRate(DataRateControllerState * state,
+                   UplinkQuality const & quality,
+                   std::uint32_t minDataRate,
+                   std::uint32_t maxDataRate) -> DataRateDecision
+{
+    auto bounds = ToIndexBounds(minDataRate, maxDataRate);
+    if(bounds.iMin >= bounds.iEnd)
+    {
+        return DataRateDecision::keep;
+    }
+    auto iMin = bounds.iMin;
+    auto iMax = bounds.iEnd - 1;
+    auto iCurrent = IndexOfClosestDataRate(state->dataRate);
+    if(iCurrent < iMin or iCurrent > iMax)
+    {
+        state->dataRate = supportedDataRates[std::clamp(iCurrent, iMin, iMax)];
+        state->nGoodEvaluations = 0;
+        return DataRateDecision::clampToBounds;
+    }
+    if(quality.nGoodFrames == 0 and quality.nBadFrames == 0)
+    {
+        return DataRateDecision::keep;
+    }
+    if(IsBad(quality))
+    {
+        state->nGoodEvaluations = 0;
+        if(iCurrent == iMin)
+        {
+            return DataRateDecision::keep;
+        }
+        state->dataRate = supportedDataRates[iCurrent - 1];
+        return DataRateDecision::stepDown;
+    }
+    if(not IsGood(quality))
+    {
+        state->nGoodEvaluations = 0;
+        return DataRateDecision::keep;
+    }
+    ++state->nGoodEvaluations;
+    if(state->nGoodEvaluations < nGoodEvaluationsToStepUp or iCurrent == iMax)
+    {
+        state->nGoodEvaluations = std::min<std::uint8_t>(state->nGoodEvaluations,
+                                                         nGoodEvaluationsToStepUp);
+        return DataRateDecision::keep;
+    }
+    state->nGoodEvaluations = 0;
+    state->dataRate = supportedDataRates[iCurrent + 1];
+    return DataRateDecision::stepUp;
+}
+
+
+namespace
+{
+auto ToIndexBounds(std::uint32_t minDataRate, std::uint32_t maxDataRate) -> IndexBounds
+{
+    auto first = std::ranges::lower_bound(supportedDataRates, minDataRate);
+    auto end = std::ranges::upper_bound(supportedDataRates, maxDataRate);
+    return IndexBounds{
+        .iMin = static_cast<std::size_t>(std::distance(supportedDataRates.begin(), first)),
+        .iEnd = static_cast<std::size_t>(std::distance(supportedDataRates.begin(), end))};
+}
+
+
+// The RF driver also uses the closest supported data rate, see GetDataRateConfig()
+auto IndexOfClosestDataRate(std::uint32_t dataRate) -> std::size_t
+{
+    auto iClosest = std::size_t{0};
+    for(auto i = std::size_t{1}; i < supportedDataRates.size(); ++i)
+    {
+        if(dataRate > (supportedDataRates[i - 1] + supportedDataRates[i]) / 2)
+        {
+            iClosest = i;
+        }
+    }
+    return iClosest;
+}
+
+
+// Lost frames or many corrected errors mean that the link margin is too small
+auto IsBad(UplinkQuality const & quality) -> bool
+{
+    return quality.nBadFrames > 0
+        or quality.nCorrectedErrors > maxNCorrectedErrorsPerFrame * quality.nGoodFrames
+        or (quality.nRssiSamples > 0 and quality.meanRssi < minRssi);
+}
+
+
+auto IsGood(UplinkQuality const & quality) -> bool
+{
+    return quality.nCorrectedErrors <= maxNCorrectedErrorsPerGoodFrame * quality.nGoodFrames
+       and (quality.nRssiSamples == 0 or quality.meanRssi >= minRssiToStepUp);
+}
+}
+}
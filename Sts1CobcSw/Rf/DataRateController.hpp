@@ -0,0 +1,55 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Vocabulary/DataRateDecision.hpp>
+#include <Sts1CobcSw/Vocabulary/LinkStatistics.hpp>
+
+#include <array>
+#include <cstdint>
+
+
+namespace sts1cobcsw::rf
+{
+// Must be sorted in ascending order
+inline constexpr auto supportedDataRates = std::array<std::uint32_t, 9>{
+    1'200, 2'400, 4'800, 9'600, 19'200, 38'400, 57'600, 76'800, 115'200};
+// Number of consecutive good evaluations after which the data rate is increased
+inline constexpr auto nGoodEvaluationsToStepUp = 3U;
+// The number of corrected symbols per good frame must not exceed this to count as good, and the
+// data rate is decreased as soon as it exceeds maxNCorrectedErrorsPerFrame. In between, the data
+// rate is kept. This hysteresis prevents toggling between two data rates.
+inline constexpr auto maxNCorrectedErrorsPerGoodFrame = 2U;
+inline constexpr auto maxNCorrectedErrorsPerFrame = 8U;
+// Raw RSSI value of the RF module, see LinkStatistics. The data rate is decreased as soon as the
+// mean RSSI drops below minRssi, so the same kind of hysteresis applies.
+inline constexpr std::uint8_t minRssiToStepUp = 60;
+
+
+// Uplink statistics since the previous evaluation
+struct UplinkQuality
+{
+    std::uint16_t nGoodFrames = 0;
+    std::uint16_t nBadFrames = 0;
+    std::uint16_t nCorrectedErrors = 0;
+    std::uint16_t nRssiSamples = 0;
+    std::uint8_t meanRssi = 0;
+};
+
+
+struct DataRateControllerState
+{
+    std::uint32_t dataRate = 0;
+    std::uint8_t nGoodEvaluations = 0;
+};
+
+
+// The data rate is only adapted if [minDataRate, maxDataRate] contains a supported data rate
+[[nodiscard]] auto DataRateIsAdaptive(std::uint32_t minDataRate, std::uint32_t maxDataRate) -> bool;
+// Step the data rate up or down through the supported data rates within [minDataRate,
+// maxDataRate], based on the quality of the uplink since the last evaluation. If the data rate is
+// not adaptive, e.g., because the bounds were never set, nothing is changed.
+[[nodiscard]] auto AdaptDataRate(DataRateControllerState * state,
+                                 UplinkQuality const & quality,
+                                 std::uint32_t minDataRate,
+                                 std::uint32_t maxDataRate) -> DataRateDecision;
+}
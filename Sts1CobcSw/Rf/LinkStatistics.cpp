@@ -0,0 +1,106 @@
+#include <Sts1CobcSw/Rf/LinkStatistics.hpp>
+
+#include <algorithm>
+#include <limits>
+
+
+namespace sts1cobcsw::rf
+{
+namespace
+{
+template<typename T>
+auto IncrementSaturated(T * counter) -> void;
+template<typename T>
+auto AddSaturated(T * counter, std::size_t value) -> void;
+}
+
+
+auto LinkStatisticsCollector::Reset() -> void
+{
+    statistics_ = {};
+    rssiSum_ = 0;
+    afcOffsetSum_ = 0;
+}
+
+
+auto LinkStatisticsCollector::AddSample(std::uint8_t rssi, std::int16_t afcOffset) -> void
+{
+    // The sums cannot overflow as long as the number of samples is limited to 16 bits
+    if(statistics_.nSamples == std::numeric_limits<std::uint16_t>::max())
+    {
+        return;
+    }
+    if(statistics_.nSamples == 0)
+    {
+        statistics_.minRssi = rssi;
+        statistics_.maxRssi = rssi;
+        statistics_.minAfcOffset = afcOffset;
+        statistics_.maxAfcOffset = afcOffset;
+    }
+    statistics_.minRssi = std::min(statistics_.minRssi, rssi);
+    statistics_.maxRssi = std::max(statistics_.maxRssi, rssi);
+    statistics_.minAfcOffset = std::min(statistics_.minAfcOffset, afcOffset);
+    statistics_.maxAfcOffset = std::max(statistics_.maxAfcOffset, afcOffset);
+    rssiSum_ += rssi;
+    afcOffsetSum_ += afcOffset;
+    ++statistics_.nSamples;
+}
+
+
+auto LinkStatisticsCollector::CountRxFifoOverflow() -> void
+{
+    IncrementSaturated(&statistics_.nRxFifoOverflows);
+}
+
+
+auto LinkStatisticsCollector::CountTxFifoUnderrun() -> void
+{
+    IncrementSaturated(&statistics_.nTxFifoUnderruns);
+}
+
+
+auto LinkStatisticsCollector::AddReceivedBytes(std::size_t nBytes) -> void
+{
+    AddSaturated(&statistics_.nReceivedBytes, nBytes);
+}
+
+
+auto LinkStatisticsCollector::AddSentBytes(std::size_t nBytes) -> void
+{
+    AddSaturated(&statistics_.nSentBytes, nBytes);
+}
+
+
+auto LinkStatisticsCollector::Get() const -> LinkStatistics
+{
+    auto statistics = statistics_;
+    if(statistics.nSamples > 0)
+    {
+        statistics.meanRssi = static_cast<std::uint8_t>(rssiSum_ / statistics.nSamples);
+        statistics.meanAfcOffset = static_cast<std::int16_t>(
+            afcOffsetSum_ / static_cast<std::int32_t>(statistics.nSamples));
+    }
+    return statistics;
+}
+
+
+namespace
+{
+template<typename T>
+auto IncrementSaturated(T * counter) -> void
+{
+    if(*counter < std::numeric_limits<T>::max())
+    {
+        ++(*counter);
+    }
+}
+
+
+template<typename T>
+auto AddSaturated(T * counter, std::size_t value) -> void
+{
+    auto headroom = static_cast<std::size_t>(std::numeric_limits<T>::max() - *counter);
+    *counter += static_cast<T>(std::min(value, headroom));
+}
+}
+}
@@ -0,0 +1,32 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Vocabulary/LinkStatistics.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sts1cobcsw::rf
+{
+// Accumulates the link statistics. Only sums are stored for the means, so adding a sample is cheap.
+// All counters saturate instead of overflowing.
+class LinkStatisticsCollector
+{
+public:
+    auto Reset() -> void;
+    auto AddSample(std::uint8_t rssi, std::int16_t afcOffset) -> void;
+    auto CountRxFifoOverflow() -> void;
+    auto CountTxFifoUnderrun() -> void;
+    auto AddReceivedBytes(std::size_t nBytes) -> void;
+    auto AddSentBytes(std::size_t nBytes) -> void;
+
+    [[nodiscard]] auto Get() const -> LinkStatistics;
+
+
+private:
+    LinkStatistics statistics_ = {};
+    std::uint32_t rssiSum_ = 0;
+    std::int32_t afcOffsetSum_ = 0;
+};
+}
@@ -0,0 +1,79 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Rf/RfDataRateConfigs.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+namespace sts1cobcsw::rf
+{
+inline constexpr auto cmdSetProperty = 0x11_b;
+// Command byte, property group, number of properties, start index
+inline constexpr auto setPropertyHeaderLength = 4U;
+inline constexpr auto maxSetPropertyCommandLength = setPropertyHeaderLength + maxNProperties;
+
+
+// A complete SET_PROPERTY command, ready to be sent to the RF module
+struct SetPropertyCommand
+{
+    std::array<Byte, maxSetPropertyCommandLength> bytes = {};
+    std::uint8_t length = 0;
+
+    [[nodiscard]] constexpr auto Bytes() const -> std::span<Byte const>
+    {
+        return std::span(bytes).first(length);
+    }
+};
+
+
+// Collects property values at compile time and turns them into as few SET_PROPERTY commands as
+// possible by merging contiguous properties of the same group. If a property is set more than
+// once, the last value wins. The groups are written in the order in which they were first set.
+// Optional properties are only written if they fill a gap between two other properties and
+// thereby save a command.
+//
+// The batch stores a full image of every group, so it must never end up in RAM. All member
+// functions are therefore consteval.
+class PropertyBatch
+{
+public:
+    consteval auto Set(PropertyGroup group, Byte startIndex, std::span<Byte const> values)
+        -> void;
+    template<PropertyGroup group, Byte startIndex, std::size_t nProperties>
+    consteval auto Set(Properties<group, startIndex, nProperties> const & properties) -> void;
+    // Turn all properties that were set so far into optional ones
+    consteval auto MakeAllOptional() -> void;
+
+    [[nodiscard]] consteval auto NCommands() const -> std::size_t;
+    template<std::size_t nCommands>
+    [[nodiscard]] consteval auto ToCommands() const -> std::array<SetPropertyCommand, nCommands>;
+
+
+private:
+    static constexpr auto maxNGroups = 14U;
+    static constexpr auto nIndexes = 256U;
+
+    struct GroupImage
+    {
+        PropertyGroup group = PropertyGroup::global;
+        std::array<Byte, nIndexes> values = {};
+        std::array<bool, nIndexes> isSet = {};
+        std::array<bool, nIndexes> isRequired = {};
+    };
+
+    std::array<GroupImage, maxNGroups> groupImages_ = {};
+    std::size_t nGroups_ = 0;
+
+    // Call f(group, startIndex, values) for every SET_PROPERTY command of the batch
+    template<typename F>
+    consteval auto ForEachCommand(F f) const -> void;
+};
+}
+
+
+#include <Sts1CobcSw/Rf/PropertyBatch.ipp>  // IWYU pragma: keep
@@ -0,0 +1,118 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Rf/PropertyBatch.hpp>
+
+
+namespace sts1cobcsw::rf
+{
+consteval auto PropertyBatch::Set(PropertyGroup group,
+                                  Byte startIndex,
+                                  std::span<Byte const> values) -> void
+{
+    auto iGroup = std::size_t{0};
+    while(iGroup < nGroups_ and groupImages_[iGroup].group != group)
+    {
+        ++iGroup;
+    }
+    // Since everything is evaluated at compile time, exceeding maxNGroups or nIndexes is an
+    // out-of-bounds access and therefore a compilation error
+    if(iGroup == nGroups_)
+    {
+        groupImages_[iGroup].group = group;
+        ++nGroups_;
+    }
+    auto & image = groupImages_[iGroup];
+    auto index = static_cast<std::size_t>(startIndex);
+    for(auto value : values)
+    {
+        image.values[index] = value;
+        image.isSet[index] = true;
+        image.isRequired[index] = true;
+        ++index;
+    }
+}
+
+
+template<PropertyGroup group, Byte startIndex, std::size_t nProperties>
+consteval auto PropertyBatch::Set(Properties<group, startIndex, nProperties> const & properties)
+    -> void
+{
+    Set(group, startIndex, std::span<Byte const>(properties.GetValues()));
+}
+
+
+consteval auto PropertyBatch::MakeAllOptional() -> void
+{
+    for(auto & image : groupImages_)
+    {
+        image.isRequired = {};
+    }
+}
+
+
+consteval auto PropertyBatch::NCommands() const -> std::size_t
+{
+    auto nCommands = std::size_t{0};
+    ForEachCommand([&](auto, auto, auto) { ++nCommands; });
+    return nCommands;
+}
+
+
+template<std::size_t nCommands>
+consteval auto PropertyBatch::ToCommands() const -> std::array<SetPropertyCommand, nCommands>
+{
+    auto commands = std::array<SetPropertyCommand, nCommands>{};
+    auto iCommand = std::size_t{0};
+    ForEachCommand(
+        [&](PropertyGroup group, std::size_t startIndex, std::span<Byte const> values)
+        {
+            auto & command = commands[iCommand];
+            command.bytes[0] = cmdSetProperty;
+            command.bytes[1] = static_cast<Byte>(group);
+            command.bytes[2] = static_cast<Byte>(values.size());
+            command.bytes[3] = static_cast<Byte>(startIndex);
+            for(auto i = 0U; i < values.size(); ++i)
+            {
+                command.bytes[setPropertyHeaderLength + i] = values[i];
+            }
+            command.length = static_cast<std::uint8_t>(setPropertyHeaderLength + values.size());
+            ++iCommand;
+        });
+    return commands;
+}
+
+
+template<typename F>
+consteval auto PropertyBatch::ForEachCommand(F f) const -> void
+{
+    for(auto iGroup = std::size_t{0}; iGroup < nGroups_; ++iGroup)
+    {
+        auto const & image = groupImages_[iGroup];
+        auto index = std::size_t{0};
+        while(index < nIndexes)
+        {
+            if(not image.isRequired[index])
+            {
+                ++index;
+                continue;
+            }
+            // Extend the command as far as possible and then drop the optional properties at its
+            // end again
+            auto nProperties = std::size_t{0};
+            auto nPropertiesToWrite = std::size_t{0};
+            while(index + nProperties < nIndexes and image.isSet[index + nProperties]
+                  and nProperties < static_cast<std::size_t>(maxNProperties))
+            {
+                if(image.isRequired[index + nProperties])
+                {
+                    nPropertiesToWrite = nProperties + 1;
+                }
+                ++nProperties;
+            }
+            f(image.group, index, std::span(image.values).subspan(index, nPropertiesToWrite));
+            index += nPropertiesToWrite;
+        }
+    }
+}
+}
@@ -6,14 +6,22 @@
 
 #include <Sts1CobcSw/Rf/Rf.hpp>
 
+#include <Sts1CobcSw/Blake2s/Blake2s.hpp>
+#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
 #include <Sts1CobcSw/ChannelCoding/External/ConvolutionalCoding.hpp>
+#include <Sts1CobcSw/ChannelCoding/FrameEncoder.hpp>
+#include <Sts1CobcSw/ChannelCoding/SynchMarkerCorrelator.hpp>
 #include <Sts1CobcSw/FramSections/FramLayout.hpp>
 #include <Sts1CobcSw/FramSections/PersistentVariables.hpp>
 #include <Sts1CobcSw/Hal/GpioPin.hpp>
 #include <Sts1CobcSw/Hal/IoNames.hpp>
 #include <Sts1CobcSw/Hal/Spi.hpp>
 #include <Sts1CobcSw/Hal/Spis.hpp>
+#include <Sts1CobcSw/Rf/DataRateController.hpp>
+#include <Sts1CobcSw/Rf/LinkStatistics.hpp>
+#include <Sts1CobcSw/Rf/PropertyBatch.hpp>
 #include <Sts1CobcSw/Rf/RfDataRateConfigs.hpp>
+#include <Sts1CobcSw/Rf/TcBlockPool.hpp>
 #include <Sts1CobcSw/RodosTime/RodosTime.hpp>
 #include <Sts1CobcSw/Serial/Serial.hpp>
 #include <Sts1CobcSw/Utility/DebugPrint.hpp>  // IWYU pragma: keep
@@ -31,9 +39,13 @@
 #include <algorithm>
 #include <array>
 #include <bit>
+#include <cassert>
+#include <climits>
 #include <compare>
 #include <concepts>
 #include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <span>
 #include <type_traits>
 #include <utility>
@@ -51,7 +63,6 @@ constexpr auto endianness = std::endian::big;
 [[maybe_unused]] constexpr auto cmdPartInfo = 0x01_b;
 [[maybe_unused]] constexpr auto cmdPowerUp = 0x02_b;
 [[maybe_unused]] constexpr auto cmdFuncInfo = 0x10_b;
-[[maybe_unused]] constexpr auto cmdSetProperty = 0x11_b;
 [[maybe_unused]] constexpr auto cmdGetProperty = 0x12_b;
 [[maybe_unused]] constexpr auto cmdGpioPinCfg = 0x13_b;
 [[maybe_unused]] constexpr auto cmdFifoInfo = 0x15_b;
@@ -93,12 +104,39 @@ constexpr auto endianness = std::endian::big;
 [[maybe_unused]] constexpr auto rssiJumpInterrupt = Byte{1U << 4U};
 [[maybe_unused]] constexpr auto invalidSyncInterrupt = Byte{1U << 5U};
 
+// Chip interrupt flags
+[[maybe_unused]] constexpr auto fifoUnderflowOrOverflowInterrupt = Byte{1U << 5U};
+
+// Indexes in the answer of the GET_INT_STATUS command
+constexpr auto iModemPending = 4U;
+constexpr auto iChipPending = 6U;
+// Indexes in the answer of the GET_MODEM_STATUS command
+constexpr auto iCurrentRssi = 2U;
+constexpr auto iAfcFrequencyOffset = 6U;
+
 // TODO: Use combined RX and TX FIFO to get 128 bytes
 [[maybe_unused]] constexpr auto txFifoSize = 64U;
 [[maybe_unused]] constexpr auto rxFifoSize = 64U;
 // TODO: Choose the right thresholds
 constexpr auto txFifoThreshold = 48U;  // Free space that triggers TX FIFO almost empty interrupt
+static_assert(txFifoThreshold >= tm::FrameEncoder::minReadSize);
 constexpr auto rxFifoThreshold = 32U;  // Stored bytes trigger RX FIFO almost full interrupt
+// Back-to-back TC blocks of a burst may be offset by this many bits from where they are expected
+constexpr auto maxNSlippedBits = std::size_t{CHAR_BIT};
+// The search for the attached sync marker of the next block of a burst starts in the last two
+// stream bytes of the previous block, so slips must not reach back further than that
+constexpr auto nBurstTailBytes = 2U;
+static_assert(maxNSlippedBits <= CHAR_BIT);
+constexpr auto nSynchMarkerBits = std::size_t{attachedSynchMarkerLength} * CHAR_BIT;
+// The tail of the previous block, the sync marker with all possible slips, and at least one byte of
+// the next block
+constexpr auto burstWindowLength =
+    (nBurstTailBytes * CHAR_BIT + maxNSlippedBits + nSynchMarkerBits + CHAR_BIT - 1U) / CHAR_BIT
+    + 1U;
+// Extra time to wait for the next block of a burst on top of its nominal reception time
+constexpr auto burstBlockTimeoutMargin = 50 * ms;
+// If nothing was received for this long, the next received frame belongs to a new pass
+constexpr auto minTimeBetweenPasses = 15 * min;
 
 // TODO: Split into fifoAlmostEmptyTimeout and dataSentTimeout and use shorter timeouts for both
 constexpr auto interruptTimeout = 1 * s;
@@ -118,6 +156,18 @@ constexpr auto errorHandlingRetryDelay = 1 * ms;
 constexpr auto errorHandlingCobcResetDelay = 1 * s;
 
 constexpr auto defaultDataRateConfig = dataRateConfig9600;
+// Must have the same order as supportedDataRates, which is the only list of supported data rates
+constexpr auto dataRateConfigs = std::array{dataRateConfig1200,
+                                            dataRateConfig2400,
+                                            dataRateConfig4800,
+                                            dataRateConfig9600,
+                                            dataRateConfig19200,
+                                            dataRateConfig38400,
+                                            dataRateConfig57600,
+                                            dataRateConfig76800,
+                                            dataRateConfig115200};
+static_assert(
+    std::ranges::equal(dataRateConfigs, supportedDataRates, {}, &DataRateConfig::dataRate));
 
 auto csGpioPin = hal::GpioPin(hal::rfCsPin);
 auto nirqGpioPin = hal::GpioPin(hal::rfNirqPin);
@@ -137,11 +187,33 @@ auto isInTxMode = false;
 auto rxDataRateConfig = defaultDataRateConfig;
 auto txDataRateConfig = defaultDataRateConfig;
 auto currentDataRate = defaultDataRateConfig.dataRate;
+auto txCodingProfile = defaultCodingProfile;
+
+// Used by CancelReceive() to wake up the thread that is currently waiting for received data
+auto receivingThread = static_cast<RODOS::Thread *>(nullptr);
+auto receiveIsCanceled = false;
+auto linkStatistics = LinkStatisticsCollector{};
+auto lastLinkQualitySampleTime = RodosTime(0);
+// Only one block is received at a time, so a single hasher for the MAC is enough
+auto macHasher = blake2s::Hasher{};
 
 
+using InterruptStatus = std::array<Byte, interruptStatusAnswerLength>;
 using ModemStatus = std::array<Byte, modemStatusAnswerLength>;
 
 
+// Sums of the link quality samples of the frame that is currently received
+struct FrameLinkQuality
+{
+    std::uint32_t rssiSum = 0;
+    std::int32_t afcOffsetSum = 0;
+    std::uint16_t nSamples = 0;
+};
+
+
+auto frameLinkQuality = FrameLinkQuality{};
+
+
 // --- Private function declarations ---
 
 template<auto doFunction, typename... Args>
@@ -157,16 +229,78 @@ auto ExecuteWithRecovery(Args... args)
 [[nodiscard]] auto DoSendAndWait(std::span<Byte const> data) -> Result<void>;
 [[nodiscard]] auto DoSendAndContinue(std::span<Byte const> data) -> Result<void>;
 [[nodiscard]] auto DoSuspendUntilDataSent(Duration timeout) -> Result<void>;
-// Return the number of received bytes
-[[nodiscard]] auto DoReceive(std::span<Byte> data, Duration timeout) -> Result<std::size_t>;
+// Return the number of received bytes. If suspectByteRanges is not nullptr, it is filled with the
+// ranges of received bytes that are likely corrupted.
+[[nodiscard]] auto DoReceive(std::span<Byte> data,
+                             Duration timeout,
+                             SuspectByteRanges * suspectByteRanges) -> Result<std::size_t>;
+// Return the number of received blocks
+[[nodiscard]] auto DoReceiveBurst(TcBlockPool * pool, ReceivedTcBlocks * blocks, Duration timeout)
+    -> Result<std::size_t>;
+[[nodiscard]] auto StartReceiving() -> Result<void>;
+[[nodiscard]] auto StopReceiving() -> Result<void>;
+// Read the bytes [begin, end) of the stream from the RX FIFO as they arrive and return the index
+// after the last read byte. The suspect byte ranges are relative to the start of the stream.
+[[nodiscard]] auto ReadRxStream(std::span<Byte> stream,
+                                std::size_t begin,
+                                std::size_t end,
+                                RodosTime reactivationTime,
+                                SuspectByteRanges * suspectByteRanges) -> Result<std::size_t>;
+// Acquire a block from the pool and fill it. Return nullptr if the pool is empty or the block is
+// incomplete. The other parameters are the same as for ReadBurstBlock().
+[[nodiscard]] auto ReceiveBurstBlock(TcBlockPool * pool,
+                                     std::span<Byte const> leadingBytes,
+                                     bool leadingBytesAreSuspect,
+                                     unsigned int nSlippedBits,
+                                     RodosTime reactivationTime,
+                                     std::span<Byte, nBurstTailBytes> tail)
+    -> Result<ReceivedTcBlock *>;
+// Fill the block with the given leading bytes and read the rest of it straight from the RX FIFO. If
+// the block starts nSlippedBits into its first byte, one more byte is read and the block is
+// realigned in place. The last two stream bytes are stored in tail since the search for the next
+// sync marker starts there. Return whether the block is complete.
+[[nodiscard]] auto ReadBurstBlock(ReceivedTcBlock * block,
+                                  std::span<Byte const> leadingBytes,
+                                  bool leadingBytesAreSuspect,
+                                  unsigned int nSlippedBits,
+                                  RodosTime reactivationTime,
+                                  std::span<Byte, nBurstTailBytes> tail) -> Result<bool>;
+// Read the rest of a byte-aligned block, starting at begin, one RX FIFO threshold at a time and
+// decode and authenticate every chunk while the next one is still arriving
+[[nodiscard]] auto ReadAndDecodeBurstBlock(ReceivedTcBlock * block,
+                                           std::size_t begin,
+                                           RodosTime reactivationTime,
+                                           std::span<Byte, nBurstTailBytes> tail) -> Result<bool>;
+auto DecodeChunk(ReceivedTcBlock * block, std::size_t begin, std::size_t end) -> void;
+[[nodiscard]] auto BurstBlockTimeout() -> Duration;
+// Must be called once per RX FIFO threshold interrupt, right after the chunk [begin, end) was read
+// from the RX FIFO. Reading the FIFO first keeps the time until it is drained as short as possible.
+[[nodiscard]] auto HandleRxChunkStatus(std::size_t begin,
+                                       std::size_t end,
+                                       SuspectByteRanges * suspectByteRanges) -> Result<void>;
+auto FlagSuspectBytes(InterruptStatus const & interruptStatus,
+                      ModemStatus const & modemStatus,
+                      std::size_t begin,
+                      std::size_t end,
+                      SuspectByteRanges * suspectByteRanges) -> void;
+auto AddSuspectByteRange(std::size_t begin, std::size_t end, SuspectByteRanges * suspectByteRanges)
+    -> void;
+auto SampleLinkQuality(ModemStatus const & modemStatus) -> void;
+auto AddFrameToLinkStatistics() -> void;
 
 auto Reset() -> void;
 auto InitializeGpiosAndSpi() -> void;
 [[nodiscard]] auto ApplyPatch() -> Result<void>;
 [[nodiscard]] auto PowerUp() -> Result<void>;
+consteval auto AddConstantModemProperties(PropertyBatch * batch) -> void;
+consteval auto BuildConfiguration() -> PropertyBatch;
 [[nodiscard]] auto Configure() -> Result<void>;
-[[nodiscard]] auto SetConstantModemProperties() -> Result<void>;
 
+consteval auto BuildDataRateConfiguration(DataRateConfig const & dataRateConfig) -> PropertyBatch;
+consteval auto AllDataRateConfigurationsNeed(std::size_t nCommands) -> bool;
+template<std::size_t nCommands>
+consteval auto BuildDataRateCommandStreams()
+    -> std::array<std::array<SetPropertyCommand, nCommands>, dataRateConfigs.size()>;
 [[nodiscard]] auto GetDataRateConfig(std::uint32_t dataRate) -> DataRateConfig;
 [[nodiscard]] auto SetDataRate(DataRateConfig const & dataRateConfig) -> Result<void>;
 
@@ -176,7 +310,7 @@ auto DisableRfLatchupProtection() -> void;
 [[nodiscard]] auto SetRxFifoThreshold(Byte threshold) -> Result<void>;
 [[nodiscard]] auto SetPacketHandlerInterrupts(Byte interruptFlags) -> Result<void>;
 // auto SetModemInterrupts(Byte interruptFlags) -> void;
-auto ReadAndClearInterruptStatus() -> Result<std::array<Byte, interruptStatusAnswerLength>>;
+auto ReadAndClearInterruptStatus() -> Result<InterruptStatus>;
 [[nodiscard]] auto SuspendUntilInterrupt(RodosTime reactivationTime) -> Result<void>;
 [[nodiscard]] auto SuspendUntilInterrupt(Duration timeout) -> Result<void>;
 
@@ -212,9 +346,6 @@ template<std::size_t nProperties>
 [[nodiscard]] auto SetProperties(PropertyGroup propertyGroup,
                                  Byte propertyStartIndex,
                                  std::array<Byte, nProperties> const & properties) -> Result<void>;
-template<PropertyGroup propertyGroup, sts1cobcsw::Byte propertyStartIndex, std::size_t nProperties>
-[[nodiscard]] auto SetProperties(
-    Properties<propertyGroup, propertyStartIndex, nProperties> property) -> Result<void>;
 template<std::size_t size>
     requires(size <= maxNProperties)
 [[nodiscard]] auto GetProperties(PropertyGroup propertyGroup, Byte startIndex)
@@ -287,6 +418,19 @@ auto GetRxDataRate() -> std::uint32_t
 }
 
 
+auto SetTxCodingProfile(CodingProfile profile) -> void
+{
+    assert(IsValid(profile));
+    txCodingProfile = profile;
+}
+
+
+auto GetTxCodingProfile() -> CodingProfile
+{
+    return txCodingProfile;
+}
+
+
 auto SendAndWait(std::span<Byte const> data) -> void
 {
     ExecuteWithRecovery<DoSendAndWait>(data);
@@ -309,7 +453,39 @@ auto SuspendUntilDataSent(Duration timeout) -> void
 
 auto Receive(std::span<Byte> data, Duration timeout) -> std::size_t
 {
-    return ExecuteWithRecovery<DoReceive>(data, timeout);
+    return ExecuteWithRecovery<DoReceive>(
+        data, timeout, static_cast<SuspectByteRanges *>(nullptr));
+}
+
+
+auto Receive(std::span<Byte> data, Duration timeout, SuspectByteRanges * suspectByteRanges)
+    -> std::size_t
+{
+    return ExecuteWithRecovery<DoReceive>(data, timeout, suspectByteRanges);
+}
+
+
+auto ReceiveBurst(TcBlockPool * pool, ReceivedTcBlocks * blocks, Duration timeout) -> std::size_t
+{
+    return ExecuteWithRecovery<DoReceiveBurst>(pool, blocks, timeout);
+}
+
+
+auto GetLinkStatistics() -> LinkStatistics
+{
+    return linkStatistics.Get();
+}
+
+
+// Only a reception that is in progress can be canceled, so a late call does not affect the next one
+auto CancelReceive() -> void
+{
+    RODOS::PRIORITY_CEILER_IN_SCOPE();
+    if(receivingThread != nullptr)
+    {
+        receiveIsCanceled = true;
+        receivingThread->resume();
+    }
 }
 
 
@@ -356,13 +532,19 @@ auto ExecuteWithRecovery(Args... args)
 
 auto DoInitialize() -> Result<void>
 {
+    [[maybe_unused]] auto startTime = CurrentRodosTime();
     InitializeGpiosAndSpi();
     OUTCOME_TRY(ApplyPatch());
     OUTCOME_TRY(PowerUp());
+    [[maybe_unused]] auto configurationStartTime = CurrentRodosTime();
     OUTCOME_TRY(Configure());
-    OUTCOME_TRY(SetConstantModemProperties());
     OUTCOME_TRY(SetDataRate(txDataRateConfig));
+    currentDataRate = txDataRateConfig.dataRate;
     persistentVariables.Load<"txIsOn">() ? EnableTx() : DisableTx();
+    [[maybe_unused]] auto endTime = CurrentRodosTime();
+    DEBUG_PRINT("RF module initialized in %lld us (configuration: %lld us)\n",
+                (endTime - startTime) / us,
+                (endTime - configurationStartTime) / us);
     return outcome_v2::success();
 }
 
@@ -387,7 +569,8 @@ auto DoEnterStandbyMode() -> Result<void>
 auto DoSetTxDataLength(std::uint16_t length) -> Result<void>
 {
     static constexpr auto iPktField1Length = 0x0D_b;
-    auto encodedLength = static_cast<uint16_t>(cc::ViterbiCodec::EncodedSize(length, true));
+    auto encodedLength = static_cast<uint16_t>(
+        cc::ViterbiCodec::EncodedSize(length, true, ToCodeRate(txCodingProfile)));
     return SetProperties(
         PropertyGroup::pkt, iPktField1Length, Span(Serialize<endianness>(encodedLength)));
 }
@@ -434,27 +617,33 @@ auto DoSendAndContinue(std::span<Byte const> data) -> Result<void>
         OUTCOME_TRY(ReadAndClearInterruptStatus());
         DisableRfLatchupProtection();
     }
-    auto dataIndex = 0U;
-    static auto convolutionalCoder = cc::ViterbiCodec{};
+    // The data is convolutionally encoded on the fly, directly into a FIFO-sized buffer
+    auto frameEncoder = tm::FrameEncoder();
+    frameEncoder.StartConvolutionalCoding(data, ToCodeRate(txCodingProfile));
+    auto fifoBuffer = std::array<Byte, txFifoSize>{};
+    auto nEncodedBytes = std::size_t{0};
     auto result = [&]() -> Result<void>
     {
         OUTCOME_TRY(SetPacketHandlerInterrupts(txFifoAlmostEmptyInterrupt));
         OUTCOME_TRY(auto freeSpace, ReadFreeTxFifoSpace());
-        auto chunkSize = cc::ViterbiCodec::UnencodedSize(freeSpace, true);
-        while(dataIndex + chunkSize < static_cast<unsigned int>(data.size()))
+        nEncodedBytes = frameEncoder.Read(Span(&fifoBuffer).first(freeSpace));
+        while(not frameEncoder.IsDone())
         {
-            auto encodedChunk =
-                convolutionalCoder.Encode(data.subspan(dataIndex, chunkSize), /*flush=*/false);
-            OUTCOME_TRY(WriteToFifo(encodedChunk));
-            OUTCOME_TRY(ReadAndClearInterruptStatus());
+            OUTCOME_TRY(WriteToFifo(Span(fifoBuffer).first(nEncodedBytes)));
+            OUTCOME_TRY(auto interruptStatus, ReadAndClearInterruptStatus());
+            if((interruptStatus[iChipPending] & fifoUnderflowOrOverflowInterrupt) != 0x00_b)
+            {
+                linkStatistics.CountTxFifoUnderrun();
+            }
             if(not isInTxMode)
             {
                 OUTCOME_TRY(StartTx());
             }
-            dataIndex += chunkSize;
+            // Encode the next chunk while the current one is sent. The almost empty interrupt only
+            // fires when at least txFifoThreshold bytes are free, so we don't need to read the free
+            // space again and can refill the FIFO right after the interrupt.
+            nEncodedBytes = frameEncoder.Read(Span(&fifoBuffer).first(txFifoThreshold));
             OUTCOME_TRY(SuspendUntilInterrupt(interruptTimeout));
-            OUTCOME_TRY(freeSpace, ReadFreeTxFifoSpace());
-            chunkSize = cc::ViterbiCodec::UnencodedSize(freeSpace, true);
         }
         return outcome_v2::success();
     }();
@@ -473,12 +662,13 @@ auto DoSendAndContinue(std::span<Byte const> data) -> Result<void>
     {
         return clearInterruptsResult.error();
     }
-    auto encodedData = convolutionalCoder.Encode(data.subspan(dataIndex), /*flush=*/true);
-    OUTCOME_TRY(WriteToFifo(encodedData));
+    // The last chunk, which includes the flush bits, is already encoded
+    OUTCOME_TRY(WriteToFifo(Span(fifoBuffer).first(nEncodedBytes)));
     if(not isInTxMode)
     {
         OUTCOME_TRY(StartTx());
     }
+    linkStatistics.AddSentBytes(data.size());
     return outcome_v2::success();
 }
 
@@ -508,53 +698,247 @@ auto DoSuspendUntilDataSent(Duration timeout) -> Result<void>
 }
 
 
-// I don't care too much about the high cognitive complexity here for the same reason as in
-// DoSendAndContinue().
+auto DoReceive(std::span<Byte> data, Duration timeout, SuspectByteRanges * suspectByteRanges)
+    -> Result<std::size_t>
+{
+    if(suspectByteRanges != nullptr)
+    {
+        suspectByteRanges->clear();
+    }
+    auto result = [&]() -> Result<std::size_t>
+    {
+        OUTCOME_TRY(StartReceiving());
+        auto reactivationTime = CurrentRodosTime() + timeout;
+        OUTCOME_TRY(auto nReadBytes,
+                    ReadRxStream(data, 0, data.size(), reactivationTime, suspectByteRanges));
+        if(nReadBytes == data.size())
+        {
+            AddFrameToLinkStatistics();
+        }
+        return nReadBytes;
+    }();
+    auto stopResult = StopReceiving();
+    if(result.has_error())
+    {
+        return result.error();
+    }
+    if(stopResult.has_error())
+    {
+        return stopResult.error();
+    }
+    if(suspectByteRanges != nullptr)
+    {
+        // Bytes that were not received at all are of no interest
+        auto nReceivedBytes = static_cast<std::uint16_t>(result.value());
+        auto [first, last] = std::ranges::remove_if(
+            *suspectByteRanges, [&](auto const & range) { return range.begin >= nReceivedBytes; });
+        suspectByteRanges->erase(first, last);
+        for(auto & range : *suspectByteRanges)
+        {
+            range.end = std::min(range.end, nReceivedBytes);
+        }
+    }
+    linkStatistics.AddReceivedBytes(result.value());
+    return result.value();
+}
+
+
+// The RF module stays in RX mode the whole time since the packet length is infinite. After the
+// first block, we therefore just keep reading the bit stream and look for the attached sync marker
+// of the next block right after the end of the previous one. The burst ends as soon as no sync
+// marker follows, the next block does not arrive in time, or the queue or the pool is full.
+//
+// The first block is aligned by the sync word detection of the RF module. Only the few bytes around
+// the following sync markers go through a small window buffer; the blocks themselves are read
+// directly into their final place.
 //
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
-auto DoReceive(std::span<Byte> data, Duration timeout) -> Result<std::size_t>
+auto DoReceiveBurst(TcBlockPool * pool, ReceivedTcBlocks * blocks, Duration timeout)
+    -> Result<std::size_t>
 {
-    // NOLINTNEXTLINE(readability-function-cognitive-complexity)
-    auto result = [&]() -> Result<std::size_t>
+    auto nBlocksBefore = blocks->size();
+    auto result = [&]() -> Result<void>
     {
-        if(currentDataRate != rxDataRateConfig.dataRate)
+        if(blocks->full())
         {
-            OUTCOME_TRY(SetDataRate(rxDataRateConfig));
-            currentDataRate = rxDataRateConfig.dataRate;
+            return outcome_v2::success();
         }
-        OUTCOME_TRY(ResetFifos());
-        OUTCOME_TRY(ReadAndClearInterruptStatus());
-        OUTCOME_TRY(SetPacketHandlerInterrupts(rxFifoAlmostFullInterrupt));
-        OUTCOME_TRY(ReadAndClearInterruptStatus());
-        DisableRfLatchupProtection();
-        auto reactivationTime = CurrentRodosTime() + timeout;
-        OUTCOME_TRY(StartRx());
-        DebugPrintModemStatus();
-        auto dataIndex = 0U;
-        while(dataIndex + rxFifoThreshold < static_cast<unsigned int>(data.size()))
+        OUTCOME_TRY(StartReceiving());
+        auto window = std::array<Byte, burstWindowLength>{};
+        auto tail = std::span(window).first<nBurstTailBytes>();
+        OUTCOME_TRY(
+            auto * firstBlock,
+            ReceiveBurstBlock(pool, {}, false, 0U, CurrentRodosTime() + timeout, tail));
+        if(firstBlock == nullptr)
+        {
+            return outcome_v2::success();
+        }
+        blocks->push_back(firstBlock);
+        AddFrameToLinkStatistics();
+        auto blockEnd = std::size_t{nBurstTailBytes} * CHAR_BIT;  // In bits, relative to window
+        while(attachedSynchMarkerLength > 0 and not blocks->full())
+        {
+            auto reactivationTime = CurrentRodosTime() + BurstBlockTimeout();
+            auto searchEnd = (blockEnd + maxNSlippedBits + nSynchMarkerBits + CHAR_BIT - 1U)
+                           / CHAR_BIT;
+            auto windowEnd = searchEnd + 1U;
+            auto windowSuspectByteRanges = SuspectByteRanges{};
+            OUTCOME_TRY(auto nReadBytes,
+                        ReadRxStream(window,
+                                     nBurstTailBytes,
+                                     windowEnd,
+                                     reactivationTime,
+                                     &windowSuspectByteRanges));
+            if(nReadBytes < windowEnd)
+            {
+                break;
+            }
+            auto findResult =
+                FindSynchMarkerNear(std::span(window).first(searchEnd), blockEnd, maxNSlippedBits);
+            if(findResult.has_error())
+            {
+                break;
+            }
+            auto blockBegin = findResult.value().bitOffset + nSynchMarkerBits;
+            auto iFirstBlockByte = blockBegin / CHAR_BIT;
+            auto nSlippedBits = static_cast<unsigned int>(blockBegin % CHAR_BIT);
+            OUTCOME_TRY(auto * block,
+                        ReceiveBurstBlock(pool,
+                                          std::span(window).subspan(iFirstBlockByte,
+                                                                    windowEnd - iFirstBlockByte),
+                                          not windowSuspectByteRanges.empty(),
+                                          nSlippedBits,
+                                          reactivationTime,
+                                          tail));
+            if(block == nullptr)
+            {
+                break;
+            }
+            blocks->push_back(block);
+            AddFrameToLinkStatistics();
+            // The block ends in the last byte of the tail
+            blockEnd = nSlippedBits == 0U ? nBurstTailBytes * CHAR_BIT
+                                          : (nBurstTailBytes - 1U) * CHAR_BIT + nSlippedBits;
+        }
+        return outcome_v2::success();
+    }();
+    auto stopResult = StopReceiving();
+    if(result.has_error())
+    {
+        return result.error();
+    }
+    if(stopResult.has_error())
+    {
+        return stopResult.error();
+    }
+    auto nReceivedBlocks = blocks->size() - nBlocksBefore;
+    linkStatistics.AddReceivedBytes(nReceivedBlocks * tc::blockLength);
+    return nReceivedBlocks;
+}
+
+
+auto StartReceiving() -> Result<void>
+{
+    if(currentDataRate != rxDataRateConfig.dataRate)
+    {
+        OUTCOME_TRY(SetDataRate(rxDataRateConfig));
+        currentDataRate = rxDataRateConfig.dataRate;
+    }
+    {
+        RODOS::PRIORITY_CEILER_IN_SCOPE();
+        receiveIsCanceled = false;
+        receivingThread = RODOS::Thread::getCurrentThread();
+    }
+    frameLinkQuality = {};
+    // In case a previous reception could not restore the threshold after reading a remainder
+    OUTCOME_TRY(SetRxFifoThreshold(static_cast<Byte>(rxFifoThreshold)));
+    OUTCOME_TRY(ResetFifos());
+    OUTCOME_TRY(ReadAndClearInterruptStatus());
+    OUTCOME_TRY(SetPacketHandlerInterrupts(rxFifoAlmostFullInterrupt));
+    OUTCOME_TRY(ReadAndClearInterruptStatus());
+    DisableRfLatchupProtection();
+    OUTCOME_TRY(StartRx());
+    DebugPrintModemStatus();
+    return outcome_v2::success();
+}
+
+
+// Always try all steps so that the RF module ends up in standby mode even if one of them fails
+auto StopReceiving() -> Result<void>
+{
+    {
+        RODOS::PRIORITY_CEILER_IN_SCOPE();
+        receivingThread = nullptr;
+        receiveIsCanceled = false;
+    }
+    auto setInterruptsResult = SetPacketHandlerInterrupts(noInterrupts);
+    auto clearInterruptsResult = ReadAndClearInterruptStatus();
+    auto enterStandbyResult = DoEnterStandbyMode();
+    if(setInterruptsResult.has_error())
+    {
+        return setInterruptsResult.error();
+    }
+    if(clearInterruptsResult.has_error())
+    {
+        return clearInterruptsResult.error();
+    }
+    if(enterStandbyResult.has_error())
+    {
+        return enterStandbyResult.error();
+    }
+    return outcome_v2::success();
+}
+
+
+// I don't care too much about the high cognitive complexity here for the same reason as in
+// DoSendAndContinue().
+//
+// NOLINTNEXTLINE(readability-function-cognitive-complexity)
+auto ReadRxStream(std::span<Byte> stream,
+                  std::size_t begin,
+                  std::size_t end,
+                  RodosTime reactivationTime,
+                  SuspectByteRanges * suspectByteRanges) -> Result<std::size_t>
+{
+    auto dataIndex = begin;
+    // A whole threshold is read in the loop so that reading a stream chunk by chunk does not
+    // require changing the threshold for every chunk
+    while(dataIndex + rxFifoThreshold <= end)
+    {
+        // During a burst, the FIFO might already be filled above the threshold from before
+        OUTCOME_TRY(auto fillLevel, ReadRxFifoFillLevel());
+        if(fillLevel < rxFifoThreshold)
         {
             auto suspendUntilInterruptResult = SuspendUntilInterrupt(reactivationTime);
             DebugPrintModemStatus();
+            // A canceled reception ends like a timeout, i.e., only with the data read so far
             if(suspendUntilInterruptResult.has_error())
             {
                 return dataIndex;
             }
-            OUTCOME_TRY(ReadAndClearInterruptStatus());
-            ReadFromFifo(data.subspan(dataIndex, rxFifoThreshold));
-            dataIndex += rxFifoThreshold;
-            if(dataIndex == rxFifoThreshold)
+        }
+        ReadFromFifo(stream.subspan(dataIndex, rxFifoThreshold));
+        OUTCOME_TRY(HandleRxChunkStatus(dataIndex, dataIndex + rxFifoThreshold, suspectByteRanges));
+        dataIndex += rxFifoThreshold;
+        if(dataIndex == rxFifoThreshold)
+        {
+            if(std::ranges::all_of(stream.subspan(0, dataIndex),
+                                   [](Byte byte) { return byte == 0xFF_b; }))  // NOLINT
             {
-                if(std::ranges::all_of(data.subspan(0, dataIndex),
-                                       [](Byte byte) { return byte == 0xFF_b; }))  // NOLINT
-                {
-                    DEBUG_PRINT("Received bytes are all 0xFF\n");
-                    Reset();
-                    (void)DoInitialize();
-                    return ErrorCode::receivedInvalidData;
-                }
+                DEBUG_PRINT("Received bytes are all 0xFF\n");
+                Reset();
+                (void)DoInitialize();
+                return ErrorCode::receivedInvalidData;
             }
         }
-        auto remainingData = data.subspan(dataIndex);
+    }
+    auto remainingData = stream.subspan(dataIndex, end - dataIndex);
+    if(remainingData.empty())
+    {
+        return dataIndex;
+    }
+    auto result = [&]() -> Result<std::size_t>
+    {
         OUTCOME_TRY(SetRxFifoThreshold(static_cast<Byte>(remainingData.size())));
         OUTCOME_TRY(auto fillLevel, ReadRxFifoFillLevel());
         if(fillLevel < remainingData.size())
@@ -566,31 +950,262 @@ auto DoReceive(std::span<Byte> data, Duration timeout) -> Result<std::size_t>
             }
         }
         ReadFromFifo(remainingData);
-        OUTCOME_TRY(SetRxFifoThreshold(static_cast<Byte>(rxFifoThreshold)));
-        dataIndex += remainingData.size();
-        return dataIndex;
+        OUTCOME_TRY(HandleRxChunkStatus(dataIndex, end, suspectByteRanges));
+        return end;
     }();
-    // TODO: Refactor
-    auto setInterruptsResult = SetPacketHandlerInterrupts(noInterrupts);
-    auto clearInterruptsResult = ReadAndClearInterruptStatus();
-    auto enterStandbyResult = DoEnterStandbyMode();
+    // The threshold must be restored on every path, including timeouts and cancellations, since the
+    // next chunk or reception expects an interrupt only after a whole threshold was received
+    auto restoreThresholdResult = SetRxFifoThreshold(static_cast<Byte>(rxFifoThreshold));
     if(result.has_error())
     {
         return result.error();
     }
-    if(setInterruptsResult.has_error())
+    if(restoreThresholdResult.has_error())
     {
-        return setInterruptsResult.error();
+        return restoreThresholdResult.error();
     }
-    if(clearInterruptsResult.has_error())
+    return result.value();
+}
+
+
+auto ReceiveBurstBlock(TcBlockPool * pool,
+                       std::span<Byte const> leadingBytes,
+                       bool leadingBytesAreSuspect,
+                       unsigned int nSlippedBits,
+                       RodosTime reactivationTime,
+                       std::span<Byte, nBurstTailBytes> tail) -> Result<ReceivedTcBlock *>
+{
+    auto * block = pool->Acquire();
+    if(block == nullptr)
     {
-        return clearInterruptsResult.error();
+        DEBUG_PRINT("No free TC block buffer\n");
+        return nullptr;
     }
-    if(enterStandbyResult.has_error())
+    auto readResult = ReadBurstBlock(
+        block, leadingBytes, leadingBytesAreSuspect, nSlippedBits, reactivationTime, tail);
+    if(readResult.has_value() and readResult.value())
     {
-        return enterStandbyResult.error();
+        return block;
     }
-    return result.value();
+    pool->Release(block);
+    if(readResult.has_error())
+    {
+        return readResult.error();
+    }
+    return nullptr;
+}
+
+
+auto ReadBurstBlock(ReceivedTcBlock * block,
+                    std::span<Byte const> leadingBytes,
+                    bool leadingBytesAreSuspect,
+                    unsigned int nSlippedBits,
+                    RodosTime reactivationTime,
+                    std::span<Byte, nBurstTailBytes> tail) -> Result<bool>
+{
+    std::ranges::copy(leadingBytes, block->data.begin());
+    if(leadingBytesAreSuspect)
+    {
+        AddSuspectByteRange(0, leadingBytes.size(), &block->suspectByteRanges);
+    }
+    if(nSlippedBits == 0U)
+    {
+        return ReadAndDecodeBurstBlock(block, leadingBytes.size(), reactivationTime, tail);
+    }
+    OUTCOME_TRY(auto nReadBytes,
+                ReadRxStream(block->data,
+                             leadingBytes.size(),
+                             tc::blockLength,
+                             reactivationTime,
+                             &block->suspectByteRanges));
+    if(nReadBytes < tc::blockLength)
+    {
+        return false;
+    }
+    auto nextByte = std::array<Byte, 1>{};
+    auto nextByteSuspectByteRanges = SuspectByteRanges{};
+    OUTCOME_TRY(
+        nReadBytes,
+        ReadRxStream(nextByte, 0, nextByte.size(), reactivationTime, &nextByteSuspectByteRanges));
+    if(nReadBytes < nextByte.size())
+    {
+        return false;
+    }
+    tail[0] = block->data.back();
+    tail[1] = nextByte[0];
+    ShiftBitsLeft(block->data, nSlippedBits, nextByte[0]);
+    // After the realignment, every byte also contains bits of the stream byte after it
+    auto suspectByteRanges = block->suspectByteRanges;
+    block->suspectByteRanges.clear();
+    for(auto const & range : suspectByteRanges)
+    {
+        AddSuspectByteRange(range.begin == 0U ? 0U : range.begin - 1U,
+                            std::min<std::size_t>(range.end, tc::blockLength),
+                            &block->suspectByteRanges);
+    }
+    if(not nextByteSuspectByteRanges.empty())
+    {
+        AddSuspectByteRange(tc::blockLength - 1U, tc::blockLength, &block->suspectByteRanges);
+    }
+    return true;
+}
+
+
+auto ReadAndDecodeBurstBlock(ReceivedTcBlock * block,
+                             std::size_t begin,
+                             RodosTime reactivationTime,
+                             std::span<Byte, nBurstTailBytes> tail) -> Result<bool>
+{
+    block->decoder.Reset();
+    macHasher.Reset();
+    DecodeChunk(block, 0, begin);
+    for(auto chunkBegin = begin; chunkBegin < tc::blockLength; chunkBegin += rxFifoThreshold)
+    {
+        auto chunkEnd = std::min<std::size_t>(chunkBegin + rxFifoThreshold, tc::blockLength);
+        OUTCOME_TRY(auto nReadBytes,
+                    ReadRxStream(block->data,
+                                 chunkBegin,
+                                 chunkEnd,
+                                 reactivationTime,
+                                 &block->suspectByteRanges));
+        if(nReadBytes < chunkEnd)
+        {
+            return false;
+        }
+        // The tail must still be scrambled since the next sync marker is searched in the raw stream
+        if(chunkEnd == tc::blockLength)
+        {
+            std::ranges::copy(std::span(block->data).last<nBurstTailBytes>(), tail.begin());
+        }
+        DecodeChunk(block, chunkBegin, chunkEnd);
+    }
+    block->messageAuthenticationCode = macHasher.Finalize();
+    return true;
+}
+
+
+// Unscramble the chunk in place, add it to the syndromes, and feed the part of it that is covered
+// by the MAC to the hasher
+auto DecodeChunk(ReceivedTcBlock * block, std::size_t begin, std::size_t end) -> void
+{
+    auto chunk = std::span(block->data).subspan(begin, end - begin);
+    block->decoder.Update(chunk);
+    if(begin < nAuthenticatedTcBytes)
+    {
+        macHasher.Update(chunk.first(std::min<std::size_t>(end, nAuthenticatedTcBytes) - begin));
+    }
+}
+
+
+// The next block of a burst follows immediately, so we only wait as long as it takes to receive it
+auto BurstBlockTimeout() -> Duration
+{
+    constexpr auto nBits =
+        (std::size_t{attachedSynchMarkerLength} + tc::blockLength) * CHAR_BIT + 2 * maxNSlippedBits;
+    return static_cast<std::int64_t>(nBits) * s / rxDataRateConfig.dataRate
+         + burstBlockTimeoutMargin;
+}
+
+
+// The interrupt status must be read anyway to clear the RX FIFO almost full interrupt. Clearing it
+// only after reading the FIFO is fine because ReadRxStream() checks the fill level before it waits
+// for the next interrupt. The single modem status read per chunk serves both the suspect byte
+// detection and the link statistics.
+auto HandleRxChunkStatus(std::size_t begin, std::size_t end, SuspectByteRanges * suspectByteRanges)
+    -> Result<void>
+{
+    OUTCOME_TRY(auto interruptStatus, ReadAndClearInterruptStatus());
+    OUTCOME_TRY(auto modemStatus, ReadModemStatus());
+    FlagSuspectBytes(interruptStatus, modemStatus, begin, end, suspectByteRanges);
+    SampleLinkQuality(modemStatus);
+    return outcome_v2::success();
+}
+
+
+// Flag the received bytes [begin, end) as suspect if the RSSI was too low or jumped while they were
+// received. If the RX FIFO overflowed, some bytes were lost, so all following bytes are suspect
+// too. Overflows are counted for the link statistics even if no suspect byte ranges are requested.
+auto FlagSuspectBytes(InterruptStatus const & interruptStatus,
+                      ModemStatus const & modemStatus,
+                      std::size_t begin,
+                      std::size_t end,
+                      SuspectByteRanges * suspectByteRanges) -> void
+{
+    auto fifoOverflowed =
+        (interruptStatus[iChipPending] & fifoUnderflowOrOverflowInterrupt) != 0x00_b;
+    if(fifoOverflowed)
+    {
+        linkStatistics.CountRxFifoOverflow();
+    }
+    if(suspectByteRanges == nullptr)
+    {
+        return;
+    }
+    if(fifoOverflowed)
+    {
+        DEBUG_PRINT("RX FIFO overflow\n");
+        AddSuspectByteRange(begin, std::numeric_limits<std::uint16_t>::max(), suspectByteRanges);
+        return;
+    }
+    if((interruptStatus[iModemPending] & rssiJumpInterrupt) != 0x00_b
+       or static_cast<std::uint8_t>(modemStatus[iCurrentRssi]) < minRssi)
+    {
+        AddSuspectByteRange(begin, end, suspectByteRanges);
+    }
+}
+
+
+auto AddSuspectByteRange(std::size_t begin, std::size_t end, SuspectByteRanges * suspectByteRanges)
+    -> void
+{
+    auto range = SuspectByteRange{
+        .begin = static_cast<std::uint16_t>(begin),
+        .end = static_cast<std::uint16_t>(std::min<std::size_t>(
+            end, std::numeric_limits<std::uint16_t>::max()))};
+    if(not suspectByteRanges->empty()
+       and (suspectByteRanges->back().end >= range.begin or suspectByteRanges->full()))
+    {
+        suspectByteRanges->back().end = std::max(suspectByteRanges->back().end, range.end);
+        return;
+    }
+    suspectByteRanges->push_back(range);
+}
+
+
+// The current RSSI and the AFC frequency offset are sampled for every received chunk
+auto SampleLinkQuality(ModemStatus const & modemStatus) -> void
+{
+    if(frameLinkQuality.nSamples == std::numeric_limits<std::uint16_t>::max())
+    {
+        return;
+    }
+    auto afcFrequencyOffset = Deserialize<endianness, std::int16_t>(
+        Span(modemStatus).subspan<iAfcFrequencyOffset, sizeof(std::int16_t)>());
+    frameLinkQuality.rssiSum += static_cast<std::uint8_t>(modemStatus[iCurrentRssi]);
+    frameLinkQuality.afcOffsetSum += afcFrequencyOffset;
+    ++frameLinkQuality.nSamples;
+}
+
+
+// Each completely received frame adds the mean of its samples to the link statistics. A long gap
+// since the previous frame means that a new pass has started.
+auto AddFrameToLinkStatistics() -> void
+{
+    if(frameLinkQuality.nSamples == 0)
+    {
+        return;
+    }
+    auto now = CurrentRodosTime();
+    if(now - lastLinkQualitySampleTime > minTimeBetweenPasses)
+    {
+        linkStatistics.Reset();
+    }
+    lastLinkQualitySampleTime = now;
+    linkStatistics.AddSample(
+        static_cast<std::uint8_t>(frameLinkQuality.rssiSum / frameLinkQuality.nSamples),
+        static_cast<std::int16_t>(frameLinkQuality.afcOffsetSum
+                                  / static_cast<std::int32_t>(frameLinkQuality.nSamples)));
+    frameLinkQuality = {};
 }
 
 
@@ -744,88 +1359,120 @@ auto PowerUp() -> Result<void>
 }
 
 
+// Add modem properties that don't change for different data rates
+consteval auto AddConstantModemProperties(PropertyBatch * batch) -> void
+{
+    // Values acquired by comparing 9 WDS data rate configurations. For some properties only parts
+    // are here. The changing parts will be set per data rate.
+    //
+    // NOLINTBEGIN(*magic-numbers)
+    //
+    // MODEM_MOD_TYPE, MODEM_MAP_CONTROL, MODEM_DSM_CTRL
+    batch->Set(PropertyGroup::modem, 0x00_b, std::array{0x03_b, 0x00_b, 0x07_b});
+    // MODEM_TX_NCO_MODE, MODEM_FREQ_DEV (only LSB - other two bytes are non-constant)
+    batch->Set(PropertyGroup::modem, 0x07_b, std::array{0x8C_b, 0xBA_b, 0x80_b, 0x00_b});
+    // MODEM_TX_RAMP_DELAY, MODEM_MDM_CTRL, MODEM_IF_CONTROL, MODEM_IF_FREQ
+    batch->Set(
+        PropertyGroup::modem, 0x18_b, std::array{0x01_b, 0x00_b, 0x08_b, 0x03_b, 0x80_b, 0x00_b});
+    // MODEM_IFPKD_THRESHOLDS, MODEM_BCR_OSR (only LSB - other byte is non-constant)
+    batch->Set(PropertyGroup::modem, 0x21_b, std::array{0xE8_b, 0x00_b});
+    // MODEM_BCR_GEAR, MODEM_BCR_MISC1, MODEM_BCR_MISC0, MODEM_AFC_GEAR
+    batch->Set(PropertyGroup::modem, 0x29_b, std::array{0x02_b, 0x00_b, 0x00_b, 0x00_b});
+    // MODEM_AFC_MISC
+    batch->Set(PropertyGroup::modem, 0x32_b, std::array{0xA0_b});
+    // MODEM_AGC_CONTROL
+    batch->Set(PropertyGroup::modem, 0x35_b, std::array{0xE0_b});
+    // MODEM_AGC_WINDOW_SIZE
+    batch->Set(PropertyGroup::modem, 0x38_b, std::array{0x11_b});
+    // MODEM_FSK4_GAIN1, MODEM_FSK4_GAIN0, MODEM_FSK4_TH, MODEM_FSK4_MAP
+    batch->Set(PropertyGroup::modem, 0x3b_b, std::array{0x80_b, 0x1A_b, 0x40_b, 0x00_b, 0x00_b});
+    // MODEM_OOK_BLOPK, MODEM_OOK_CNT1, MODEM_OOK_MISC
+    batch->Set(PropertyGroup::modem, 0x41_b, std::array{0x0C_b, 0xA4_b, 0x23_b});
+    // MODEM_RAW_CONTROL
+    batch->Set(PropertyGroup::modem, 0x45_b, std::array{0x03_b});
+    // MODEM_ANT_DIV_MODE, MODEM_ANT_DIV_CONTROL, MODEM_RSSI_THRESH, MODEM_RSSI_JUMP_THRESH,
+    // MODEM_RSSI_CONTROL, MODEM_RSSI_CONTROL2, MODEM_RSSI_COMP
+    batch->Set(PropertyGroup::modem,
+               0x48_b,
+               std::array{0x01_b, 0x00_b, 0xFF_b, 0x06_b, 0x00_b, 0x18_b, 0x40_b});
+    // MODEM_RAW_SEARCH2
+    batch->Set(PropertyGroup::modem, 0x50_b, std::array{0x84_b, 0x0A_b});
+    // MODEM_ONE_SHOT_AFC
+    batch->Set(PropertyGroup::modem, 0x55_b, std::array{0x07_b});
+    // MODEM_RSSI_MUTE
+    batch->Set(PropertyGroup::modem, 0x57_b, std::array{0x00_b});
+    // MODEM_DSA_CTRL1, MODEM_DSA_CTRL2
+    batch->Set(PropertyGroup::modem, 0x5b_b, std::array{0x40_b, 0x04_b});
+    // MODEM_DSA_RSSI, MODEM_DSA_MISC
+    batch->Set(PropertyGroup::modem, 0x5e_b, std::array{0x78_b, 0x20_b});
+    // MODEM_CHFLT_RX1_CHFLT_COE
+    batch->Set(PropertyGroup::modemChflt, 0x0e_b, std::array{0x15_b});
+    // MODEM_CHFLT_RX2_CHFLT_COE
+    batch->Set(PropertyGroup::modemChflt, 0x20_b, std::array{0x15_b});
+    // NOLINTEND(*magic-numbers)
+}
+
+
+// Collect all properties that don't depend on the data rate
 // NOLINTNEXTLINE(readability-function-cognitive-complexity)
-auto Configure() -> Result<void>
+consteval auto BuildConfiguration() -> PropertyBatch
 {
-    // Configure GPIO pins, NIRQ, and SDO
-    // Weak pull-up enabled, no function (tristate)
-    static constexpr auto gpio0Config = 0x41_b;
-    // Weak pull-up enabled, no function (tristate)
-    static constexpr auto gpio1Config = 0x41_b;
-    // GPIO2 active in RX state
-    static constexpr auto gpio2Config = 0x21_b;
-    // GPIO3 active in TX state
-    static constexpr auto gpio3Config = 0x20_b;
-    // NIRQ is still used as NIRQ but enable internal pull-up
-    static constexpr auto nirqConfig = 0x67_b;
-    // SDO is still used as SDO but enable internal pull-up
-    static constexpr auto sdoConfig = 0x4B_b;
-    // GPIOs configured as outputs will have highest drive strength
-    static constexpr auto genConfig = 0x00_b;
-    OUTCOME_TRY(SendCommand(Span({cmdGpioPinCfg,
-                                  gpio0Config,
-                                  gpio1Config,
-                                  gpio2Config,
-                                  gpio3Config,
-                                  nirqConfig,
-                                  sdoConfig,
-                                  genConfig})));
+    auto batch = PropertyBatch();
 
     // Crystal oscillator frequency and clock
-    static constexpr auto iGlobalXoTune = 0x00_b;
-    static constexpr auto globalXoTune = 0x52_b;
-    static constexpr auto globalClkCfg = 0x00_b;
-    OUTCOME_TRY(
-        SetProperties(PropertyGroup::global, iGlobalXoTune, Span({globalXoTune, globalClkCfg})));
+    constexpr auto iGlobalXoTune = 0x00_b;
+    constexpr auto globalXoTune = 0x52_b;
+    constexpr auto globalClkCfg = 0x00_b;
+    batch.Set(PropertyGroup::global, iGlobalXoTune, std::array{globalXoTune, globalClkCfg});
 
     // Global config
-    static constexpr auto iGlobalConfig = 0x03_b;
+    constexpr auto iGlobalConfig = 0x03_b;
     // High performance mode, generic packet format, split FIFO mode, fast sequencer mode
-    static constexpr auto globalConfig = 0x60_b;
-    OUTCOME_TRY(SetProperties(PropertyGroup::global, iGlobalConfig, Span(globalConfig)));
+    constexpr auto globalConfig = 0x60_b;
+    batch.Set(PropertyGroup::global, iGlobalConfig, std::array{globalConfig});
 
     // Interrupt
-    static constexpr auto iIntCtlEnable = 0x00_b;
+    constexpr auto iIntCtlEnable = 0x00_b;
     // Enable all three general interrupt sources (chip, modem, packet handler)
-    static constexpr auto intCtlEnable = 0x07_b;
+    constexpr auto intCtlEnable = 0x07_b;
     // Disable all interrupts
     // TODO: We could enable the chip ready interrupt to potentially remove some hardcoded delays?
-    static constexpr auto intPhEnable = 0x00_b;
-    static constexpr auto intModemEnable = 0x00_b;
-    static constexpr auto intChipEnable = 0x00_b;
-    OUTCOME_TRY(SetProperties(PropertyGroup::intCtl,
-                              iIntCtlEnable,
-                              Span({intCtlEnable, intPhEnable, intModemEnable, intChipEnable})));
+    constexpr auto intPhEnable = 0x00_b;
+    constexpr auto intModemEnable = 0x00_b;
+    constexpr auto intChipEnable = 0x00_b;
+    batch.Set(PropertyGroup::intCtl,
+              iIntCtlEnable,
+              std::array{intCtlEnable, intPhEnable, intModemEnable, intChipEnable});
 
     // Preamble
-    static constexpr auto iPreambleTxLength = 0x00_b;
+    constexpr auto iPreambleTxLength = 0x00_b;
     // Send 0 bytes preamble
-    static constexpr auto preambleTxLength = 0x00_b;
+    constexpr auto preambleTxLength = 0x00_b;
     // Normal sync timeout, 20-bit preamble RX threshold
-    static constexpr auto preambleConfigStd1 = 0x14_b;
+    constexpr auto preambleConfigStd1 = 0x14_b;
     // No non-standard preamble pattern
-    static constexpr auto preambleConfigNstd = 0x00_b;
+    constexpr auto preambleConfigNstd = 0x00_b;
     // No extended RX preamble timeout, 0x0F nibbles timeout until detected preamble is discarded as
     // invalid
-    static constexpr auto preambleConfigStd2 = 0x0F_b;
+    constexpr auto preambleConfigStd2 = 0x0F_b;
     // RX Standard preamble, first received preamble bit is 0, unit of preamble TX length is in
     // bytes, use standard preamble 0101 pattern
-    static constexpr auto preambleConfig = 0b0001'0010_b;
+    constexpr auto preambleConfig = 0b0001'0010_b;
     // Non-standard pattern
-    static constexpr auto preamblePattern = std::array<Byte, 4>{};
-    OUTCOME_TRY(SetProperties(PropertyGroup::preamble,
-                              iPreambleTxLength,
-                              Span(FlatArray(preambleTxLength,
-                                             preambleConfigStd1,
-                                             preambleConfigNstd,
-                                             preambleConfigStd2,
-                                             preambleConfig,
-                                             preamblePattern))));
+    constexpr auto preamblePattern = std::array<Byte, 4>{};
+    batch.Set(PropertyGroup::preamble,
+              iPreambleTxLength,
+              FlatArray(preambleTxLength,
+                        preambleConfigStd1,
+                        preambleConfigNstd,
+                        preambleConfigStd2,
+                        preambleConfig,
+                        preamblePattern));
 
     // Sync word
-    static constexpr auto iSyncConfig = 0x00_b;
+    constexpr auto iSyncConfig = 0x00_b;
     // Do not transmit sync word, allow 4-bit sync word errors on receive, 4-byte sync word length
-    static constexpr auto syncConfig = 0b1100'0011_b;
+    constexpr auto syncConfig = 0b1100'0011_b;
     // Valid CCSDS TM sync word for Reed-Solomon or convolutional coding. Be careful: Send order is
     // MSB-first but little endian so the lowest bit of the highest byte is transmitted first, which
     // is different to how the CCSDS spec annotates those bit patterns!
@@ -837,55 +1484,53 @@ auto Configure() -> Result<void>
     //
     // TODO: The application note says the exact opposite: LSB first, big endian. Also, instead of
     // specifying the 4 bytes manually we should, serialize a 32-bit number.
-    static constexpr auto syncBits =
+    constexpr auto syncBits =
         std::array{0b0101'1000_b, 0b1111'0011_b, 0b0011'1111_b, 0b1011'1000_b};
-    OUTCOME_TRY(
-        SetProperties(PropertyGroup::sync, iSyncConfig, Span(FlatArray(syncConfig, syncBits))));
+    batch.Set(PropertyGroup::sync, iSyncConfig, FlatArray(syncConfig, syncBits));
 
     // CRC
-    static constexpr auto iPktCrcConfig = 0x00_b;
+    constexpr auto iPktCrcConfig = 0x00_b;
     // No CRC
-    static constexpr auto pktCrcConfig = 0x00_b;
-    OUTCOME_TRY(SetProperties(PropertyGroup::pkt, iPktCrcConfig, Span({pktCrcConfig})));
+    constexpr auto pktCrcConfig = 0x00_b;
+    batch.Set(PropertyGroup::pkt, iPktCrcConfig, std::array{pktCrcConfig});
 
     // Packet Whitening and Config
-    static constexpr auto iPktWhiteConfig = 0x05_b;
+    constexpr auto iPktWhiteConfig = 0x05_b;
     // No Whitening
-    static constexpr auto pktWhiteConfig = 0x00_b;
+    constexpr auto pktWhiteConfig = 0x00_b;
     // Don't split RX and TX field information (length, ...), enable RX packet handler, use normal
     // (2)FSK, no Manchester coding, no CRC, data transmission with MSB first.
-    static constexpr auto pktConfig1 = 0x00_b;
-    OUTCOME_TRY(
-        SetProperties(PropertyGroup::pkt, iPktWhiteConfig, Span({pktWhiteConfig, pktConfig1})));
+    constexpr auto pktConfig1 = 0x00_b;
+    batch.Set(PropertyGroup::pkt, iPktWhiteConfig, std::array{pktWhiteConfig, pktConfig1});
 
     // Packet length
-    static constexpr auto iPktLen = 0x08_b;
+    constexpr auto iPktLen = 0x08_b;
     // Infinite receive, big endian (MSB first)
-    static constexpr auto pktLen = 0x60_b;
-    static constexpr auto pktLenFieldSource = 0x00_b;
-    static constexpr auto pktLenAdjust = 0x00_b;
-    static constexpr auto pktTxThreshold = static_cast<Byte>(txFifoThreshold);
-    static constexpr auto pktRxThreshold = static_cast<Byte>(rxFifoThreshold);
-    static constexpr auto pktField1Length = std::array{0x00_b, 0x01_b};
-    static constexpr auto pktField1Config = 0x00_b;
-    static constexpr auto pktField1CrcConfig = 0x00_b;
-    OUTCOME_TRY(SetProperties(PropertyGroup::pkt,
-                              iPktLen,
-                              Span(FlatArray(pktLen,
-                                             pktLenFieldSource,
-                                             pktLenAdjust,
-                                             pktTxThreshold,
-                                             pktRxThreshold,
-                                             pktField1Length,
-                                             pktField1Config,
-                                             pktField1CrcConfig))));
-
-    OUTCOME_TRY(SetConstantModemProperties());
+    constexpr auto pktLen = 0x60_b;
+    constexpr auto pktLenFieldSource = 0x00_b;
+    constexpr auto pktLenAdjust = 0x00_b;
+    constexpr auto pktTxThreshold = static_cast<Byte>(txFifoThreshold);
+    constexpr auto pktRxThreshold = static_cast<Byte>(rxFifoThreshold);
+    constexpr auto pktField1Length = std::array{0x00_b, 0x01_b};
+    constexpr auto pktField1Config = 0x00_b;
+    constexpr auto pktField1CrcConfig = 0x00_b;
+    batch.Set(PropertyGroup::pkt,
+              iPktLen,
+              FlatArray(pktLen,
+                        pktLenFieldSource,
+                        pktLenAdjust,
+                        pktTxThreshold,
+                        pktRxThreshold,
+                        pktField1Length,
+                        pktField1Config,
+                        pktField1CrcConfig));
+
+    AddConstantModemProperties(&batch);
 
     // RX filter coefficients
     // Block 1
-    static constexpr auto iRxFilterCoefficientsBlock1 = 0x00_b;
-    static constexpr auto rxFilterCoefficientsBlock1 = std::array{
+    constexpr auto iRxFilterCoefficientsBlock1 = 0x00_b;
+    constexpr auto rxFilterCoefficientsBlock1 = std::array{
         0xFF_b,  // RX1_CHFLT_COE13[7:0]
         0xC4_b,  // RX1_CHFLT_COE12[7:0]
         0x30_b,  // RX1_CHFLT_COE11[7:0]
@@ -899,12 +1544,11 @@ auto Configure() -> Result<void>
         0x16_b,  // RX1_CHFLT_COE3[7:0]
         0x0C_b   // RX1_CHFLT_COE2[7:0]
     };
-    OUTCOME_TRY(SetProperties(
-        PropertyGroup::modemChflt, iRxFilterCoefficientsBlock1, Span(rxFilterCoefficientsBlock1)));
+    batch.Set(PropertyGroup::modemChflt, iRxFilterCoefficientsBlock1, rxFilterCoefficientsBlock1);
 
     // Block 2
-    static constexpr auto iRxFilterCoefficientsBlock2 = 0x0C_b;
-    static constexpr auto rxFilterCoefficientsBlock2 = std::array{
+    constexpr auto iRxFilterCoefficientsBlock2 = 0x0C_b;
+    constexpr auto rxFilterCoefficientsBlock2 = std::array{
         0x03_b,  // RX1_CHFLT_COE1[7:0]
         0x00_b,  // RX1_CHFLT_COE0[7:0]
         0x15_b,  // RX1_CHFLT_COE10[9:8]  | RX1_CHFLT_COE11[9:8]  | RX1_CHFLT_COE12[9:8]  |
@@ -921,12 +1565,11 @@ auto Configure() -> Result<void>
         0xF5_b,  // RX2_CHFLT_COE9[7:0]
         0xB5_b   // RX2_CHFLT_COE8[7:0]
     };
-    OUTCOME_TRY(SetProperties(
-        PropertyGroup::modemChflt, iRxFilterCoefficientsBlock2, Span(rxFilterCoefficientsBlock2)));
+    batch.Set(PropertyGroup::modemChflt, iRxFilterCoefficientsBlock2, rxFilterCoefficientsBlock2);
 
     // Block 3
-    static constexpr auto iRxFilterCoefficientsBlock3 = 0x18_b;
-    static constexpr auto rxFilterCoefficientsBlock3 = std::array{
+    constexpr auto iRxFilterCoefficientsBlock3 = 0x18_b;
+    constexpr auto rxFilterCoefficientsBlock3 = std::array{
         0xB8_b,  // RX2_CHFLT_COE7[7:0]
         0xDE_b,  // RX2_CHFLT_COE6[7:0]
         0x05_b,  // RX2_CHFLT_COE5[7:0]
@@ -943,230 +1586,239 @@ auto Configure() -> Result<void>
                  // RX2_CHFLT_COE5[9:8]
         0x00_b   // 0 | 0 | 0 | 0         | RX2_CHFLT_COE0[9:8]   | RX2_CHFLT_COE1[9:8]  |
     };
-    OUTCOME_TRY(SetProperties(
-        PropertyGroup::modemChflt, iRxFilterCoefficientsBlock3, Span(rxFilterCoefficientsBlock3)));
+    batch.Set(PropertyGroup::modemChflt, iRxFilterCoefficientsBlock3, rxFilterCoefficientsBlock3);
 
     // RF PA mode
-    static constexpr auto iPaMode = 0x00_b;
+    constexpr auto iPaMode = 0x00_b;
     // PA switching amp mode, PA_SEL = HP_COARSE, disable power sequencing, disable external TX ramp
     // signal
-    static constexpr auto paMode = 0x08_b;
+    constexpr auto paMode = 0x08_b;
     // Enabled PA fingers (sets output power but not linearly; 10 µA bias current per enabled
     // finger, complementary drive signal with 50 % duty cycle)
-    static constexpr auto paPwrLvl = 0x2f_b;
-    static constexpr auto paBiasClkduty = 0x00_b;
+    constexpr auto paPwrLvl = 0x2f_b;
+    constexpr auto paBiasClkduty = 0x00_b;
     // Ramping time constant = 0x1F (~56 µs to full - 0.5 dB), FSK modulation delay 30 µs
-    static constexpr auto paTc = 0xFF_b;
-    OUTCOME_TRY(
-        SetProperties(PropertyGroup::pa, iPaMode, Span({paMode, paPwrLvl, paBiasClkduty, paTc})));
+    constexpr auto paTc = 0xFF_b;
+    batch.Set(PropertyGroup::pa, iPaMode, std::array{paMode, paPwrLvl, paBiasClkduty, paTc});
 
     // RF synth feed forward charge pump current, integrated charge pump current, VCO gain scaling
     // factor, FF loop filter values
-    static constexpr auto iSynthPfdcpCpff = 0x00_b;
+    constexpr auto iSynthPfdcpCpff = 0x00_b;
     // FF charge pump current = 60 µA
-    static constexpr auto synthPfdcpCpff = 0x2C_b;
+    constexpr auto synthPfdcpCpff = 0x2C_b;
     // SYNTH_PFDCP_CPINT: Int charge pump current = 30 µA
-    static constexpr auto synthPfdcpCpint = 0x0E_b;
+    constexpr auto synthPfdcpCpint = 0x0E_b;
     // SYNTH_VCO_KV: set VCO scaling factor to maximum value, set tuning varactor gain to maximum
     // value
-    static constexpr auto synthVcoKv = 0x0B_b;
+    constexpr auto synthVcoKv = 0x0B_b;
     // SYNTH_LPFILT3: R2 value 90 kOhm
-    static constexpr auto synthLpfilt3 = 0x04_b;
+    constexpr auto synthLpfilt3 = 0x04_b;
     // SYNTH_LPFILT2: C2 value 11.25 pF
-    static constexpr auto synthLpfilt2 = 0x0C_b;
+    constexpr auto synthLpfilt2 = 0x0C_b;
     // SYNTH_LPFILT1: C3 value 12 pF, C1 offset 0 pF, C1 value 7.21 pF
-    static constexpr auto synthLpfilt1 = 0x73_b;
+    constexpr auto synthLpfilt1 = 0x73_b;
     // SYNTH_LPFILT0: FF amp bias current 100 µA
-    static constexpr auto synthLpfilt0 = 0x03_b;
-    OUTCOME_TRY(SetProperties(PropertyGroup::synth,
-                              iSynthPfdcpCpff,
-                              Span({synthPfdcpCpff,
-                                    synthPfdcpCpint,
-                                    synthVcoKv,
-                                    synthLpfilt3,
-                                    synthLpfilt2,
-                                    synthLpfilt1,
-                                    synthLpfilt0})));
+    constexpr auto synthLpfilt0 = 0x03_b;
+    batch.Set(PropertyGroup::synth,
+              iSynthPfdcpCpff,
+              std::array{synthPfdcpCpff,
+                         synthPfdcpCpint,
+                         synthVcoKv,
+                         synthLpfilt3,
+                         synthLpfilt2,
+                         synthLpfilt1,
+                         synthLpfilt0});
 
     // RF match mask
-    static constexpr auto iMatchValue1 = 0x00_b;
-    static constexpr auto matchValue1 = 0x00_b;
-    static constexpr auto matchMask1 = 0x00_b;
-    static constexpr auto matchCtrl1 = 0x00_b;
-    static constexpr auto matchValue2 = 0x00_b;
-    static constexpr auto matchMask2 = 0x00_b;
-    static constexpr auto matchCtrl2 = 0x00_b;
-    static constexpr auto matchValue3 = 0x00_b;
-    static constexpr auto matchMask3 = 0x00_b;
-    static constexpr auto matchCtrl3 = 0x00_b;
-    static constexpr auto matchValue4 = 0x00_b;
-    static constexpr auto matchMask4 = 0x00_b;
-    static constexpr auto matchCtrl4 = 0x00_b;
-    OUTCOME_TRY(SetProperties(PropertyGroup::match,
-                              iMatchValue1,
-                              Span({matchValue1,
-                                    matchMask1,
-                                    matchCtrl1,
-                                    matchValue2,
-                                    matchMask2,
-                                    matchCtrl2,
-                                    matchValue3,
-                                    matchMask3,
-                                    matchCtrl3,
-                                    matchValue4,
-                                    matchMask4,
-                                    matchCtrl4})));
+    constexpr auto iMatchValue1 = 0x00_b;
+    constexpr auto matchValue1 = 0x00_b;
+    constexpr auto matchMask1 = 0x00_b;
+    constexpr auto matchCtrl1 = 0x00_b;
+    constexpr auto matchValue2 = 0x00_b;
+    constexpr auto matchMask2 = 0x00_b;
+    constexpr auto matchCtrl2 = 0x00_b;
+    constexpr auto matchValue3 = 0x00_b;
+    constexpr auto matchMask3 = 0x00_b;
+    constexpr auto matchCtrl3 = 0x00_b;
+    constexpr auto matchValue4 = 0x00_b;
+    constexpr auto matchMask4 = 0x00_b;
+    constexpr auto matchCtrl4 = 0x00_b;
+    batch.Set(PropertyGroup::match,
+              iMatchValue1,
+              std::array{matchValue1,
+                         matchMask1,
+                         matchCtrl1,
+                         matchValue2,
+                         matchMask2,
+                         matchCtrl2,
+                         matchValue3,
+                         matchMask3,
+                         matchCtrl3,
+                         matchValue4,
+                         matchMask4,
+                         matchCtrl4});
 
     // Frequency control
-    static constexpr auto iFreqControlInte = 0x00_b;
+    constexpr auto iFreqControlInte = 0x00_b;
     // FC_inte 0x41 = 533.5, 0x41 = 434.5, 0x42 = 437.395
-    static constexpr auto freqControlInte = 0x42_b;
+    constexpr auto freqControlInte = 0x42_b;
     // FC_frac. 0xD89D9 = 433.5, 0xEC4EC = 434.5, 0xA5512 = 437.395, N_presc = 2, outdiv = 8, F_xo =
     // 26 MHz, RF_channel_Hz = (FC_inte + FC_frac / 2^19) * ((N_presc * F_xo) / outdiv)
-    static constexpr auto freqControlFrac = std::array{0x0A_b, 0x55_b, 0x12_b};
+    constexpr auto freqControlFrac = std::array{0x0A_b, 0x55_b, 0x12_b};
     // Channel step size = 0x4EC5
-    static constexpr auto freqControlChannelStepSize = std::array{0x4E_b, 0xC5_b};
+    constexpr auto freqControlChannelStepSize = std::array{0x4E_b, 0xC5_b};
     // Window gating period (in number of crystal clock cycles) = 32
-    static constexpr auto freqControlWSize = 0x20_b;
+    constexpr auto freqControlWSize = 0x20_b;
     // Adjust target mode for VCO calibration in RX mode = 0xFE int8_t
-    static constexpr auto freqControlVcontRxAdj = 0xFE_b;
-    OUTCOME_TRY(SetProperties(PropertyGroup::freqControl,
-                              iFreqControlInte,
-                              Span(FlatArray(freqControlInte,
-                                             freqControlFrac,
-                                             freqControlChannelStepSize,
-                                             freqControlWSize,
-                                             freqControlVcontRxAdj))));
+    constexpr auto freqControlVcontRxAdj = 0xFE_b;
+    batch.Set(PropertyGroup::freqControl,
+              iFreqControlInte,
+              FlatArray(freqControlInte,
+                        freqControlFrac,
+                        freqControlChannelStepSize,
+                        freqControlWSize,
+                        freqControlVcontRxAdj));
 
     // Frequency adjust (stolen from Arduino demo code)
-    // static constexpr auto globalXoTuneUpdated = 0x62_b;
-    // SetProperties(PropertyGroup::global, iGlobalXoTune, Span({globalXoTuneUpdated}));
+    // constexpr auto globalXoTuneUpdated = 0x62_b;
+    // batch.Set(PropertyGroup::global, iGlobalXoTune, std::array{globalXoTuneUpdated});
 
     // Change sequencer mode to guaranteed
     //
     // TODO: Why?
     //
     // Split FIFO and guaranteed sequencer mode
-    // static constexpr auto newGlobalConfig = 0x40_b;
-    // SetProperties(PropertyGroup::global, iGlobalConfig, Span({newGlobalConfig}));
+    // constexpr auto newGlobalConfig = 0x40_b;
+    // batch.Set(PropertyGroup::global, iGlobalConfig, std::array{newGlobalConfig});
+    return batch;
+}
+
+
+auto Configure() -> Result<void>
+{
+    // Configure GPIO pins, NIRQ, and SDO
+    // Weak pull-up enabled, no function (tristate)
+    static constexpr auto gpio0Config = 0x41_b;
+    // Weak pull-up enabled, no function (tristate)
+    static constexpr auto gpio1Config = 0x41_b;
+    // GPIO2 active in RX state
+    static constexpr auto gpio2Config = 0x21_b;
+    // GPIO3 active in TX state
+    static constexpr auto gpio3Config = 0x20_b;
+    // NIRQ is still used as NIRQ but enable internal pull-up
+    static constexpr auto nirqConfig = 0x67_b;
+    // SDO is still used as SDO but enable internal pull-up
+    static constexpr auto sdoConfig = 0x4B_b;
+    // GPIOs configured as outputs will have highest drive strength
+    static constexpr auto genConfig = 0x00_b;
+    OUTCOME_TRY(SendCommand(Span({cmdGpioPinCfg,
+                                  gpio0Config,
+                                  gpio1Config,
+                                  gpio2Config,
+                                  gpio3Config,
+                                  nirqConfig,
+                                  sdoConfig,
+                                  genConfig})));
+
+    // The properties are merged into as few SET_PROPERTY commands as possible at compile time
+    static constexpr auto configurationCommands =
+        BuildConfiguration().ToCommands<BuildConfiguration().NCommands()>();
+    for(auto const & command : configurationCommands)
+    {
+        OUTCOME_TRY(SendCommand(command.Bytes()));
+    }
     return outcome_v2::success();
 }
 
 
-// Set modem properties that don't change for different data rates
-// NOLINTNEXTLINE(*cognitive-complexity)
-auto SetConstantModemProperties() -> Result<void>
+// Collect all properties that depend on the data rate. The constant modem properties are only used
+// to fill the gaps between them if that saves commands.
+consteval auto BuildDataRateConfiguration(DataRateConfig const & dataRateConfig) -> PropertyBatch
 {
-    // Values acquired by comparing 9 WDS data rate configurations. For some properties only parts
-    // are here. The changing parts will be set per data rate.
-    //
-    // NOLINTBEGIN(*magic-numbers)
-    //
-    // MODEM_MOD_TYPE, MODEM_MAP_CONTROL, MODEM_DSM_CTRL
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x00_b, std::array{0x03_b, 0x00_b, 0x07_b}));
-    // MODEM_TX_NCO_MODE, MODEM_FREQ_DEV (only LSB - other two bytes are non-constant)
-    OUTCOME_TRY(
-        SetProperties(PropertyGroup::modem, 0x07_b, std::array{0x8C_b, 0xBA_b, 0x80_b, 0x00_b}));
-    // MODEM_TX_RAMP_DELAY, MODEM_MDM_CTRL, MODEM_IF_CONTROL, MODEM_IF_FREQ
-    OUTCOME_TRY(SetProperties(
-        PropertyGroup::modem, 0x18_b, std::array{0x01_b, 0x00_b, 0x08_b, 0x03_b, 0x80_b, 0x00_b}));
-    // MODEM_IFPKD_THRESHOLDS, MODEM_BCR_OSR (only LSB - other byte is non-constant)
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x21_b, std::array{0xE8_b, 0x00_b}));
-    // MODEM_BCR_GEAR, MODEM_BCR_MISC1, MODEM_BCR_MISC0, MODEM_AFC_GEAR
-    OUTCOME_TRY(
-        SetProperties(PropertyGroup::modem, 0x29_b, std::array{0x02_b, 0x00_b, 0x00_b, 0x00_b}));
-    // MODEM_AFC_MISC
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x32_b, std::array{0xA0_b}));
-    // MODEM_AGC_CONTROL
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x35_b, std::array{0xE0_b}));
-    // MODEM_AGC_WINDOW_SIZE
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x38_b, std::array{0x11_b}));
-    // MODEM_FSK4_GAIN1, MODEM_FSK4_GAIN0, MODEM_FSK4_TH, MODEM_FSK4_MAP
-    OUTCOME_TRY(SetProperties(
-        PropertyGroup::modem, 0x3b_b, std::array{0x80_b, 0x1A_b, 0x40_b, 0x00_b, 0x00_b}));
-    // MODEM_OOK_BLOPK, MODEM_OOK_CNT1, MODEM_OOK_MISC
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x41_b, std::array{0x0C_b, 0xA4_b, 0x23_b}));
-    // MODEM_RAW_CONTROL
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x45_b, std::array{0x03_b}));
-    // MODEM_ANT_DIV_MODE, MODEM_ANT_DIV_CONTROL, MODEM_RSSI_THRESH, MODEM_RSSI_JUMP_THRESH,
-    // MODEM_RSSI_CONTROL, MODEM_RSSI_CONTROL2, MODEM_RSSI_COMP
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem,
-                              0x48_b,
-                              std::array{0x01_b, 0x00_b, 0xFF_b, 0x06_b, 0x00_b, 0x18_b, 0x40_b}));
-    // MODEM_RAW_SEARCH2
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x50_b, std::array{0x84_b, 0x0A_b}));
-    // MODEM_ONE_SHOT_AFC
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x55_b, std::array{0x07_b}));
-    // MODEM_RSSI_MUTE
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x57_b, std::array{0x00_b}));
-    // MODEM_DSA_CTRL1, MODEM_DSA_CTRL2
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x5b_b, std::array{0x40_b, 0x04_b}));
-    // MODEM_DSA_RSSI, MODEM_DSA_MISC
-    OUTCOME_TRY(SetProperties(PropertyGroup::modem, 0x5e_b, std::array{0x78_b, 0x20_b}));
-    // MODEM_CHFLT_RX1_CHFLT_COE
-    OUTCOME_TRY(SetProperties(PropertyGroup::modemChflt, 0x0e_b, std::array{0x15_b}));
-    // MODEM_CHFLT_RX2_CHFLT_COE
-    return SetProperties(PropertyGroup::modemChflt, 0x20_b, std::array{0x15_b});
-    // NOLINTEND(*magic-numbers)
+    auto batch = PropertyBatch();
+    AddConstantModemProperties(&batch);
+    batch.MakeAllOptional();
+    batch.Set(dataRateConfig.MODEM_DATA_RATE);
+    batch.Set(dataRateConfig.MODEM_FREQ_DEV);
+    batch.Set(dataRateConfig.MODEM_DECIMATION_CFG1);
+    batch.Set(dataRateConfig.MODEM_BCR_OSR);
+    batch.Set(dataRateConfig.MODEM_AFC_WAIT);
+    batch.Set(dataRateConfig.MODEM_AGC_RFPD_DECAY);
+    batch.Set(dataRateConfig.MODEM_OOK_PDTC);
+    batch.Set(dataRateConfig.MODEM_RAW_EYE);
+    batch.Set(dataRateConfig.MODEM_SPIKE_DET);
+    batch.Set(dataRateConfig.MODEM_DSA_QUAL);
+    batch.Set(dataRateConfig.MODEM_CHFLT_RX1_CHFLT_COE);
+    batch.Set(dataRateConfig.MODEM_CHFLT_RX1_CHFLT_COE_2);
+    batch.Set(dataRateConfig.MODEM_CHFLT_RX2_CHFLT_COE);
+    batch.Set(dataRateConfig.PREAMBLE_TX_LENGTH);
+    return batch;
 }
 
 
-auto GetDataRateConfig(std::uint32_t dataRate) -> DataRateConfig
+consteval auto AllDataRateConfigurationsNeed(std::size_t nCommands) -> bool
 {
-    if(dataRate > ((dataRateConfig115200.dataRate + dataRateConfig76800.dataRate) / 2))
-    {
-        return dataRateConfig115200;
-    }
-    if(dataRate > ((dataRateConfig76800.dataRate + dataRateConfig57600.dataRate) / 2))
-    {
-        return dataRateConfig76800;
-    }
-    if(dataRate > ((dataRateConfig57600.dataRate + dataRateConfig38400.dataRate) / 2))
-    {
-        return dataRateConfig57600;
-    }
-    if(dataRate > ((dataRateConfig38400.dataRate + dataRateConfig19200.dataRate) / 2))
-    {
-        return dataRateConfig38400;
-    }
-    if(dataRate > ((dataRateConfig19200.dataRate + dataRateConfig9600.dataRate) / 2))
+    for(auto const & dataRateConfig : dataRateConfigs)
     {
-        return dataRateConfig19200;
-    }
-    if(dataRate > ((dataRateConfig9600.dataRate + dataRateConfig4800.dataRate) / 2))
-    {
-        return dataRateConfig9600;
+        if(BuildDataRateConfiguration(dataRateConfig).NCommands() != nCommands)
+        {
+            return false;
+        }
     }
-    if(dataRate > ((dataRateConfig4800.dataRate + dataRateConfig2400.dataRate) / 2))
+    return true;
+}
+
+
+template<std::size_t nCommands>
+consteval auto BuildDataRateCommandStreams()
+    -> std::array<std::array<SetPropertyCommand, nCommands>, dataRateConfigs.size()>
+{
+    auto commandStreams =
+        std::array<std::array<SetPropertyCommand, nCommands>, dataRateConfigs.size()>{};
+    for(auto i = 0U; i < dataRateConfigs.size(); ++i)
     {
-        return dataRateConfig4800;
+        commandStreams[i] = BuildDataRateConfiguration(dataRateConfigs[i]).ToCommands<nCommands>();
     }
-    if(dataRate > ((dataRateConfig2400.dataRate + dataRateConfig1200.dataRate) / 2))
+    return commandStreams;
+}
+
+
+// Returns the configuration of the supported data rate that is closest to the given one
+auto GetDataRateConfig(std::uint32_t dataRate) -> DataRateConfig
+{
+    auto iClosest = std::size_t{0};
+    for(auto i = std::size_t{1}; i < dataRateConfigs.size(); ++i)
     {
-        return dataRateConfig2400;
+        if(dataRate > (dataRateConfigs[i - 1].dataRate + dataRateConfigs[i].dataRate) / 2)
+        {
+            iClosest = i;
+        }
     }
-    return dataRateConfig1200;
+    return dataRateConfigs[iClosest];
 }
 
 
-// Properties for RX & TX are the same for a given DataRate
-// NOLINTNEXTLINE(*cognitive-complexity)
+// Properties for RX & TX are the same for a given DataRate. Since changing the data rate is part of
+// every switch between RX and TX, the commands for all data rates are computed at compile time.
 auto SetDataRate(DataRateConfig const & dataRateConfig) -> Result<void>
 {
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_DATA_RATE));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_FREQ_DEV));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_DECIMATION_CFG1));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_BCR_OSR));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_AFC_WAIT));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_AGC_RFPD_DECAY));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_OOK_PDTC));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_RAW_EYE));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_SPIKE_DET));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_DSA_QUAL));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_CHFLT_RX1_CHFLT_COE));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_CHFLT_RX1_CHFLT_COE_2));
-    OUTCOME_TRY(SetProperties(dataRateConfig.MODEM_CHFLT_RX2_CHFLT_COE));
-    return SetProperties(dataRateConfig.PREAMBLE_TX_LENGTH);
+    static constexpr auto nCommands = BuildDataRateConfiguration(dataRateConfigs[0]).NCommands();
+    // All configurations set the same properties, so they must need the same number of commands.
+    // Otherwise, some streams would be cut off or padded with empty commands.
+    static_assert(AllDataRateConfigurationsNeed(nCommands));
+    static constexpr auto commandStreams = BuildDataRateCommandStreams<nCommands>();
+    auto iDataRate = static_cast<std::size_t>(
+        std::ranges::find(dataRateConfigs, dataRateConfig.dataRate, &DataRateConfig::dataRate)
+        - dataRateConfigs.begin());
+    if(iDataRate == dataRateConfigs.size())
+    {
+        return ErrorCode::invalidParameter;
+    }
+    for(auto const & command : commandStreams[iDataRate])
+    {
+        OUTCOME_TRY(SendCommand(command.Bytes()));
+    }
+    return outcome_v2::success();
 }
 
 
@@ -1215,14 +1867,15 @@ auto SetPacketHandlerInterrupts(Byte interruptFlags) -> Result<void>
 // }
 
 
-auto ReadAndClearInterruptStatus() -> Result<std::array<Byte, interruptStatusAnswerLength>>
+auto ReadAndClearInterruptStatus() -> Result<InterruptStatus>
 {
     return SendCommand<interruptStatusAnswerLength>(
         Span({cmdGetIntStatus, 0x00_b, 0x00_b, 0x00_b}));
 }
 
 
-// Do not return until the NIRQ pin is set or the reactivationTime is reached
+// Do not return until the NIRQ pin is set, the reactivationTime is reached, or the reception is
+// canceled
 auto SuspendUntilInterrupt(RodosTime reactivationTime) -> Result<void>
 {
     nirqGpioPin.EnableInterrupts();
@@ -1231,6 +1884,11 @@ auto SuspendUntilInterrupt(RodosTime reactivationTime) -> Result<void>
     {
         while(nirqGpioPin.Read() == hal::PinState::set)
         {
+            // CancelReceive() resumes this thread, which must not simply suspend again
+            if(receiveIsCanceled)
+            {
+                return ErrorCode::receiveCanceled;
+            }
             OUTCOME_TRY(nirqGpioPin.SuspendUntilInterrupt(reactivationTime));
         }
         return outcome_v2::success();
@@ -1464,14 +2122,6 @@ template<std::size_t nProperties>
 }
 
 
-template<PropertyGroup propertyGroup, sts1cobcsw::Byte propertyStartIndex, std::size_t nProperties>
-[[nodiscard]] auto SetProperties(
-    Properties<propertyGroup, propertyStartIndex, nProperties> property) -> Result<void>
-{
-    return SetProperties(property.group, property.startIndex, Span(property.GetValues()));
-}
-
-
 template<std::size_t size>
     requires(size <= maxNProperties)
 inline auto GetProperties(PropertyGroup propertyGroup, Byte startIndex)
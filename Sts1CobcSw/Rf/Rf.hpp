@@ -1,11 +1,16 @@
 #pragma once
 
 
+#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
 #include <Sts1CobcSw/ChannelCoding/External/ConvolutionalCoding.hpp>
 #include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/Rf/TcBlockPool.hpp>
 #include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Vocabulary/LinkStatistics.hpp>
 #include <Sts1CobcSw/Vocabulary/Time.hpp>
 
+#include <etl/vector.h>
+
 #include <cstddef>
 #include <cstdint>
 #include <span>
@@ -14,7 +19,16 @@
 namespace sts1cobcsw::rf
 {
 inline constexpr auto correctPartNumber = 0x4463;
-inline constexpr auto maxTxDataLength = cc::ViterbiCodec::UnencodedSize((1U << 13U) - 1U, true);
+// The packet length field of the RF module has 13 bits. The limit is computed for the lowest code
+// rate so that it holds for all coding profiles.
+inline constexpr auto maxTxDataLength =
+    cc::ViterbiCodec::UnencodedSize((1U << 13U) - 1U, true, cc::CodeRate::oneHalf);
+// Maximum number of back-to-back TC blocks that ReceiveBurst() receives in a single RX window
+inline constexpr auto maxNBlocksPerBurst = 4U;
+
+
+// The blocks are owned by the queue until they are released to the pool they were acquired from
+using ReceivedTcBlocks = etl::vector<ReceivedTcBlock *, maxNBlocksPerBurst>;
 
 
 auto Initialize() -> Result<void>;
@@ -27,9 +41,30 @@ auto SetTxDataRate(std::uint32_t dataRate) -> void;
 auto SetRxDataRate(std::uint32_t dataRate) -> void;
 [[nodiscard]] auto GetTxDataRate() -> std::uint32_t;
 [[nodiscard]] auto GetRxDataRate() -> std::uint32_t;
+// The data passed to SendAndWait() and SendAndContinue() must already be encoded according to the
+// Reed-Solomon part of the TX coding profile. The convolutional coding is done while sending.
+auto SetTxCodingProfile(CodingProfile profile) -> void;
+[[nodiscard]] auto GetTxCodingProfile() -> CodingProfile;
 auto SendAndWait(std::span<Byte const> data) -> void;
 auto SendAndContinue(std::span<Byte const> data) -> void;
 auto SuspendUntilDataSent(Duration timeout) -> void;
 // Return the number of received bytes
 auto Receive(std::span<Byte> data, Duration timeout) -> std::size_t;
+// Like Receive() but also report which of the received bytes are suspect. Adjacent ranges are
+// merged and if there are too many, the last one is extended to cover all following ones.
+auto Receive(std::span<Byte> data, Duration timeout, SuspectByteRanges * suspectByteRanges)
+    -> std::size_t;
+// Wait up to timeout for a TC block and then keep receiving as long as further blocks, each
+// preceded by the attached sync marker, follow back to back. Every block is read straight from the
+// RX FIFO into a buffer acquired from the pool and appended to the queue in the order it was
+// received. The burst also ends if the pool runs out of buffers. Return the number of received
+// blocks.
+auto ReceiveBurst(TcBlockPool * pool, ReceivedTcBlocks * blocks, Duration timeout) -> std::size_t;
+// Return the link statistics of the current pass. A new pass starts with the first frame that is
+// received after a long time without any.
+[[nodiscard]] auto GetLinkStatistics() -> LinkStatistics;
+// Make a Receive() or ReceiveBurst() that is running in another thread return early, as if it had
+// timed out. Everything that was completely received until then is kept. If no reception is
+// running, this has no effect.
+auto CancelReceive() -> void;
 }
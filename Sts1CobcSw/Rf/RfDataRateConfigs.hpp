@@ -62,7 +62,7 @@ public:
     explicit constexpr Properties(std::array<Byte, size> const & values) : values_(values)
     {}
 
-    [[nodiscard]] auto GetValues() const -> std::array<Byte, nProperties> const &
+    [[nodiscard]] constexpr auto GetValues() const -> std::array<Byte, nProperties> const &
     {
         return values_;
     }
@@ -0,0 +1,379 @@
+#include <Sts1CobcSw/Rf/RfMock.hpp>
+
+#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
+#include <Sts1CobcSw/Rf/LinkStatistics.hpp>
+#include <Sts1CobcSw/Rf/Rf.hpp>  // IWYU pragma: associated
+#include <Sts1CobcSw/Rf/TcBlockPool.hpp>
+#include <Sts1CobcSw/RodosTime/RodosTime.hpp>
+
+#include <strong_type/affine_point.hpp>
+#include <strong_type/difference.hpp>
+#include <strong_type/ordered.hpp>
+
+#include <etl/vector.h>
+
+#include <algorithm>
+#include <bit>
+#include <climits>
+#include <cstddef>
+#include <random>
+#include <utility>
+
+
+namespace sts1cobcsw::rf
+{
+namespace
+{
+// The ground station is asked for new uplink data this often while the COBC listens
+constexpr auto uplinkPollInterval = 10 * ms;
+// A typical RSSI while the ground station is sending, see LinkStatistics
+constexpr auto simulatedRssi = std::uint8_t{100};
+
+
+enum class Direction : std::uint8_t
+{
+    none,
+    rx,
+    tx,
+};
+
+
+auto channelModel = ChannelModel{};
+auto channelStatistics = ChannelStatistics{};
+auto randomNumberGenerator = std::mt19937{};
+auto downlinkHandler = static_cast<void (*)(std::span<Byte const>)>([](auto) {});
+auto uplinkSource =
+    static_cast<std::size_t (*)(std::span<Byte>)>([](auto) { return std::size_t{0}; });
+
+auto txIsOn = false;
+auto rxDataRate = 9600U;
+auto txDataRate = 9600U;
+auto txCodingProfile = defaultCodingProfile;
+auto linkStatistics = LinkStatisticsCollector{};
+auto direction = Direction::none;
+auto txEnd = RodosTime(0);
+auto receiveIsCanceled = false;
+
+
+auto SwitchTo(Direction newDirection) -> void;
+[[nodiscard]] auto Airtime(std::size_t nBytes, std::uint32_t dataRate) -> Duration;
+[[nodiscard]] auto WaitForUplink(std::span<Byte> data, RodosTime reactivationTime) -> std::size_t;
+// Return the number of received bytes
+auto ReceiveUplink(std::span<Byte> data, SuspectByteRanges * suspectByteRanges) -> std::size_t;
+auto ApplyChannelErrors(std::span<Byte> data, SuspectByteRanges * suspectByteRanges) -> void;
+}
+
+
+auto Initialize() -> Result<void>
+{
+    direction = Direction::none;
+    txEnd = CurrentRodosTime();
+    linkStatistics.Reset();
+    return outcome_v2::success();
+}
+
+
+auto EnableTx() -> void
+{
+    txIsOn = true;
+}
+
+
+auto DisableTx() -> void
+{
+    txIsOn = false;
+}
+
+
+auto ReadPartNumber() -> std::uint16_t
+{
+    return correctPartNumber;
+}
+
+
+auto EnterStandbyMode() -> void
+{
+    direction = Direction::none;
+}
+
+
+auto SetTxDataLength([[maybe_unused]] std::uint16_t length) -> void
+{}  // The airtime only depends on the data that is actually sent
+
+
+auto SetTxDataRate(std::uint32_t dataRate) -> void
+{
+    txDataRate = dataRate;
+}
+
+
+auto SetRxDataRate(std::uint32_t dataRate) -> void
+{
+    rxDataRate = dataRate;
+}
+
+
+auto GetTxDataRate() -> std::uint32_t
+{
+    return txDataRate;
+}
+
+
+auto GetRxDataRate() -> std::uint32_t
+{
+    return rxDataRate;
+}
+
+
+auto SetTxCodingProfile(CodingProfile profile) -> void
+{
+    txCodingProfile = profile;
+}
+
+
+auto GetTxCodingProfile() -> CodingProfile
+{
+    return txCodingProfile;
+}
+
+
+auto SendAndWait(std::span<Byte const> data) -> void
+{
+    if(not txIsOn)
+    {
+        return;
+    }
+    SendAndContinue(data);
+    SuspendUntil(txEnd);
+    SuspendFor(channelModel.postTxDelay);
+}
+
+
+// The ground station gets the data as soon as the transmission starts. Only the next transmission
+// has to wait until the airtime of this one has passed.
+auto SendAndContinue(std::span<Byte const> data) -> void
+{
+    if(not txIsOn)
+    {
+        return;
+    }
+    SuspendUntil(txEnd);
+    SwitchTo(Direction::tx);
+    auto nSentBytes = cc::ViterbiCodec::EncodedSize(
+        data.size(), /*withFlushBits=*/true, ToCodeRate(txCodingProfile));
+    auto airtime = Airtime(nSentBytes, txDataRate);
+    txEnd = CurrentRodosTime() + airtime;
+    channelStatistics.txAirtime += airtime;
+    channelStatistics.nDownlinkBytes += static_cast<std::uint32_t>(data.size());
+    linkStatistics.AddSentBytes(data.size());
+    // The channel errors must not change the data of the caller
+    auto frame = etl::vector<Byte, maxTxDataLength>(data.begin(), data.end());
+    ApplyChannelErrors(frame, nullptr);
+    downlinkHandler(frame);
+}
+
+
+auto SuspendUntilDataSent(Duration timeout) -> void
+{
+    SuspendUntil(std::min(txEnd, CurrentRodosTime() + timeout));
+    SuspendFor(channelModel.postTxDelay);
+}
+
+
+auto Receive(std::span<Byte> data, Duration timeout) -> std::size_t
+{
+    return Receive(data, timeout, nullptr);
+}
+
+
+auto Receive(std::span<Byte> data, Duration timeout, SuspectByteRanges * suspectByteRanges)
+    -> std::size_t
+{
+    if(suspectByteRanges != nullptr)
+    {
+        suspectByteRanges->clear();
+    }
+    SwitchTo(Direction::rx);
+    auto nBytes = WaitForUplink(data, CurrentRodosTime() + timeout);
+    return ReceiveUplink(data.first(nBytes), suspectByteRanges);
+}
+
+
+// Only complete blocks are part of a burst. The burst ends as soon as the ground station sends
+// anything shorter.
+auto ReceiveBurst(TcBlockPool * pool, ReceivedTcBlocks * blocks, Duration timeout) -> std::size_t
+{
+    SwitchTo(Direction::rx);
+    auto reactivationTime = CurrentRodosTime() + timeout;
+    auto nReceivedBlocks = std::size_t{0};
+    while(not blocks->full())
+    {
+        auto * block = pool->Acquire();
+        if(block == nullptr)
+        {
+            break;
+        }
+        auto nBytes = nReceivedBlocks == 0 ? WaitForUplink(block->data, reactivationTime)
+                                           : uplinkSource(block->data);
+        if(nBytes < block->data.size())
+        {
+            pool->Release(block);
+            break;
+        }
+        (void)ReceiveUplink(block->data, &block->suspectByteRanges);
+        blocks->push_back(block);
+        ++nReceivedBlocks;
+    }
+    return nReceivedBlocks;
+}
+
+
+auto GetLinkStatistics() -> LinkStatistics
+{
+    return linkStatistics.Get();
+}
+
+
+auto CancelReceive() -> void
+{
+    receiveIsCanceled = true;
+}
+
+
+auto SetChannelModel(ChannelModel const & newChannelModel) -> void
+{
+    channelModel = newChannelModel;
+    channelStatistics = ChannelStatistics{};
+    randomNumberGenerator.seed(channelModel.seed);
+}
+
+
+auto SetDownlinkHandler(void (*handler)(std::span<Byte const> data)) -> void
+{
+    downlinkHandler = handler;
+}
+
+
+auto SetUplinkSource(std::size_t (*source)(std::span<Byte> data)) -> void
+{
+    uplinkSource = source;
+}
+
+
+auto GetChannelStatistics() -> ChannelStatistics
+{
+    return channelStatistics;
+}
+
+
+namespace
+{
+// Switching from RX to TX or back takes some time and has to wait until everything is sent
+auto SwitchTo(Direction newDirection) -> void
+{
+    if(direction == newDirection)
+    {
+        return;
+    }
+    SuspendUntil(txEnd);
+    if(direction != Direction::none)
+    {
+        SuspendFor(channelModel.rxTxSwitchDuration);
+        ++channelStatistics.nRxTxSwitches;
+    }
+    direction = newDirection;
+}
+
+
+auto Airtime(std::size_t nBytes, std::uint32_t dataRate) -> Duration
+{
+    if(dataRate == 0)
+    {
+        return Duration(0);
+    }
+    return static_cast<std::int64_t>(nBytes * CHAR_BIT) * s / static_cast<std::int64_t>(dataRate);
+}
+
+
+auto WaitForUplink(std::span<Byte> data, RodosTime reactivationTime) -> std::size_t
+{
+    receiveIsCanceled = false;
+    while(true)
+    {
+        auto nBytes = std::min(uplinkSource(data), data.size());
+        if(nBytes > 0)
+        {
+            return nBytes;
+        }
+        auto now = CurrentRodosTime();
+        if(receiveIsCanceled or now >= reactivationTime)
+        {
+            return 0;
+        }
+        SuspendUntil(std::min(now + uplinkPollInterval, reactivationTime));
+    }
+}
+
+
+// Every uplink transmission is preceded by the attached sync marker
+auto ReceiveUplink(std::span<Byte> data, SuspectByteRanges * suspectByteRanges) -> std::size_t
+{
+    if(data.empty())
+    {
+        return 0;
+    }
+    auto airtime = Airtime(attachedSynchMarkerLength + data.size(), rxDataRate);
+    SuspendFor(airtime);
+    channelStatistics.rxAirtime += airtime;
+    channelStatistics.nUplinkBytes += static_cast<std::uint32_t>(data.size());
+    linkStatistics.AddSample(simulatedRssi, 0);
+    linkStatistics.AddReceivedBytes(data.size());
+    ApplyChannelErrors(data, suspectByteRanges);
+    return data.size();
+}
+
+
+auto ApplyChannelErrors(std::span<Byte> data, SuspectByteRanges * suspectByteRanges) -> void
+{
+    if(data.empty())
+    {
+        return;
+    }
+    if(channelModel.bitErrorRate > 0.0)
+    {
+        // Draw the distance to the next bit error instead of deciding for every single bit
+        auto nCorrectBits = std::geometric_distribution<std::size_t>(channelModel.bitErrorRate);
+        auto nBits = data.size() * CHAR_BIT;
+        for(auto iBit = nCorrectBits(randomNumberGenerator); iBit < nBits;
+            iBit += 1 + nCorrectBits(randomNumberGenerator))
+        {
+            data[iBit / CHAR_BIT] ^= static_cast<Byte>(0x80U >> (iBit % CHAR_BIT));
+            ++channelStatistics.nFlippedBits;
+        }
+    }
+    auto burstOccurs = std::bernoulli_distribution(channelModel.burstErrorProbability);
+    if(channelModel.burstLength == 0 or not burstOccurs(randomNumberGenerator))
+    {
+        return;
+    }
+    auto burstLength = std::min(channelModel.burstLength, data.size());
+    auto burstBegin = std::uniform_int_distribution<std::size_t>(
+        0, data.size() - burstLength)(randomNumberGenerator);
+    auto randomByte = std::uniform_int_distribution<unsigned int>(0, UCHAR_MAX);
+    for(auto & byte : data.subspan(burstBegin, burstLength))
+    {
+        auto newByte = static_cast<Byte>(randomByte(randomNumberGenerator));
+        channelStatistics.nFlippedBits += static_cast<std::uint32_t>(
+            std::popcount(static_cast<unsigned int>(byte ^ newByte)));
+        byte = newByte;
+    }
+    ++channelStatistics.nBurstErrors;
+    if(suspectByteRanges != nullptr and not suspectByteRanges->full())
+    {
+        suspectByteRanges->push_back(
+            {.begin = static_cast<std::uint16_t>(burstBegin),
+             .end = static_cast<std::uint16_t>(burstBegin + burstLength)});
+    }
+}
+}
+}
@@ -0,0 +1,57 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Rf/Rf.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <strong_type/type.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+// On Linux, the RF module is replaced by a simulated channel to a scripted ground station. It
+// models the airtime of all sent and received data, the time it takes to switch between RX and TX,
+// as well as random bit errors and burst errors. This allows measuring the goodput for different
+// data rates and error rates without any hardware.
+namespace sts1cobcsw::rf
+{
+// The errors are applied to the bytes that the Reed-Solomon decoder sees, so the bit error rate is
+// the residual one after Viterbi decoding. A burst error randomizes burstLength consecutive bytes
+// and is flagged as suspect on the uplink, like a fade detected by the receiver.
+struct ChannelModel
+{
+    double bitErrorRate = 0.0;
+    // Probability that a single frame or TC block is hit by a burst error
+    double burstErrorProbability = 0.0;
+    std::size_t burstLength = 0;
+    Duration rxTxSwitchDuration = Duration(0);
+    // The real RF module has to wait this long after every transmission before it can receive
+    Duration postTxDelay = Duration(0);
+    std::uint32_t seed = 1;
+};
+
+
+struct ChannelStatistics
+{
+    std::uint32_t nDownlinkBytes = 0;
+    std::uint32_t nUplinkBytes = 0;
+    std::uint32_t nFlippedBits = 0;
+    std::uint32_t nBurstErrors = 0;
+    std::uint32_t nRxTxSwitches = 0;
+    Duration txAirtime = Duration(0);
+    Duration rxAirtime = Duration(0);
+};
+
+
+// Also reseeds the random number generator and resets the channel statistics
+auto SetChannelModel(ChannelModel const & channelModel) -> void;
+// The handler gets everything that was sent, after it went through the channel
+auto SetDownlinkHandler(void (*handler)(std::span<Byte const> data)) -> void;
+// The source is asked for uplink data whenever the COBC listens. It must fill at most data.size()
+// bytes and return how many it filled. Returning 0 means that the ground station is not sending.
+auto SetUplinkSource(std::size_t (*source)(std::span<Byte> data)) -> void;
+[[nodiscard]] auto GetChannelStatistics() -> ChannelStatistics;
+}
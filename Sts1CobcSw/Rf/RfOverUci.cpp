@@ -1,10 +1,13 @@
-#include <Sts1CobcSw/ChannelCoding/External/ConvolutionalCoding.hpp>
+#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
+#include <Sts1CobcSw/ChannelCoding/FrameEncoder.hpp>
 #include <Sts1CobcSw/FramSections/FramLayout.hpp>
 #include <Sts1CobcSw/FramSections/PersistentVariables.hpp>
 #include <Sts1CobcSw/Hal/IoNames.hpp>
 #include <Sts1CobcSw/Hal/Uart.hpp>
 #include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/Rf/LinkStatistics.hpp>
 #include <Sts1CobcSw/Rf/Rf.hpp>  // IWYU pragma: associated
+#include <Sts1CobcSw/Rf/TcBlockPool.hpp>
 #include <Sts1CobcSw/RodosTime/RodosTime.hpp>
 #include <Sts1CobcSw/Utility/DebugPrint.hpp>
 #include <Sts1CobcSw/Utility/Span.hpp>
@@ -14,8 +17,6 @@
 
 #include <rodos_no_using_namespace.h>
 
-#include <etl/vector.h>
-
 #include <array>
 #include <utility>
 
@@ -35,10 +36,14 @@ constexpr auto startOfFrame = 0x02_b;
 constexpr auto endOfFrame = std::array{0x0D_b, 0x0A_b};  // = \r\n
 constexpr auto frameDelimiterTimeout = 10 * ms;  // Timeout for writing the start or end of frame
 constexpr auto postFrameSentDelay = 50 * ms;
+constexpr auto encodedChunkSize = 64U;
 
 auto uciUart = RODOS::HAL_UART(hal::uciUartIndex, hal::uciUartTxPin, hal::uciUartRxPin);
 auto rxDataRate = uartBaudRate;
 auto txDataRate = uartBaudRate;
+auto txCodingProfile = defaultCodingProfile;
+// There is no RF link, so only the number of sent and received bytes is counted
+auto linkStatistics = LinkStatisticsCollector{};
 }
 
 
@@ -104,6 +109,18 @@ auto GetRxDataRate() -> std::uint32_t
 }
 
 
+auto SetTxCodingProfile(CodingProfile profile) -> void
+{
+    txCodingProfile = profile;
+}
+
+
+auto GetTxCodingProfile() -> CodingProfile
+{
+    return txCodingProfile;
+}
+
+
 auto SendAndWait(std::span<Byte const> data) -> void
 {
     if(not persistentVariables.Load<"txIsOn">())
@@ -114,15 +131,22 @@ auto SendAndWait(std::span<Byte const> data) -> void
     auto result = [&]() -> Result<void>
     {
         auto uciUartProtector = RODOS::ScopeProtector(&uciUartSemaphore);
-        auto convolutionalCoder = sts1cobcsw::cc::ViterbiCodec{};
-        auto encodedData = convolutionalCoder.Encode(data, /*flush=*/true);
+        // Interleaved frames are too long to be encoded all at once, so we encode and send them in
+        // chunks
+        auto frameEncoder = tm::FrameEncoder();
+        frameEncoder.StartConvolutionalCoding(data, ToCodeRate(txCodingProfile));
+        auto encodedChunk = std::array<Byte, encodedChunkSize>{};
         auto const txByteRate = txDataRate / 10;
         static constexpr auto safetyFactor = 2;
         static constexpr auto safetyMargin = 10 * ms;
         auto const timeout =
-            static_cast<int>(encodedData.size()) * s / txByteRate * safetyFactor + safetyMargin;
+            static_cast<int>(encodedChunk.size()) * s / txByteRate * safetyFactor + safetyMargin;
         OUTCOME_TRY(hal::WriteTo(&uciUart, Span(startOfFrame), frameDelimiterTimeout));
-        OUTCOME_TRY(hal::WriteTo(&uciUart, Span(encodedData), timeout));
+        while(not frameEncoder.IsDone())
+        {
+            auto nEncodedBytes = frameEncoder.Read(encodedChunk);
+            OUTCOME_TRY(hal::WriteTo(&uciUart, Span(encodedChunk).first(nEncodedBytes), timeout));
+        }
         OUTCOME_TRY(hal::WriteTo(&uciUart, Span(endOfFrame), frameDelimiterTimeout));
         SuspendFor(postFrameSentDelay);
         return outcome_v2::success();
@@ -132,6 +156,7 @@ auto SendAndWait(std::span<Byte const> data) -> void
         DEBUG_PRINT("Failed to send data: %s\n", ToCZString(result.error()));
         return;
     }
+    linkStatistics.AddSentBytes(data.size());
 }
 
 
@@ -158,6 +183,54 @@ auto Receive(std::span<Byte> data, Duration timeout) -> std::size_t
     {
         return 0;
     }
+    linkStatistics.AddReceivedBytes(data.size());
     return data.size();
 }
+
+
+// There is no RF link, so no received byte is suspect
+auto Receive(std::span<Byte> data, Duration timeout, SuspectByteRanges * suspectByteRanges)
+    -> std::size_t
+{
+    if(suspectByteRanges != nullptr)
+    {
+        suspectByteRanges->clear();
+    }
+    return Receive(data, timeout);
+}
+
+
+// Frames sent over the UART are not preceded by an attached sync marker, so we can only receive one
+// block at a time
+auto ReceiveBurst(TcBlockPool * pool, ReceivedTcBlocks * blocks, Duration timeout) -> std::size_t
+{
+    if(blocks->full())
+    {
+        return 0;
+    }
+    auto * block = pool->Acquire();
+    if(block == nullptr)
+    {
+        return 0;
+    }
+    if(Receive(block->data, timeout) < block->data.size())
+    {
+        pool->Release(block);
+        return 0;
+    }
+    blocks->push_back(block);
+    return 1;
+}
+
+
+auto GetLinkStatistics() -> LinkStatistics
+{
+    return linkStatistics.Get();
+}
+
+
+// Reading from the UART cannot be interrupted, so a canceled reception simply runs until its
+// timeout
+auto CancelReceive() -> void
+{}
 }
@@ -0,0 +1,45 @@
+#include <Sts1CobcSw/Rf/TcBlockPool.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <iterator>
+
+
+namespace sts1cobcsw::rf
+{
+auto TcBlockPool::Acquire() -> ReceivedTcBlock *
+{
+    auto protector = RODOS::ScopeProtector(&semaphore_);  // NOLINT(*readability-casting)
+    auto it = std::ranges::find(blockIsInUse_, false);
+    if(it == blockIsInUse_.end())
+    {
+        return nullptr;
+    }
+    *it = true;
+    auto & block = blocks_[static_cast<std::size_t>(std::distance(blockIsInUse_.begin(), it))];
+    block.suspectByteRanges.clear();
+    block.decoder.Reset();
+    return &block;
+}
+
+
+auto TcBlockPool::Release(ReceivedTcBlock const * block) -> void
+{
+    if(block == nullptr)
+    {
+        return;
+    }
+    auto protector = RODOS::ScopeProtector(&semaphore_);  // NOLINT(*readability-casting)
+    auto index = static_cast<std::size_t>(block - blocks_.data());
+    assert(index < blocks_.size());
+    assert(blockIsInUse_[index]);
+    blockIsInUse_[index] = false;
+}
+
+
+auto TcBlockPool::NAvailableBlocks() const -> std::size_t
+{
+    auto protector = RODOS::ScopeProtector(&semaphore_);  // NOLINT(*readability-casting)
+    return static_cast<std::size_t>(std::ranges::count(blockIsInUse_, false));
+}
+}
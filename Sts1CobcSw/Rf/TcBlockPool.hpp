@@ -0,0 +1,76 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Blake2s/Blake2s.hpp>
+#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+
+#include <rodos_no_using_namespace.h>
+
+#include <etl/vector.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <tuple>
+
+
+namespace sts1cobcsw::rf
+{
+inline constexpr auto maxNSuspectByteRanges = 8U;
+// Enough for two full bursts, one that is handled and one that is received in the background, plus
+// the block of the PDU that the file transfer thread is currently working on and the block of the
+// PDU that waits for it in the mailbox
+inline constexpr auto nTcBlockBuffers = 10U;
+// The MAC of a TC transfer frame is at the end of the message and covers everything before it
+inline constexpr auto nAuthenticatedTcBytes =
+    tc::messageLength - std::tuple_size_v<blake2s::Hash>;
+
+
+// A range [begin, end) of received bytes that are likely corrupted, e.g., because the RSSI was too
+// low or the RX FIFO overflowed while they were received
+struct SuspectByteRange
+{
+    std::uint16_t begin = 0;
+    std::uint16_t end = 0;
+};
+
+
+using SuspectByteRanges = etl::vector<SuspectByteRange, maxNSuspectByteRanges>;
+
+
+struct ReceivedTcBlock
+{
+    std::array<Byte, tc::blockLength> data = {};
+    SuspectByteRanges suspectByteRanges;  // Relative to the start of data
+    // Decoding and authentication already start while a block is received. If the decoder is not
+    // complete, e.g., because the block had to be realigned after a bit slip, the data is still
+    // scrambled and the block must be decoded as a whole.
+    tc::BlockDecoder decoder;
+    // Of the first nAuthenticatedTcBytes as they were received, only valid if the decoder is
+    // complete
+    blake2s::Hash messageAuthenticationCode = {};
+};
+
+
+// A fixed pool of TC block buffers. Instead of copying a received block from stage to stage, its
+// ownership is handed over: the RF driver reads it straight from the RX FIFO into a buffer of the
+// pool, the RF communication thread decodes and parses it in place, and the file transfer thread
+// works on the PDU right where it is in the block. The last owner must release the block.
+class TcBlockPool
+{
+public:
+    // Return nullptr if all blocks are in use. The suspect byte ranges and the decoder of the block
+    // are reset.
+    [[nodiscard]] auto Acquire() -> ReceivedTcBlock *;
+    // Releasing nullptr does nothing
+    auto Release(ReceivedTcBlock const * block) -> void;
+    [[nodiscard]] auto NAvailableBlocks() const -> std::size_t;
+
+
+private:
+    std::array<ReceivedTcBlock, nTcBlockBuffers> blocks_ = {};
+    std::array<bool, nTcBlockBuffers> blockIsInUse_ = {};
+    mutable RODOS::Semaphore semaphore_;
+};
+}
@@ -91,6 +91,7 @@ using MessageTypeId = Id<MessageTypeIdFields,
                          {1, 7},
                          {1, 8},
                          {3, 25},
+                         {3, 128},
                          {6, 6},
                          {20, 2},
                          {23, 4},
@@ -122,6 +123,7 @@ enum class FunctionId : std::uint8_t
 {
     stopAntennaDeployment = 1,
     requestHousekeepingParameterReports = 2,
+    requestCompressedHousekeepingParameterReports = 3,
     disableCubeSatTx = 4,
     enableCubeSatTx = 7,
     resetNow = 8,
@@ -136,7 +138,8 @@ enum class FunctionId : std::uint8_t
 using ApplicationProcessUserId = Id<std::uint16_t, 0xAA33>;  // NOLINT(*magic-numbers)
 inline constexpr auto applicationProcessUserId = Make<ApplicationProcessUserId, 0xAA33>();
 
-inline constexpr auto maxNParameters = 5U;  // Chosen to be the number of different parameters
+// Max. number of parameters in a single request or report
+inline constexpr auto maxNParameters = 5U;
 
 enum class LockState : std::uint8_t
 {
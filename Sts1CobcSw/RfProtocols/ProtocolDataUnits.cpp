@@ -292,9 +292,7 @@ auto ParseAsProtocolDataUnit(std::span<Byte const> buffer) -> Result<tc::Protoco
     {
         return ErrorCode::bufferTooSmall;
     }
-    pdu.dataField.uninitialized_resize(pdu.header.pduDataFieldLength);
-    std::ranges::copy(buffer.subspan(pduHeaderLength, pdu.header.pduDataFieldLength),
-                      pdu.dataField.begin());
+    pdu.dataField = buffer.subspan(pduHeaderLength, pdu.header.pduDataFieldLength);
     return pdu;
 }
 
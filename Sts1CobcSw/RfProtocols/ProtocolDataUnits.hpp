@@ -34,7 +34,7 @@ struct ProtocolDataUnit
     using Header = ProtocolDataUnitHeader;
 
     Header header;
-    etl::vector<Byte, tc::maxPduDataLength> dataField;
+    std::span<Byte const> dataField;
 };
 }
 
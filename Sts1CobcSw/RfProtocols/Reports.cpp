@@ -4,9 +4,11 @@
 #include <Sts1CobcSw/RfProtocols/IdCounters.hpp>
 #include <Sts1CobcSw/RfProtocols/Utility.hpp>
 #include <Sts1CobcSw/RfProtocols/Vocabulary.hpp>
+#include <Sts1CobcSw/Telemetry/TelemetryRecordCompression.hpp>
 #include <Sts1CobcSw/Vocabulary/MessageTypeIdFields.hpp>
 
 #include <algorithm>
+#include <limits>
 
 
 namespace sts1cobcsw
@@ -103,6 +105,48 @@ auto HousekeepingParameterReport::DoSize() const -> std::uint16_t
 }
 
 
+auto CompressedHousekeepingParameterReport::Add(TelemetryRecord const & record) -> bool
+{
+    auto serializedRecord = Serialize<ccsdsEndianness>(record);
+    auto compressedRecord = Compress(serializedRecord, lastRecord_);
+    if(compressedRecord.size() > compressedRecords_.available()
+       or nRecords_ == std::numeric_limits<std::uint8_t>::max())
+    {
+        return false;
+    }
+    compressedRecords_.insert(
+        compressedRecords_.end(), compressedRecord.begin(), compressedRecord.end());
+    lastRecord_ = serializedRecord;
+    ++nRecords_;
+    return true;
+}
+
+
+auto CompressedHousekeepingParameterReport::NRecords() const -> std::uint8_t
+{
+    return nRecords_;
+}
+
+
+auto CompressedHousekeepingParameterReport::DoAddTo(etl::ivector<Byte> * dataField) const -> void
+{
+    UpdateMessageTypeCounterAndTime(&secondaryHeader_);
+    auto oldSize = IncreaseSize(dataField, DoSize());
+    auto * cursor = SerializeTo<ccsdsEndianness>(dataField->data() + oldSize, secondaryHeader_);
+    cursor = SerializeTo<ccsdsEndianness>(cursor, structureId);
+    cursor = SerializeTo<ccsdsEndianness>(cursor, nRecords_);
+    std::ranges::copy(compressedRecords_, static_cast<Byte *>(cursor));
+}
+
+
+auto CompressedHousekeepingParameterReport::DoSize() const -> std::uint16_t
+{
+    return static_cast<std::uint16_t>(
+        totalSerialSize<decltype(secondaryHeader_), decltype(structureId), decltype(nRecords_)>
+        + compressedRecords_.size());
+}
+
+
 ParameterValueReport::ParameterValueReport(Parameter::Id parameterId,
                                            Parameter::Value parameterValue)
     : nParameters_(1),
@@ -117,6 +117,32 @@ private:
 };
 
 
+// Contains as many consecutive telemetry records as fit into one packet. The first record is
+// compressed relative to a default-constructed one and every other record relative to the previous
+// one (see Compress()).
+class CompressedHousekeepingParameterReport : public Payload
+{
+public:
+    // Return false and do nothing if the compressed record does not fit into the report anymore
+    [[nodiscard]] auto Add(TelemetryRecord const & record) -> bool;
+    [[nodiscard]] auto NRecords() const -> std::uint8_t;
+
+
+private:
+    static constexpr auto messageTypeId = Make<tm::MessageTypeId, {3, 128}>();
+    mutable tm::SpacePacketSecondaryHeader<messageTypeId> secondaryHeader_;
+    static constexpr std::uint8_t structureId = 0;
+    std::uint8_t nRecords_ = 0;
+    static constexpr auto maxCompressedRecordsLength =
+        tm::maxMessageDataLength - totalSerialSize<decltype(structureId), decltype(nRecords_)>;
+    etl::vector<Byte, maxCompressedRecordsLength> compressedRecords_;
+    SerialBuffer<TelemetryRecord> lastRecord_ = Serialize<ccsdsEndianness>(TelemetryRecord{});
+
+    auto DoAddTo(etl::ivector<Byte> * dataField) const -> void override;
+    [[nodiscard]] auto DoSize() const -> std::uint16_t override;
+};
+
+
 class ParameterValueReport : public Payload
 {
 public:
@@ -291,6 +291,20 @@ auto ParseAsReportHousekeepingParameterReportFunction(std::span<Byte const> buff
 }
 
 
+auto ParseAsReportCompressedHousekeepingParameterReportFunction(std::span<Byte const> buffer)
+    -> Result<ReportCompressedHousekeepingParameterReportFunction>
+{
+    auto parseResult = ParseAsReportHousekeepingParameterReportFunction(buffer);
+    if(parseResult.has_error())
+    {
+        return parseResult.error();
+    }
+    return ReportCompressedHousekeepingParameterReportFunction{
+        .firstReportIndex = parseResult.value().firstReportIndex,
+        .lastReportIndex = parseResult.value().lastReportIndex};
+}
+
+
 auto ParseAsEnableFileTransferFunction(std::span<Byte const> buffer)
     -> Result<EnableFileTransferFunction>
 {
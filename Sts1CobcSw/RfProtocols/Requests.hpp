@@ -134,6 +134,16 @@ struct ReportHousekeepingParameterReportFunction
 };
 
 
+// Same as ReportHousekeepingParameterReportFunction but answered with compressed reports
+struct ReportCompressedHousekeepingParameterReportFunction
+{
+    static constexpr auto id = Make<tc::MessageTypeId, {8, 1}>();
+    static constexpr auto functionId = FunctionId::requestCompressedHousekeepingParameterReports;
+    std::uint16_t firstReportIndex;
+    std::uint16_t lastReportIndex;
+};
+
+
 struct EnableFileTransferFunction
 {
     static constexpr auto id = Make<tc::MessageTypeId, {8, 1}>();
@@ -212,6 +222,8 @@ struct CheckFirmwareIntegrityFunction
 
 [[nodiscard]] auto ParseAsReportHousekeepingParameterReportFunction(std::span<Byte const> buffer)
     -> Result<ReportHousekeepingParameterReportFunction>;
+[[nodiscard]] auto ParseAsReportCompressedHousekeepingParameterReportFunction(
+    std::span<Byte const> buffer) -> Result<ReportCompressedHousekeepingParameterReportFunction>;
 [[nodiscard]] auto ParseAsEnableFileTransferFunction(std::span<Byte const> buffer)
     -> Result<EnableFileTransferFunction>;
 [[nodiscard]] auto ParseAsSynchronizeTimeFunction(std::span<Byte const> buffer)
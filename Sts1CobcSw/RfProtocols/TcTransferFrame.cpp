@@ -10,6 +10,14 @@ namespace sts1cobcsw::tc
 {
 auto ParseAsTransferFrame(std::span<Byte const, transferFrameLength> buffer)
     -> Result<TransferFrame>
+{
+    return ParseAsTransferFrame(
+        buffer, blake2s::ComputeHash(buffer.first<transferFrameLength - securityTrailerLength>()));
+}
+
+
+auto ParseAsTransferFrame(std::span<Byte const, transferFrameLength> buffer,
+                          blake2s::Hash const & messageAuthenticationCode) -> Result<TransferFrame>
 {
     auto frame = TransferFrame{
         .dataField = buffer.subspan<transferFramePrimaryHeaderLength + securityHeaderLength,
@@ -41,8 +49,6 @@ auto ParseAsTransferFrame(std::span<Byte const, transferFrameLength> buffer)
     }
     (void)sts1cobcsw::DeserializeFrom<ccsdsEndianness>(buffer.last<securityTrailerLength>().data(),
                                                        &frame.messageAuthenticationCode);
-    auto messageAuthenticationCode =
-        blake2s::ComputeHash(buffer.first<transferFrameLength - securityTrailerLength>());
     if(frame.messageAuthenticationCode != messageAuthenticationCode)
     {
 #ifdef ENABLE_DEBUG_PRINT
@@ -46,6 +46,11 @@ struct TransferFrame
 
 [[nodiscard]] auto ParseAsTransferFrame(std::span<Byte const, transferFrameLength> buffer)
     -> Result<TransferFrame>;
+// Like above but check the received MAC against the given one instead of computing it, e.g.,
+// because it was already computed while the frame was received
+[[nodiscard]] auto ParseAsTransferFrame(std::span<Byte const, transferFrameLength> buffer,
+                                        blake2s::Hash const & messageAuthenticationCode)
+    -> Result<TransferFrame>;
 
 template<std::endian endianness>
 [[nodiscard]] auto DeserializeFrom(void const * source, TransferFrame::PrimaryHeader * header)
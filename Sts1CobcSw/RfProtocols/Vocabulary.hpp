@@ -19,6 +19,17 @@ struct Parameter
         txDataRate,
         newEduResultIsAvailable,
         maxEduIdleDuration,
+        txCodingProfile,
+        // Read-only link statistics of the current pass, see rf::LinkStatistics
+        linkRssi,         // Min. RSSI << 16 | mean RSSI << 8 | max. RSSI
+        linkAfcOffset,    // Mean AFC frequency offset, sign-extended to 32 bits
+        nRfFifoErrors,    // Number of RX FIFO overflows << 16 | number of TX FIFO underruns
+        nReceivedBytes,
+        nSentBytes,
+        // Bounds for the adaptive TX data rate. It is only adapted if they contain a supported data
+        // rate, see rf::AdaptDataRate().
+        minTxDataRate,
+        maxTxDataRate,
     };
     using Value = std::uint32_t;
 
@@ -14,6 +14,14 @@ constexpr auto IsValid(Parameter::Id parameterId) -> bool
         case Parameter::Id::txDataRate:
         case Parameter::Id::maxEduIdleDuration:
         case Parameter::Id::newEduResultIsAvailable:
+        case Parameter::Id::txCodingProfile:
+        case Parameter::Id::linkRssi:
+        case Parameter::Id::linkAfcOffset:
+        case Parameter::Id::nRfFifoErrors:
+        case Parameter::Id::nReceivedBytes:
+        case Parameter::Id::nSentBytes:
+        case Parameter::Id::minTxDataRate:
+        case Parameter::Id::maxTxDataRate:
             return true;
     }
     return false;
@@ -44,10 +44,14 @@ auto DeserializeFrom(void const * source, TelemetryRecord * data) -> void const
     source = DeserializeFrom<endianness>(source, &(data->nUncorrectableUplinkErrors));
     source = DeserializeFrom<endianness>(source, &(data->nGoodTransferFrames));
     source = DeserializeFrom<endianness>(source, &(data->nBadTransferFrames));
+    source = DeserializeFrom<endianness>(source, &(data->nDroppedPdus));
     source = DeserializeFrom<endianness>(source, &(data->lastFrameSequenceNumber));
     source = DeserializeFrom<endianness>(source, &(data->lastMessageTypeId));
     source = DeserializeFrom<endianness>(source, &(data->fileTransferStatus));
     source = DeserializeFrom<endianness>(source, &(data->transactionSequenceNumber));
+    source = DeserializeFrom<endianness>(source, &(data->linkStatistics));
+    source = DeserializeFrom<endianness>(source, &(data->lastTxDataRateDecision));
+    source = DeserializeFrom<endianness>(source, &(data->schedulerStatistics));
     return source;
 }
 
@@ -93,10 +97,14 @@ auto SerializeTo(void * destination, TelemetryRecord const & data) -> void *
     destination = SerializeTo<endianness>(destination, data.nUncorrectableUplinkErrors);
     destination = SerializeTo<endianness>(destination, data.nGoodTransferFrames);
     destination = SerializeTo<endianness>(destination, data.nBadTransferFrames);
+    destination = SerializeTo<endianness>(destination, data.nDroppedPdus);
     destination = SerializeTo<endianness>(destination, data.lastFrameSequenceNumber);
     destination = SerializeTo<endianness>(destination, data.lastMessageTypeId);
     destination = SerializeTo<endianness>(destination, data.fileTransferStatus);
     destination = SerializeTo<endianness>(destination, data.transactionSequenceNumber);
+    destination = SerializeTo<endianness>(destination, data.linkStatistics);
+    destination = SerializeTo<endianness>(destination, data.lastTxDataRateDecision);
+    destination = SerializeTo<endianness>(destination, data.schedulerStatistics);
     return destination;
 }
 
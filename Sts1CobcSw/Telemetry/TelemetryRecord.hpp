@@ -4,9 +4,12 @@
 #include <Sts1CobcSw/Sensors/Eps.hpp>
 #include <Sts1CobcSw/Serial/Serial.hpp>
 #include <Sts1CobcSw/Serial/UInt.hpp>
+#include <Sts1CobcSw/Vocabulary/DataRateDecision.hpp>
 #include <Sts1CobcSw/Vocabulary/FileTransfer.hpp>
 #include <Sts1CobcSw/Vocabulary/Ids.hpp>
+#include <Sts1CobcSw/Vocabulary/LinkStatistics.hpp>
 #include <Sts1CobcSw/Vocabulary/MessageTypeIdFields.hpp>
+#include <Sts1CobcSw/Vocabulary/SchedulerStatistics.hpp>
 #include <Sts1CobcSw/Vocabulary/Time.hpp>
 
 #include <bit>
@@ -68,10 +71,15 @@ struct TelemetryRecord
     std::uint16_t nUncorrectableUplinkErrors = 0U;
     std::uint16_t nGoodTransferFrames = 0U;
     std::uint16_t nBadTransferFrames = 0U;
+    // Good CFDP PDUs that were dropped because the file transfer thread did not take them in time
+    std::uint16_t nDroppedPdus = 0U;
     std::uint8_t lastFrameSequenceNumber = 0U;
     MessageTypeIdFields lastMessageTypeId;
     FileTransferStatus fileTransferStatus = FileTransferStatus::inactive;
     std::uint16_t transactionSequenceNumber = unknownTransactionSequenceNumber;
+    rf::LinkStatistics linkStatistics = {};
+    rf::DataRateDecision lastTxDataRateDecision = rf::DataRateDecision::keep;
+    rf::SchedulerStatistics schedulerStatistics = {};
 
     friend auto operator==(TelemetryRecord const &, TelemetryRecord const &) -> bool = default;
 };
@@ -122,10 +130,14 @@ inline constexpr std::size_t serialSize<TelemetryRecord> =
         decltype(TelemetryRecord::nUncorrectableUplinkErrors),
         decltype(TelemetryRecord::nGoodTransferFrames),
         decltype(TelemetryRecord::nBadTransferFrames),
+        decltype(TelemetryRecord::nDroppedPdus),
         decltype(TelemetryRecord::lastFrameSequenceNumber),
         decltype(TelemetryRecord::lastMessageTypeId),
         decltype(TelemetryRecord::fileTransferStatus),
-        decltype(TelemetryRecord::transactionSequenceNumber)>;
+        decltype(TelemetryRecord::transactionSequenceNumber),
+        decltype(TelemetryRecord::linkStatistics),
+        decltype(TelemetryRecord::lastTxDataRateDecision),
+        decltype(TelemetryRecord::schedulerStatistics)>;
 
 
 template<std::endian endianness>
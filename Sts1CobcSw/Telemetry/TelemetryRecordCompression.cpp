@@ -0,0 +1,171 @@
+#include <Sts1CobcSw/Telemetry/TelemetryRecordCompression.hpp>
+
+#include <Sts1CobcSw/Serial/UInt.hpp>
+
+#include <climits>
+#include <cstdint>
+
+
+namespace sts1cobcsw
+{
+namespace
+{
+// UInt<>s can only be (de-)serialized in groups that fill whole bytes, so we need a bit stream for
+// the variable-length codes
+class BitWriter
+{
+public:
+    explicit BitWriter(CompressedTelemetryRecord * data);
+
+    template<std::size_t nBits>
+    auto Write(UInt<nBits> value) -> void;
+
+
+private:
+    CompressedTelemetryRecord * data_;
+    // Number of bits already used in the last byte
+    unsigned nUsedBits_ = CHAR_BIT;
+};
+
+
+class BitReader
+{
+public:
+    explicit BitReader(std::span<Byte const> data);
+
+    template<std::size_t nBits>
+    [[nodiscard]] auto Read() -> Result<UInt<nBits>>;
+    // Return the number of bytes that were read, including the partially read last one
+    [[nodiscard]] auto NReadBytes() const -> std::size_t;
+
+
+private:
+    std::span<Byte const> data_;
+    std::size_t nReadBits_ = 0;
+};
+
+
+constexpr auto maxSmallDifference = 7U;
+constexpr auto minSmallDifference = 0xF8U;  // -8 as an 8-bit two's complement
+constexpr auto smallDifferenceSignBit = 0x08U;
+constexpr auto smallDifferenceSignExtension = 0xF0U;
+}
+
+
+auto Compress(SerialBuffer<TelemetryRecord> const & record,
+              SerialBuffer<TelemetryRecord> const & reference) -> CompressedTelemetryRecord
+{
+    auto compressedRecord = CompressedTelemetryRecord{};
+    auto writer = BitWriter(&compressedRecord);
+    for(auto i = 0U; i < record.size(); ++i)
+    {
+        auto difference = static_cast<std::uint8_t>(static_cast<std::uint8_t>(record[i])
+                                                     - static_cast<std::uint8_t>(reference[i]));
+        if(difference == 0U)
+        {
+            writer.Write(UInt<1>(0));
+        }
+        else if(difference <= maxSmallDifference or difference >= minSmallDifference)
+        {
+            writer.Write(UInt<2>(0b10));
+            writer.Write(UInt<4>(difference));
+        }
+        else
+        {
+            writer.Write(UInt<2>(0b11));
+            writer.Write(UInt<8>(difference));
+        }
+    }
+    return compressedRecord;
+}
+
+
+auto Decompress(std::span<Byte const> * compressedData, SerialBuffer<TelemetryRecord> * record)
+    -> Result<void>
+{
+    auto reader = BitReader(*compressedData);
+    // We only overwrite the reference if the whole record could be decompressed
+    auto decompressedRecord = *record;
+    for(auto & byte : decompressedRecord)
+    {
+        OUTCOME_TRY(auto hasChanged, reader.Read<1>());
+        if(hasChanged == 0U)
+        {
+            continue;
+        }
+        OUTCOME_TRY(auto isLarge, reader.Read<1>());
+        auto difference = std::uint8_t{0};
+        if(isLarge == 0U)
+        {
+            OUTCOME_TRY(auto smallDifference, reader.Read<4>());
+            difference = smallDifference.ToUnderlying();
+            if((difference & smallDifferenceSignBit) != 0U)
+            {
+                difference |= smallDifferenceSignExtension;
+            }
+        }
+        else
+        {
+            OUTCOME_TRY(auto largeDifference, reader.Read<8>());
+            difference = largeDifference.ToUnderlying();
+        }
+        byte = static_cast<Byte>(static_cast<std::uint8_t>(byte) + difference);
+    }
+    *compressedData = compressedData->subspan(reader.NReadBytes());
+    *record = decompressedRecord;
+    return outcome_v2::success();
+}
+
+
+namespace
+{
+BitWriter::BitWriter(CompressedTelemetryRecord * data) : data_(data)
+{}
+
+
+template<std::size_t nBits>
+auto BitWriter::Write(UInt<nBits> value) -> void
+{
+    for(auto i = nBits; i > 0; --i)
+    {
+        if(nUsedBits_ == CHAR_BIT)
+        {
+            data_->push_back(0x00_b);
+            nUsedBits_ = 0;
+        }
+        auto bit = (value.ToUnderlying() >> (i - 1)) & 1U;
+        data_->back() |= static_cast<Byte>(bit << (CHAR_BIT - 1 - nUsedBits_));
+        ++nUsedBits_;
+    }
+}
+
+
+BitReader::BitReader(std::span<Byte const> data) : data_(data)
+{}
+
+
+template<std::size_t nBits>
+auto BitReader::Read() -> Result<UInt<nBits>>
+{
+    if(nReadBits_ + nBits > data_.size() * CHAR_BIT)
+    {
+        return ErrorCode::bufferTooSmall;
+    }
+    auto value = typename UInt<nBits>::UnderlyingType{0};
+    for(auto i = 0U; i < nBits; ++i)
+    {
+        auto byte = static_cast<unsigned>(data_[nReadBits_ / CHAR_BIT]);
+        auto bit = (byte >> (CHAR_BIT - 1 - nReadBits_ % CHAR_BIT)) & 1U;
+        value = static_cast<decltype(value)>((value << 1U) | bit);
+        ++nReadBits_;
+    }
+    return UInt<nBits>(value);
+}
+
+
+auto BitReader::NReadBytes() const -> std::size_t
+{
+    return (nReadBits_ + CHAR_BIT - 1) / CHAR_BIT;
+}
+}
+}
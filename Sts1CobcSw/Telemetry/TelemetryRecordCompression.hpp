@@ -0,0 +1,39 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Serial/Serial.hpp>
+#include <Sts1CobcSw/Telemetry/TelemetryRecord.hpp>
+
+#include <etl/vector.h>
+
+#include <cstddef>
+#include <span>
+
+
+namespace sts1cobcsw
+{
+// Every byte of a compressed record takes at most 10 bits
+inline constexpr auto maxCompressedTelemetryRecordSize =
+    (serialSize<TelemetryRecord> * 10 + 7) / 8;  // NOLINT(*magic-numbers)
+
+using CompressedTelemetryRecord = etl::vector<Byte, maxCompressedTelemetryRecordSize>;
+
+
+// Consecutive telemetry records are taken 30 s apart, so most of their bytes do not change at all,
+// and most of the others change only a little. A record is therefore compressed as the difference
+// to a reference record, usually the previous one. Every byte of the serialized record is encoded
+// as
+//   - 0 if it did not change,
+//   - 10 followed by the difference as a 4-bit two's complement if it changed by -8 to 7,
+//   - 11 followed by the difference as an 8-bit two's complement otherwise.
+// The bits are written MSB first, and the last byte is padded with zeros.
+[[nodiscard]] auto Compress(SerialBuffer<TelemetryRecord> const & record,
+                            SerialBuffer<TelemetryRecord> const & reference)
+    -> CompressedTelemetryRecord;
+// Decompress the record at the beginning of compressedData and drop it from the span. The record
+// must contain the reference on input and contains the decompressed record on output.
+[[nodiscard]] auto Decompress(std::span<Byte const> * compressedData,
+                              SerialBuffer<TelemetryRecord> * record) -> Result<void>;
+}
@@ -0,0 +1,200 @@
+#include <Sts1CobcSw/TmTransmission/TmTransmission.hpp>
+
+#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
+#include <Sts1CobcSw/Mailbox/Mailbox.hpp>
+#include <Sts1CobcSw/Mailbox/RingQueue.hpp>
+#include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/Rf/Rf.hpp>
+#include <Sts1CobcSw/RfProtocols/Configuration.hpp>
+#include <Sts1CobcSw/RfProtocols/SpacePacket.hpp>
+#include <Sts1CobcSw/RfProtocols/TmTransferFrame.hpp>
+#include <Sts1CobcSw/RodosTime/RodosTime.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Utility/DebugPrint.hpp>
+
+#include <strong_type/affine_point.hpp>
+#include <strong_type/difference.hpp>
+#include <strong_type/ordered.hpp>
+#include <strong_type/type.hpp>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstdint>
+#include <span>
+
+
+namespace sts1cobcsw
+{
+namespace
+{
+auto tmBuffer = []()
+{
+    auto buffer = std::array<Byte, tm::channelAccessDataUnitLength>{};
+    if constexpr(attachedSynchMarkerLength == attachedSynchMarker.size())
+    {
+        std::ranges::copy(attachedSynchMarker, buffer.begin());
+    }
+    return buffer;
+}();
+auto tmFrame = tm::TransferFrame(
+    std::span(tmBuffer).subspan<attachedSynchMarkerLength, tm::transferFrameLength>());
+std::uint16_t nFramesToSend = 0U;
+std::uint16_t nSentFrames = 0U;
+
+
+// Return the part of the TM buffer that must be sent according to the current TX coding profile
+[[nodiscard]] auto PackageAndEncode(Payload const & report) -> std::span<Byte const>;
+[[nodiscard]] auto EncodeIdleFrame() -> std::span<Byte const>;
+[[nodiscard]] auto EncodeTmBuffer() -> std::span<Byte const>;
+auto SendAndWait(std::span<Byte const> encodedFrame) -> void;
+auto SendAndContinue(std::span<Byte const> encodedFrame) -> void;
+}
+
+
+auto FrameSendDuration() -> Duration
+{
+    auto fullyEncodedFrameLength =
+        static_cast<unsigned>(tm::FullyEncodedFrameLength(rf::GetTxCodingProfile()));
+    return fullyEncodedFrameLength * CHAR_BIT * s / rf::GetTxDataRate();
+}
+
+
+auto MaxNFramesToSendContinuously() -> std::uint16_t
+{
+    return static_cast<std::uint16_t>(
+        rf::maxTxDataLength / tm::FullyEncodedFrameLength(rf::GetTxCodingProfile()));
+}
+
+
+auto SetTxDataLength(std::uint16_t nFrames) -> void
+{
+    PrepareForTx();
+    nFramesToSend = nFrames;
+    nSentFrames = 0;
+    auto fullyEncodedFrameLength = tm::FullyEncodedFrameLength(rf::GetTxCodingProfile());
+    rf::SetTxDataLength(static_cast<std::uint16_t>(
+        std::min(nFrames, MaxNFramesToSendContinuously()) * fullyEncodedFrameLength));
+}
+
+
+auto SendAndWait(Payload const & report) -> void
+{
+    SendAndWait(PackageAndEncode(report));
+}
+
+
+auto SendAndContinue(Payload const & report) -> void
+{
+    SendAndContinue(PackageAndEncode(report));
+}
+
+
+auto FinalizeTransmission() -> void
+{
+    // TX FIFO buffer size <= 128 B, slowest data rate = 1.2 kbps → max. send time = 128 B * 8 b/B /
+    // 1200 b/s = 0.853 s → timeout = 1 s
+    static constexpr auto timeout = 1 * s;
+    rf::SuspendUntilDataSent(timeout);
+    rf::EnterStandbyMode();
+}
+
+
+// The queued frames are sent in continuous bursts instead of one transmission per frame. Every
+// transmission ends with the post-TX delay of the RF module, which costs almost as much as sending
+// a whole frame. The length of a burst must be known when it starts, so it contains all frames that
+// are queued at that time. While they are sent, the file transfer thread queues the next ones.
+auto SendCfdpFrames(CfdpFrameQueue * frameQueue,
+                    Mailbox<TelemetryRecord> * telemetryRecordMailbox,
+                    RodosTime sendWindowEnd) -> void
+{
+    auto frameSendDuration = FrameSendDuration();
+    // In case radiation affects the while condition, we add this additional check to stop once a
+    // new telemetry record is available
+    while(not frameQueue->IsEmpty() and not telemetryRecordMailbox->IsFull())
+    {
+        auto remainingSendDuration = sendWindowEnd - CurrentRodosTime();
+        auto nFramesThatFit = remainingSendDuration > Duration(0)
+                                ? remainingSendDuration / frameSendDuration
+                                : std::int64_t{0};
+        auto nFrames = static_cast<std::uint16_t>(
+            std::min({static_cast<std::int64_t>(frameQueue->Size()),
+                      nFramesThatFit,
+                      static_cast<std::int64_t>(MaxNFramesToSendContinuously())}));
+        if(nFrames == 0)
+        {
+            break;
+        }
+        SetTxDataLength(nFrames);
+        for(auto i = 0U; i < nFrames; ++i)
+        {
+            // This wakes up the file transfer thread if it is waiting for room for a new CFDP frame
+            auto getResult = frameQueue->Get();
+            if(getResult.has_error())
+            {
+                // The file transfer thread cleared the queue during the burst. The announced
+                // number of frames must still be sent, so the rest is filled with idle frames.
+                SendAndContinue(EncodeIdleFrame());
+                continue;
+            }
+            std::ranges::copy(getResult.value(), tmBuffer.begin() + attachedSynchMarkerLength);
+            SendAndContinue(EncodeTmBuffer());
+        }
+        FinalizeTransmission();
+    }
+}
+
+
+namespace
+{
+auto PackageAndEncode(Payload const & report) -> std::span<Byte const>
+{
+    tmFrame.StartNew(pusVcid);
+    auto result = AddSpacePacketTo(&tmFrame.GetDataField(), normalApid, report);
+    if(result.has_error())
+    {
+        DEBUG_PRINT("Failed to package report: %s\n", ToCZString(result.error()));
+    }
+    tmFrame.Finish();
+    return EncodeTmBuffer();
+}
+
+
+// An idle frame contains no packet, only idle data
+auto EncodeIdleFrame() -> std::span<Byte const>
+{
+    tmFrame.StartNew(pusVcid);
+    tmFrame.Finish();
+    return EncodeTmBuffer();
+}
+
+
+auto EncodeTmBuffer() -> std::span<Byte const>
+{
+    // This also writes the attached sync marker to the beginning of the buffer every time. That is
+    // good because the constant is stored in flash and therefore not corrupted as fast as the
+    // buffer in RAM.
+    return tm::EncodeChannelAccessDataUnit(tmBuffer, rf::GetTxCodingProfile());
+}
+
+
+auto SendAndWait(std::span<Byte const> encodedFrame) -> void
+{
+    PrepareForTx();
+    rf::SendAndWait(encodedFrame);
+}
+
+
+auto SendAndContinue(std::span<Byte const> encodedFrame) -> void
+{
+    if(nSentFrames >= MaxNFramesToSendContinuously())
+    {
+        FinalizeTransmission();
+        SetTxDataLength(nFramesToSend - nSentFrames);
+    }
+    PrepareForTx();
+    rf::SendAndContinue(encodedFrame);
+    ++nSentFrames;
+}
+}
+}
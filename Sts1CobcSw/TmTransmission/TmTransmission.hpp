@@ -0,0 +1,46 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Mailbox/Mailbox.hpp>
+#include <Sts1CobcSw/Mailbox/RingQueue.hpp>
+#include <Sts1CobcSw/RfProtocols/Configuration.hpp>
+#include <Sts1CobcSw/RfProtocols/Payload.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Telemetry/TelemetryRecord.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <array>
+#include <cstdint>
+
+
+// Everything the RF communication thread sends goes through these functions. They package reports
+// into TM transfer frames, apply the current TX coding profile, and send several frames in one
+// continuous transmission if possible.
+namespace sts1cobcsw
+{
+// The frames are only channel encoded right before sending so that the current TX coding profile is
+// applied. The queue lets the file transfer thread read and package the next frames from the flash
+// while the RF communication thread is still sending the previous ones.
+inline constexpr auto cfdpFrameQueueCapacity = 8U;
+using CfdpFrameQueue =
+    RingQueue<std::array<Byte, tm::transferFrameLength>, cfdpFrameQueueCapacity>;
+
+
+[[nodiscard]] auto FrameSendDuration() -> Duration;
+[[nodiscard]] auto MaxNFramesToSendContinuously() -> std::uint16_t;
+// Must be called before SendAndContinue()
+auto SetTxDataLength(std::uint16_t nFrames) -> void;
+auto SendAndWait(Payload const & report) -> void;
+auto SendAndContinue(Payload const & report) -> void;
+// Must be called after SendAndContinue()
+auto FinalizeTransmission() -> void;
+// Send the queued CFDP frames until the queue is empty, a new telemetry record is available in the
+// mailbox, or no more frame fits before sendWindowEnd
+auto SendCfdpFrames(CfdpFrameQueue * frameQueue,
+                    Mailbox<TelemetryRecord> * telemetryRecordMailbox,
+                    RodosTime sendWindowEnd) -> void;
+
+// Is called before anything is sent. It must stop all receptions and wait until the ground station
+// is ready to receive. The RF communication thread defines it.
+auto PrepareForTx() -> void;
+}
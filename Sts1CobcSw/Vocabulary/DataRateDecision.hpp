@@ -0,0 +1,16 @@
+#pragma once
+
+
+#include <cstdint>
+
+
+namespace sts1cobcsw::rf
+{
+enum class DataRateDecision : std::uint8_t
+{
+    keep,
+    stepUp,
+    stepDown,
+    clampToBounds,
+};
+}
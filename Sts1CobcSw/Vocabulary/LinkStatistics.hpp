@@ -0,0 +1,66 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Serial/Serial.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sts1cobcsw
+{
+namespace rf
+{
+// Received bytes are suspect if the current RSSI is below this raw value, and the uplink is too weak
+// if the mean RSSI is. It is -114 dBm, which lies between the sensitivities of the RF module at
+// 500 bps (-126 dBm) and 40 kbps (-110 dBm), i.e., bit errors become likely below it at our data
+// rates.
+inline constexpr std::uint8_t minRssi = 40;
+
+
+// Statistics about the quality of the RF link during the current pass. Each received frame adds one
+// sample, which is the mean over all chunks of the frame. RSSI and AFC frequency offset are the raw
+// values of the RF module. With MODEM_RSSI_COMP = 0x40, the RSSI in dBm is value / 2 - 134.
+struct LinkStatistics
+{
+    std::uint16_t nSamples = 0;
+    std::uint8_t minRssi = 0;
+    std::uint8_t meanRssi = 0;
+    std::uint8_t maxRssi = 0;
+    std::int16_t minAfcOffset = 0;
+    std::int16_t meanAfcOffset = 0;
+    std::int16_t maxAfcOffset = 0;
+    std::uint16_t nRxFifoOverflows = 0;
+    std::uint16_t nTxFifoUnderruns = 0;
+    std::uint32_t nReceivedBytes = 0;
+    std::uint32_t nSentBytes = 0;
+
+    friend auto operator==(LinkStatistics const &, LinkStatistics const &) -> bool = default;
+};
+
+
+template<std::endian endianness>
+[[nodiscard]] auto DeserializeFrom(void const * source, LinkStatistics * data) -> void const *;
+template<std::endian endianness>
+[[nodiscard]] auto SerializeTo(void * destination, LinkStatistics const & data) -> void *;
+}
+
+
+template<>
+inline constexpr std::size_t serialSize<rf::LinkStatistics> =
+    totalSerialSize<decltype(rf::LinkStatistics::nSamples),
+                    decltype(rf::LinkStatistics::minRssi),
+                    decltype(rf::LinkStatistics::meanRssi),
+                    decltype(rf::LinkStatistics::maxRssi),
+                    decltype(rf::LinkStatistics::minAfcOffset),
+                    decltype(rf::LinkStatistics::meanAfcOffset),
+                    decltype(rf::LinkStatistics::maxAfcOffset),
+                    decltype(rf::LinkStatistics::nRxFifoOverflows),
+                    decltype(rf::LinkStatistics::nTxFifoUnderruns),
+                    decltype(rf::LinkStatistics::nReceivedBytes),
+                    decltype(rf::LinkStatistics::nSentBytes)>;
+}
+
+
+#include <Sts1CobcSw/Vocabulary/LinkStatistics.ipp>  // IWYU pragma: keep
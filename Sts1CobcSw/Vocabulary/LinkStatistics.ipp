@@ -0,0 +1,45 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Vocabulary/LinkStatistics.hpp>
+
+
+namespace sts1cobcsw::rf
+{
+template<std::endian endianness>
+auto DeserializeFrom(void const * source, LinkStatistics * data) -> void const *
+{
+    using sts1cobcsw::DeserializeFrom;
+
+    source = DeserializeFrom<endianness>(source, &data->nSamples);
+    source = DeserializeFrom<endianness>(source, &data->minRssi);
+    source = DeserializeFrom<endianness>(source, &data->meanRssi);
+    source = DeserializeFrom<endianness>(source, &data->maxRssi);
+    source = DeserializeFrom<endianness>(source, &data->minAfcOffset);
+    source = DeserializeFrom<endianness>(source, &data->meanAfcOffset);
+    source = DeserializeFrom<endianness>(source, &data->maxAfcOffset);
+    source = DeserializeFrom<endianness>(source, &data->nRxFifoOverflows);
+    source = DeserializeFrom<endianness>(source, &data->nTxFifoUnderruns);
+    source = DeserializeFrom<endianness>(source, &data->nReceivedBytes);
+    return DeserializeFrom<endianness>(source, &data->nSentBytes);
+}
+
+
+template<std::endian endianness>
+auto SerializeTo(void * destination, LinkStatistics const & data) -> void *
+{
+    using sts1cobcsw::SerializeTo;
+
+    destination = SerializeTo<endianness>(destination, data.nSamples);
+    destination = SerializeTo<endianness>(destination, data.minRssi);
+    destination = SerializeTo<endianness>(destination, data.meanRssi);
+    destination = SerializeTo<endianness>(destination, data.maxRssi);
+    destination = SerializeTo<endianness>(destination, data.minAfcOffset);
+    destination = SerializeTo<endianness>(destination, data.meanAfcOffset);
+    destination = SerializeTo<endianness>(destination, data.maxAfcOffset);
+    destination = SerializeTo<endianness>(destination, data.nRxFifoOverflows);
+    destination = SerializeTo<endianness>(destination, data.nTxFifoUnderruns);
+    destination = SerializeTo<endianness>(destination, data.nReceivedBytes);
+    return SerializeTo<endianness>(destination, data.nSentBytes);
+}
+}
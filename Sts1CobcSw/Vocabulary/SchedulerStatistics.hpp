@@ -0,0 +1,52 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Serial/Serial.hpp>
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+
+namespace sts1cobcsw
+{
+namespace rf
+{
+// All counters and durations are totals since the start and saturate instead of overflowing
+struct SchedulerStatistics
+{
+    std::uint16_t nHousekeepingSlots = 0;
+    std::uint16_t nRxSlots = 0;
+    // RX slots that were shortened to send waiting CFDP frames since the ground was not active
+    std::uint16_t nShortenedRxSlots = 0;
+    std::uint16_t nCfdpSlots = 0;
+    std::uint16_t nIdleSlots = 0;
+    std::uint32_t rxDurationInS = 0;
+    std::uint32_t cfdpDurationInS = 0;
+
+    friend auto operator==(SchedulerStatistics const &, SchedulerStatistics const &) -> bool =
+        default;
+};
+
+
+template<std::endian endianness>
+[[nodiscard]] auto DeserializeFrom(void const * source, SchedulerStatistics * data)
+    -> void const *;
+template<std::endian endianness>
+[[nodiscard]] auto SerializeTo(void * destination, SchedulerStatistics const & data) -> void *;
+}
+
+
+template<>
+inline constexpr std::size_t serialSize<rf::SchedulerStatistics> =
+    totalSerialSize<decltype(rf::SchedulerStatistics::nHousekeepingSlots),
+                    decltype(rf::SchedulerStatistics::nRxSlots),
+                    decltype(rf::SchedulerStatistics::nShortenedRxSlots),
+                    decltype(rf::SchedulerStatistics::nCfdpSlots),
+                    decltype(rf::SchedulerStatistics::nIdleSlots),
+                    decltype(rf::SchedulerStatistics::rxDurationInS),
+                    decltype(rf::SchedulerStatistics::cfdpDurationInS)>;
+}
+
+
+#include <Sts1CobcSw/Vocabulary/SchedulerStatistics.ipp>  // IWYU pragma: keep
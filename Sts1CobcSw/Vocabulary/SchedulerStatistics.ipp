@@ -0,0 +1,37 @@
+#pragma once
+
+
+#include <Sts1CobcSw/Vocabulary/SchedulerStatistics.hpp>
+
+
+namespace sts1cobcsw::rf
+{
+template<std::endian endianness>
+auto DeserializeFrom(void const * source, SchedulerStatistics * data) -> void const *
+{
+    using sts1cobcsw::DeserializeFrom;
+
+    source = DeserializeFrom<endianness>(source, &data->nHousekeepingSlots);
+    source = DeserializeFrom<endianness>(source, &data->nRxSlots);
+    source = DeserializeFrom<endianness>(source, &data->nShortenedRxSlots);
+    source = DeserializeFrom<endianness>(source, &data->nCfdpSlots);
+    source = DeserializeFrom<endianness>(source, &data->nIdleSlots);
+    source = DeserializeFrom<endianness>(source, &data->rxDurationInS);
+    return DeserializeFrom<endianness>(source, &data->cfdpDurationInS);
+}
+
+
+template<std::endian endianness>
+auto SerializeTo(void * destination, SchedulerStatistics const & data) -> void *
+{
+    using sts1cobcsw::SerializeTo;
+
+    destination = SerializeTo<endianness>(destination, data.nHousekeepingSlots);
+    destination = SerializeTo<endianness>(destination, data.nRxSlots);
+    destination = SerializeTo<endianness>(destination, data.nShortenedRxSlots);
+    destination = SerializeTo<endianness>(destination, data.nCfdpSlots);
+    destination = SerializeTo<endianness>(destination, data.nIdleSlots);
+    destination = SerializeTo<endianness>(destination, data.rxDurationInS);
+    return SerializeTo<endianness>(destination, data.cfdpDurationInS);
+}
+}
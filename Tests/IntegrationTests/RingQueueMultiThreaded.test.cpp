@@ -0,0 +1,86 @@
+#include <Sts1CobcSw/Mailbox/RingQueue.hpp>
+#include <Sts1CobcSw/RodosTime/RodosTime.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <strong_type/affine_point.hpp>
+#include <strong_type/difference.hpp>
+#include <strong_type/type.hpp>
+
+#include <rodos_no_using_namespace.h>
+
+#include <cstdlib>
+#include <utility>
+
+
+namespace sts1cobcsw
+{
+namespace
+{
+constexpr auto nMessages = 20;
+
+auto queue = RingQueue<int, 4>{};
+auto errorCounter = 0;
+
+
+// The producer is faster than the consumer, so it has to wait for room in the queue most of the
+// time
+class Producer : public RODOS::StaticThread<>
+{
+    void run() override
+    {
+        for(auto counter = 0; counter < nMessages; ++counter)
+        {
+            auto result = queue.SuspendUntilNotFullOr(CurrentRodosTime() + 15 * ms);
+            if(result.has_error())
+            {
+                errorCounter++;
+            }
+            result = queue.Put(counter);
+            if(result.has_error())
+            {
+                errorCounter++;
+            }
+        }
+    }
+} producer;
+
+
+class Consumer : public RODOS::StaticThread<>
+{
+    void run() override
+    {
+        SuspendFor(10 * ms);
+        for(auto counter = 0; counter < nMessages; ++counter)
+        {
+            auto result = queue.SuspendUntilNotEmptyOr(CurrentRodosTime() + 15 * ms);
+            if(result.has_error())
+            {
+                errorCounter++;
+            }
+            auto value = queue.Get();
+            if(value.has_error() or value.value() != counter)
+            {
+                errorCounter++;
+            }
+            SuspendFor(1 * ms);
+        }
+        // Once the producer is done, the consumer must wait until the timeout
+        auto result = queue.SuspendUntilNotEmptyOr(CurrentRodosTime() + 5 * ms);
+        if(result.has_value())
+        {
+            errorCounter++;
+        }
+        if(errorCounter == 0)
+        {
+            RODOS::PRINTF("Test passed\n");
+        }
+        else
+        {
+            RODOS::PRINTF("Test failed with %d errors\n", errorCounter);
+        }
+        RODOS::isShuttingDown = true;
+        std::exit(errorCounter);  // NOLINT(concurrency-mt-unsafe)
+    }
+} consumer;
+}
+}
@@ -0,0 +1,104 @@
+#include <Sts1CobcSw/Hal/DmaSpiMock.hpp>
+#include <Sts1CobcSw/Hal/Spi.hpp>
+#include <Sts1CobcSw/RodosTime/RodosTime.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <strong_type/affine_point.hpp>
+#include <strong_type/difference.hpp>
+#include <strong_type/type.hpp>
+
+#include <rodos_no_using_namespace.h>
+
+#include <array>
+#include <cstdint>
+#include <cstdlib>
+#include <span>
+#include <utility>
+
+
+namespace sts1cobcsw
+{
+namespace
+{
+// Same as the RF SPI
+constexpr auto baudRate = 6'000'000;
+constexpr auto dmaSetupDuration = 5 * us;
+// A flash page
+constexpr auto transferSize = 256U;
+constexpr auto nTransfers = 100;
+
+auto spi = hal::DmaSpiMock{};
+// Counts how often the low-priority thread got to run
+std::int64_t volatile nBackgroundIterations = 0;
+
+
+[[nodiscard]] auto MeasureBackgroundIterations(bool useDma) -> std::int64_t;
+
+
+class SpiUser : public RODOS::StaticThread<>
+{
+public:
+    SpiUser() : StaticThread("SpiUser", 200)
+    {}
+
+
+private:
+    void run() override
+    {
+        spi.SetLatency(baudRate, dmaSetupDuration);
+        auto nIterationsWithoutDma = MeasureBackgroundIterations(/*useDma=*/false);
+        auto nIterationsWithDma = MeasureBackgroundIterations(/*useDma=*/true);
+        RODOS::PRINTF("Background iterations without DMA: %lld\n",
+                      static_cast<long long>(nIterationsWithoutDma));  // NOLINT(*runtime-int)
+        RODOS::PRINTF("Background iterations with DMA:    %lld\n",
+                      static_cast<long long>(nIterationsWithDma));  // NOLINT(*runtime-int)
+        auto nErrors = 0;
+        if(spi.NTransferredBytes() != 2U * nTransfers * transferSize)
+        {
+            RODOS::PRINTF("Not all bytes were transferred\n");
+            ++nErrors;
+        }
+        if(nIterationsWithDma <= nIterationsWithoutDma)
+        {
+            RODOS::PRINTF("The DMA did not leave more CPU time to the background thread\n");
+            ++nErrors;
+        }
+        RODOS::PRINTF(nErrors == 0 ? "Test passed\n" : "Test failed\n");
+        RODOS::isShuttingDown = true;
+        std::exit(nErrors);  // NOLINT(concurrency-mt-unsafe)
+    }
+} spiUser;
+
+
+class BackgroundThread : public RODOS::StaticThread<>
+{
+public:
+    BackgroundThread() : StaticThread("BackgroundThread", 100)
+    {}
+
+
+private:
+    void run() override
+    {
+        while(true)
+        {
+            nBackgroundIterations = nBackgroundIterations + 1;
+        }
+    }
+} backgroundThread;
+
+
+auto MeasureBackgroundIterations(bool useDma) -> std::int64_t
+{
+    auto data = std::array<Byte, transferSize>{};
+    spi.SetUseDma(useDma);
+    auto nIterationsBefore = nBackgroundIterations;
+    for(auto i = 0; i < nTransfers; ++i)
+    {
+        hal::WriteTo(&spi, std::span<Byte const>(data), 10 * ms);
+    }
+    return nBackgroundIterations - nIterationsBefore;
+}
+}
+}
@@ -0,0 +1,441 @@
+#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
+#include <Sts1CobcSw/ChannelCoding/External/ConvolutionalCoding.hpp>
+#include <Sts1CobcSw/ChannelCoding/FrameEncoder.hpp>
+#include <Sts1CobcSw/ChannelCoding/ReedSolomon.hpp>
+#include <Sts1CobcSw/ChannelCoding/Scrambler.hpp>
+#include <Sts1CobcSw/ChannelCoding/ViterbiDecoder.hpp>
+#include <Sts1CobcSw/RodosTime/RodosTime.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <libfec/fec.h>
+// The macro FCR that is defined in libfec/fec.h clashes with a struct member name in a CMSIS
+// header. Since we don't need the FCR macro, we can undefine it here to avoid the clash.
+#undef FCR
+#include <strong_type/difference.hpp>
+#include <strong_type/type.hpp>
+
+#include <rodos_no_using_namespace.h>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+namespace sts1cobcsw
+{
+namespace
+{
+using RODOS::PRINTF;
+
+
+constexpr auto stackSize = 10'000;
+constexpr auto nIterations = 100U;
+// The TX FIFO of the Si4463 is 64 bytes large and refilled when 48 bytes are free
+constexpr auto txFifoChunkSize = 48U;
+
+
+auto BenchmarkReedSolomon() -> void;
+auto BenchmarkScrambler() -> void;
+auto BenchmarkTmPipeline() -> void;
+// Encode a channel access data unit like the TM path did before the FrameEncoder existed: RS
+// encoding, copying the sync marker, scrambling, and convolutional coding of FIFO-sized chunks into
+// temporary vectors
+auto EncodeFrameTheOldWay(std::span<Byte, tm::channelAccessDataUnitLength> channelAccessDataUnit)
+    -> std::size_t;
+auto EncodeFrameWithPipeline(std::span<Byte, tm::channelAccessDataUnitLength> channelAccessDataUnit)
+    -> std::size_t;
+auto EnableCycleCounter() -> void;
+auto ReadCycleCounter() -> std::uint32_t;
+auto PrintThroughput(char const * name, Duration duration, std::size_t nBytes) -> void;
+auto PrintCycles(std::uint32_t nCycles, std::size_t nBytes) -> void;
+// Call function() nIterations times and print the throughput and cycles per byte
+template<typename Function>
+auto Measure(char const * name, std::size_t nBytes, Function function) -> void;
+
+
+class ChannelCodingBenchmarkThread : public RODOS::StaticThread<stackSize>
+{
+public:
+    ChannelCodingBenchmarkThread() : StaticThread("ChannelCodingBenchmarkThread")
+    {}
+
+
+private:
+    auto run() -> void override
+    {
+        PRINTF("\n");
+        PRINTF("Channel coding benchmark\n");
+        PRINTF("\n");
+
+        // Convolutional coding is benchmarked with a non-interleaved channel access data unit
+        auto frame = std::array<Byte, cc::ViterbiCodec::maxUnencodedSize>{};
+        for(auto i = 0U; i < frame.size(); ++i)
+        {
+            frame[i] = static_cast<Byte>(i * 7U);
+        }
+        auto encoder = cc::ViterbiCodec();
+        PRINTF("Convolutional-encoding %u x %u B ...\n",
+               nIterations,
+               static_cast<unsigned int>(frame.size()));
+        auto begin = CurrentRodosTime();
+        for(auto i = 0U; i < nIterations; ++i)
+        {
+            (void)encoder.Encode(frame, /*flush=*/true);
+        }
+        auto end = CurrentRodosTime();
+        PrintThroughput("encoded", end - begin, nIterations * frame.size());
+        auto encodedFrame = encoder.Encode(frame, /*flush=*/true);
+
+        auto decoder = cc::ViterbiDecoder();
+        auto decodedFrame = std::array<Byte, cc::ViterbiCodec::maxUnencodedSize>{};
+        PRINTF("Viterbi-decoding %u x %u B (hard decisions) ...\n",
+               nIterations,
+               static_cast<unsigned int>(encodedFrame.size()));
+        begin = CurrentRodosTime();
+        for(auto i = 0U; i < nIterations; ++i)
+        {
+            (void)decoder.Decode(encodedFrame, decodedFrame);
+        }
+        end = CurrentRodosTime();
+        PrintThroughput("decoded", end - begin, nIterations * decodedFrame.size());
+        PRINTF("  %s\n", decodedFrame == frame ? "correct" : "WRONG");
+
+        static auto softBits = std::array<cc::ViterbiDecoder::SoftBit,
+                                          cc::ViterbiCodec::maxEncodedSize * CHAR_BIT>{};
+        auto nSoftBits = encodedFrame.size() * CHAR_BIT;
+        for(auto i = 0U; i < nSoftBits; ++i)
+        {
+            auto bit = (static_cast<unsigned>(encodedFrame[i / CHAR_BIT])
+                        >> (CHAR_BIT - 1U - (i % CHAR_BIT)))
+                     & 1U;
+            softBits[i] = bit == 1U ? 6 : 1;
+        }
+        PRINTF("Viterbi-decoding %u x %u soft bits ...\n",
+               nIterations,
+               static_cast<unsigned int>(nSoftBits));
+        begin = CurrentRodosTime();
+        for(auto i = 0U; i < nIterations; ++i)
+        {
+            (void)decoder.DecodeSoft(std::span(softBits).first(nSoftBits), decodedFrame);
+        }
+        end = CurrentRodosTime();
+        PrintThroughput("decoded", end - begin, nIterations * decodedFrame.size());
+        PRINTF("  %s\n", decodedFrame == frame ? "correct" : "WRONG");
+        PRINTF("\n");
+
+        BenchmarkReedSolomon();
+        PRINTF("\n");
+        BenchmarkScrambler();
+        PRINTF("\n");
+        BenchmarkTmPipeline();
+        PRINTF("\n");
+    }
+} channelCodingBenchmarkThread;
+
+
+// To measure the peak stack usage of the two TM paths in isolation, each one runs once in its own
+// thread after the benchmark thread is done
+template<auto encodeFrame>
+class StackUsageThread : public RODOS::StaticThread<stackSize>
+{
+public:
+    StackUsageThread(char const * name, std::int32_t priority)
+        : StaticThread(name, priority), name_(name)
+    {}
+
+
+private:
+    char const * name_;
+
+    auto run() -> void override
+    {
+        auto channelAccessDataUnit = std::array<Byte, tm::channelAccessDataUnitLength>{};
+        (void)encodeFrame(channelAccessDataUnit);
+        PRINTF("Peak stack usage of %s: %u B\n",
+               name_,
+               static_cast<unsigned int>(RODOS::Thread::getCurrentThread()->getMaxStackUsage()));
+    }
+};
+
+
+auto oldTmPathThread = StackUsageThread<EncodeFrameTheOldWay>("old TM path", 90);
+auto tmPipelineThread = StackUsageThread<EncodeFrameWithPipeline>("TM pipeline", 80);
+
+
+// NOLINTBEGIN(*reinterpret-cast)
+auto BenchmarkReedSolomon() -> void
+{
+    EnableCycleCounter();
+    static auto block = std::array<Byte, rs::blockLength>{};
+    for(auto i = 0U; i < block.size(); ++i)
+    {
+        block[i] = static_cast<Byte>(i * 13U);
+    }
+    auto * data = reinterpret_cast<unsigned char *>(block.data());
+
+    PRINTF("Reed-Solomon-encoding %u x %u B with libfec ...\n",
+           nIterations,
+           static_cast<unsigned int>(rs::messageLength));
+    Measure("encoded",
+            rs::messageLength,
+            [&]() { encode_rs_ccsds(data, data + rs::messageLength); });
+    PRINTF("Reed-Solomon-encoding %u x %u B in-tree ...\n",
+           nIterations,
+           static_cast<unsigned int>(rs::messageLength));
+    Measure("encoded",
+            rs::messageLength,
+            [&]()
+            {
+                rs::Encode(std::span(block).first<rs::messageLength>(),
+                           std::span(block).last<rs::nParitySymbols>());
+            });
+
+    PRINTF("Reed-Solomon-decoding %u x %u B without errors with libfec ...\n",
+           nIterations,
+           static_cast<unsigned int>(rs::blockLength));
+    Measure("decoded", rs::blockLength, [&]() { (void)decode_rs_ccsds(data); });
+    PRINTF("Reed-Solomon-decoding %u x %u B without errors in-tree ...\n",
+           nIterations,
+           static_cast<unsigned int>(rs::blockLength));
+    Measure("decoded", rs::blockLength, [&]() { (void)rs::Decode(block); });
+
+    // Every iteration must start with the corrupted block, so copying it is part of the measurement
+    static auto corruptedBlock = block;
+    for(auto i = 0U; i < rs::nParitySymbols / 2; ++i)
+    {
+        corruptedBlock[i * 15U] ^= 0xA5_b;
+    }
+    PRINTF("Reed-Solomon-decoding %u x %u B with %u errors with libfec ...\n",
+           nIterations,
+           static_cast<unsigned int>(rs::blockLength),
+           static_cast<unsigned int>(rs::nParitySymbols / 2));
+    Measure("decoded",
+            rs::blockLength,
+            [&]()
+            {
+                block = corruptedBlock;
+                (void)decode_rs_ccsds(data);
+            });
+    PRINTF("Reed-Solomon-decoding %u x %u B with %u errors in-tree ...\n",
+           nIterations,
+           static_cast<unsigned int>(rs::blockLength),
+           static_cast<unsigned int>(rs::nParitySymbols / 2));
+    auto nCorrectedErrors = 0;
+    Measure("decoded",
+            rs::blockLength,
+            [&]()
+            {
+                block = corruptedBlock;
+                nCorrectedErrors = rs::Decode(block).value();
+            });
+    PRINTF("  %s\n", nCorrectedErrors == rs::nParitySymbols / 2 ? "correct" : "WRONG");
+}
+// NOLINTEND(*reinterpret-cast)
+
+
+auto BenchmarkScrambler() -> void
+{
+    // Scrambling zeros yields the scrambling sequence itself
+    static auto sequence = std::array<Byte, rs::blockLength>{};
+    tm::Scramble(sequence);
+    static auto channelAccessDataUnit = std::array<Byte, tm::channelAccessDataUnitLength>{};
+    auto block = std::span(channelAccessDataUnit).last<tm::blockLength>();
+
+    PRINTF("Scrambling %u x %u B byte by byte with modulo ...\n",
+           nIterations,
+           static_cast<unsigned int>(block.size()));
+    auto begin = CurrentRodosTime();
+    for(auto i = 0U; i < nIterations; ++i)
+    {
+        for(auto j = 0U; j < block.size(); ++j)
+        {
+            block[j] ^= sequence[j % sequence.size()];
+        }
+    }
+    auto end = CurrentRodosTime();
+    PrintThroughput("scrambled", end - begin, nIterations * block.size());
+
+    PRINTF("Scrambling %u x %u B word-wise ...\n",
+           nIterations,
+           static_cast<unsigned int>(block.size()));
+    begin = CurrentRodosTime();
+    for(auto i = 0U; i < nIterations; ++i)
+    {
+        tm::Scramble(block);
+    }
+    end = CurrentRodosTime();
+    PrintThroughput("scrambled", end - begin, nIterations * block.size());
+
+    PRINTF("Scrambling %u x %u B at an unaligned address ...\n",
+           nIterations,
+           static_cast<unsigned int>(block.size() - 1U));
+    begin = CurrentRodosTime();
+    for(auto i = 0U; i < nIterations; ++i)
+    {
+        tm::Scramble(block.subspan(1));
+    }
+    end = CurrentRodosTime();
+    PrintThroughput("scrambled", end - begin, nIterations * (block.size() - 1U));
+
+    PRINTF("Encoding %u x %u B channel access data units (RS + sync marker + scrambling) ...\n",
+           nIterations,
+           static_cast<unsigned int>(channelAccessDataUnit.size()));
+    begin = CurrentRodosTime();
+    for(auto i = 0U; i < nIterations; ++i)
+    {
+        tm::EncodeChannelAccessDataUnit(channelAccessDataUnit);
+    }
+    end = CurrentRodosTime();
+    PrintThroughput("encoded", end - begin, nIterations * channelAccessDataUnit.size());
+}
+
+
+auto BenchmarkTmPipeline() -> void
+{
+    EnableCycleCounter();
+    static auto channelAccessDataUnit = std::array<Byte, tm::channelAccessDataUnitLength>{};
+    auto nEncodedBytes = EncodeFrameTheOldWay(channelAccessDataUnit);
+
+    PRINTF("Encoding %u x %u B frames the old way (vectors) ...\n",
+           nIterations,
+           static_cast<unsigned int>(nEncodedBytes));
+    auto beginCycles = ReadCycleCounter();
+    auto begin = CurrentRodosTime();
+    for(auto i = 0U; i < nIterations; ++i)
+    {
+        (void)EncodeFrameTheOldWay(channelAccessDataUnit);
+    }
+    auto end = CurrentRodosTime();
+    auto endCycles = ReadCycleCounter();
+    PrintThroughput("encoded", end - begin, nIterations * nEncodedBytes);
+    PrintCycles(endCycles - beginCycles, nIterations * nEncodedBytes);
+
+    nEncodedBytes = EncodeFrameWithPipeline(channelAccessDataUnit);
+    PRINTF("Encoding %u x %u B frames with the pipeline (%u B chunks) ...\n",
+           nIterations,
+           static_cast<unsigned int>(nEncodedBytes),
+           txFifoChunkSize);
+    beginCycles = ReadCycleCounter();
+    begin = CurrentRodosTime();
+    for(auto i = 0U; i < nIterations; ++i)
+    {
+        (void)EncodeFrameWithPipeline(channelAccessDataUnit);
+    }
+    end = CurrentRodosTime();
+    endCycles = ReadCycleCounter();
+    PrintThroughput("encoded", end - begin, nIterations * nEncodedBytes);
+    PrintCycles(endCycles - beginCycles, nIterations * nEncodedBytes);
+}
+
+
+auto EncodeFrameTheOldWay(std::span<Byte, tm::channelAccessDataUnitLength> channelAccessDataUnit)
+    -> std::size_t
+{
+    auto block = channelAccessDataUnit.last<tm::blockLength>();
+    tm::Encode(block);
+    std::ranges::copy(std::span(attachedSynchMarker).first(attachedSynchMarkerLength),
+                      channelAccessDataUnit.begin());
+    tm::Scramble(block);
+    auto convolutionalCoder = cc::ViterbiCodec();
+    auto chunkSize = cc::ViterbiCodec::UnencodedSize(
+        txFifoChunkSize, /*withFlushBits=*/true, convolutionalCoder.GetCodeRate());
+    auto nEncodedBytes = std::size_t{0};
+    auto dataIndex = 0U;
+    while(dataIndex + chunkSize < channelAccessDataUnit.size())
+    {
+        auto encodedChunk = convolutionalCoder.Encode(
+            channelAccessDataUnit.subspan(dataIndex, chunkSize), /*flush=*/false);
+        nEncodedBytes += encodedChunk.size();
+        dataIndex += chunkSize;
+    }
+    auto encodedData =
+        convolutionalCoder.Encode(channelAccessDataUnit.subspan(dataIndex), /*flush=*/true);
+    return nEncodedBytes + encodedData.size();
+}
+
+
+auto EncodeFrameWithPipeline(std::span<Byte, tm::channelAccessDataUnitLength> channelAccessDataUnit)
+    -> std::size_t
+{
+    auto frameEncoder = tm::FrameEncoder();
+    frameEncoder.Start(channelAccessDataUnit);
+    auto buffer = std::array<Byte, txFifoChunkSize>{};
+    auto nEncodedBytes = std::size_t{0};
+    while(not frameEncoder.IsDone())
+    {
+        nEncodedBytes += frameEncoder.Read(buffer);
+    }
+    return nEncodedBytes;
+}
+
+
+#ifdef __arm__
+// The DWT cycle counter of the Cortex-M4
+auto * const demcr = reinterpret_cast<std::uint32_t volatile *>(0xE000'EDFC);  // NOLINT
+auto * const dwtControl = reinterpret_cast<std::uint32_t volatile *>(0xE000'1000);  // NOLINT
+auto * const dwtCycleCount = reinterpret_cast<std::uint32_t volatile *>(0xE000'1004);  // NOLINT
+#endif
+
+
+auto EnableCycleCounter() -> void
+{
+#ifdef __arm__
+    *demcr = *demcr | (1U << 24U);  // TRCENA
+    *dwtCycleCount = 0;
+    *dwtControl = *dwtControl | 1U;  // CYCCNTENA
+#endif
+}
+
+
+auto ReadCycleCounter() -> std::uint32_t
+{
+#ifdef __arm__
+    return *dwtCycleCount;
+#else
+    return 0;
+#endif
+}
+
+
+auto PrintThroughput(char const * name, Duration duration, std::size_t nBytes) -> void
+{
+    auto durationInUs = static_cast<std::uint64_t>(duration / us);
+    PRINTF("  took %u us -> %u B/s %s\n",
+           static_cast<unsigned int>(durationInUs),
+           static_cast<unsigned int>(durationInUs == 0 ? 0 : nBytes * 1'000'000ULL / durationInUs),
+           name);
+}
+
+
+template<typename Function>
+auto Measure(char const * name, std::size_t nBytes, Function function) -> void
+{
+    auto beginCycles = ReadCycleCounter();
+    auto begin = CurrentRodosTime();
+    for(auto i = 0U; i < nIterations; ++i)
+    {
+        function();
+    }
+    auto end = CurrentRodosTime();
+    auto endCycles = ReadCycleCounter();
+    PrintThroughput(name, end - begin, nIterations * nBytes);
+    PrintCycles(endCycles - beginCycles, nIterations * nBytes);
+}
+
+
+auto PrintCycles([[maybe_unused]] std::uint32_t nCycles, [[maybe_unused]] std::size_t nBytes)
+    -> void
+{
+#ifdef __arm__
+    PRINTF("  took %u cycles -> %u.%02u cycles/B\n",
+           static_cast<unsigned int>(nCycles),
+           static_cast<unsigned int>(nCycles / nBytes),
+           static_cast<unsigned int>(nCycles % nBytes * 100U / nBytes));
+#endif
+}
+}
+}
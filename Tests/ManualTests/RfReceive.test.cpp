@@ -73,7 +73,7 @@ auto Receive(std::uint32_t baudRate) -> void
     PRINTF("Receiving with %i baud\n", static_cast<int>(baudRate));
     rf::SetRxDataRate(baudRate);
 
-    auto receivedData = std::array<Byte, blockLength>{};
+    auto receivedData = std::array<Byte, tc::blockLength>{};
     static constexpr auto rxTimeout = 5 * s;
     PRINTF("Waiting %i s to receive %i bytes\n",
            static_cast<int>(rxTimeout / s),
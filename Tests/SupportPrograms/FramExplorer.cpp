@@ -363,6 +363,7 @@ auto PrintAllVariables() -> void
     PrintVariable("nUncorrectableUplinkErrors");
     PrintVariable("nGoodTransferFrames");
     PrintVariable("nBadTransferFrames");
+    PrintVariable("nDroppedPdus");
     PrintVariable("lastFrameSequenceNumber");
     PrintVariable("lastMessageTypeId");
     PrintVariable("lastMessageTypeIdWasInvalid");
@@ -402,6 +403,7 @@ auto ResetAllVariables() -> void
     persistentVariables.Store<"nUncorrectableUplinkErrors">(0);
     persistentVariables.Store<"nGoodTransferFrames">(0);
     persistentVariables.Store<"nBadTransferFrames">(0);
+    persistentVariables.Store<"nDroppedPdus">(0);
     persistentVariables.Store<"lastFrameSequenceNumber">(0);
     persistentVariables.Store<"lastMessageTypeId">(MessageTypeIdFields{});
     persistentVariables.Store<"lastMessageTypeIdWasInvalid">(false);
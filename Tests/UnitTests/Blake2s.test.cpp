@@ -29,4 +29,22 @@ TEST_CASE("Blake2s")  // NOLINT(cert-err58-cpp)
         auto expected = sts1cobcsw::Serialize<std::endian::big>(0x93FC'1392'48AB'69B5);
         CHECK(hash == expected);
     }
+    // Hashing the data piece by piece gives the same hash as hashing it at once
+    {
+        auto data = std::array<Byte, 215>{};  // NOLINT(*magic-numbers)
+        for(auto i = 0U; i < data.size(); ++i)
+        {
+            data[i] = static_cast<Byte>(i);
+        }
+        auto hasher = blake2s::Hasher{};
+        hasher.Reset();
+        hasher.Update(std::span(data).first(30));        // NOLINT(*magic-numbers)
+        hasher.Update(std::span(data).subspan(30, 64));  // NOLINT(*magic-numbers)
+        hasher.Update(std::span(data).subspan(94));      // NOLINT(*magic-numbers)
+        CHECK(hasher.Finalize() == blake2s::ComputeHash(data));
+        // The hasher can be reused after a reset
+        hasher.Reset();
+        hasher.Update(data);
+        CHECK(hasher.Finalize() == blake2s::ComputeHash(data));
+    }
 }
@@ -2,21 +2,26 @@
 
 #include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
 #include <Sts1CobcSw/ChannelCoding/External/ConvolutionalCoding.hpp>
+#include <Sts1CobcSw/ChannelCoding/FrameEncoder.hpp>
 #include <Sts1CobcSw/ChannelCoding/ReedSolomon.hpp>
 #include <Sts1CobcSw/ChannelCoding/Scrambler.hpp>
+#include <Sts1CobcSw/ChannelCoding/SynchMarkerCorrelator.hpp>
+#include <Sts1CobcSw/ChannelCoding/ViterbiDecoder.hpp>
 #include <Sts1CobcSw/Outcome/Outcome.hpp>
 #include <Sts1CobcSw/Serial/Byte.hpp>
 
+#include <libfec/fec.h>
+
 #include <etl/vector.h>
 
 #include <algorithm>
 #include <array>
+#include <climits>
 #include <cstddef>
 #include <cstdint>
+#include <numeric>
+#include <random>
 #include <span>
-#ifdef USE_PUNCTURING
-    #include <random>
-#endif
 
 
 namespace rs = sts1cobcsw::rs;
@@ -37,44 +42,148 @@ constexpr auto GenerateSequentialBytes(Byte startValue = 0_b) -> std::array<Byte
     }
     return result;
 }
+
+
+// Write bits MSB first to a byte stream at arbitrary bit offsets, e.g., to simulate bit slips
+class BitStreamWriter
+{
+public:
+    explicit BitStreamWriter(std::span<Byte> stream) : stream_(stream)
+    {}
+
+    auto Write(std::uint32_t bits, unsigned int nBits) -> void
+    {
+        for(auto i = nBits; i-- > 0;)
+        {
+            auto mask = static_cast<Byte>(1U << (CHAR_BIT - 1U - (nWrittenBits_ % CHAR_BIT)));
+            if(((bits >> i) & 1U) == 1U)
+            {
+                stream_[nWrittenBits_ / CHAR_BIT] |= mask;
+            }
+            else
+            {
+                stream_[nWrittenBits_ / CHAR_BIT] &= ~mask;
+            }
+            ++nWrittenBits_;
+        }
+    }
+
+    auto Write(std::span<Byte const> bytes) -> void
+    {
+        for(auto byte : bytes)
+        {
+            Write(static_cast<std::uint8_t>(byte), CHAR_BIT);
+        }
+    }
+
+    [[nodiscard]] auto NWrittenBits() const -> std::size_t
+    {
+        return nWrittenBits_;
+    }
+
+
+private:
+    std::span<Byte> stream_;
+    std::size_t nWrittenBits_ = 0;
+};
+
+
+#if !defined(DISABLE_CHANNEL_CODING) && !defined(DISABLE_CONVOLUTIONAL_CODING)
+// Straightforward bit-by-bit implementation of the convolutional encoder with flushing
+auto EncodeBitByBit(std::span<Byte const> data, cc::CodeRate codeRate)
+    -> etl::vector<Byte, cc::ViterbiCodec::maxEncodedSize>
+{
+    auto encodedData = etl::vector<Byte, cc::ViterbiCodec::maxEncodedSize>(
+        cc::ViterbiCodec::EncodedSize(data.size(), /*withFlushBits=*/true, codeRate), 0x00_b);
+    auto iEncodedBit = 0U;
+    auto appendBit = [&](unsigned int bit)
+    {
+        encodedData[iEncodedBit / CHAR_BIT] |=
+            static_cast<Byte>(bit << (CHAR_BIT - 1U - (iEncodedBit % CHAR_BIT)));
+        ++iEncodedBit;
+    };
+    auto state = 0U;
+    for(auto i = 0U; i < data.size() * CHAR_BIT + cc::ViterbiCodec::nFlushBits; ++i)
+    {
+        auto bit = 0U;
+        if(i < data.size() * CHAR_BIT)
+        {
+            bit = (static_cast<unsigned>(data[i / CHAR_BIT]) >> (CHAR_BIT - 1U - (i % CHAR_BIT)))
+                & 1U;
+        }
+        auto output =
+            cc::ViterbiCodec::ComputeOutput(state | (bit << (cc::ViterbiCodec::constraint - 1U)));
+        state = (state >> 1U) | (bit << (cc::ViterbiCodec::constraint - 2U));
+        if(codeRate != cc::CodeRate::twoThirds or i % 2 == 0)
+        {
+            appendBit(output >> 1U);
+        }
+        appendBit(output & 1U);
+    }
+    return encodedData;
+}
+#endif
+
+
+// Corrupt burstLength consecutive bytes of an interleaved Reed-Solomon block, starting at
+// burstStart, and return whether decoding restores the original message
+template<std::size_t interleavingDepth>
+auto CanCorrectBurstError(std::size_t burstStart, std::size_t burstLength) -> bool
+{
+    static constexpr auto messageLength = interleavingDepth * rs::messageLength;
+    static constexpr auto nParitySymbols = interleavingDepth * rs::nParitySymbols;
+    static constexpr auto originalMessage = GenerateSequentialBytes<messageLength>(0x23_b);
+    auto block = std::array<Byte, interleavingDepth * rs::blockLength>{};
+    std::ranges::copy(originalMessage, block.begin());
+    rs::EncodeInterleaved<interleavingDepth>(std::span(block).template first<messageLength>(),
+                                             std::span(block).template last<nParitySymbols>());
+    for(auto i = burstStart; i < burstStart + burstLength; ++i)
+    {
+        block[i] ^= 0xFF_b;
+    }
+    auto decodeResult = rs::DecodeInterleaved<interleavingDepth>(block);
+    return decodeResult.has_value() and decodeResult.value() == static_cast<int>(burstLength)
+       and std::equal(originalMessage.begin(), originalMessage.end(), block.begin());
+}
 }
 
 
 #ifdef USE_PUNCTURING
 TEST_CASE("Convolutional coding")
 {
+    static constexpr auto codeRate = cc::CodeRate::twoThirds;
     // EncodedSize() and UnencodedSize()
     {
-        static_assert(cc::ViterbiCodec::EncodedSize(10, false) == 15);
-        static_assert(cc::ViterbiCodec::EncodedSize(11, false) == 17);
-        static_assert(cc::ViterbiCodec::EncodedSize(12, false) == 18);
-        static_assert(cc::ViterbiCodec::EncodedSize(13, false) == 20);
-        static_assert(cc::ViterbiCodec::EncodedSize(14, false) == 21);
-
-        static_assert(cc::ViterbiCodec::UnencodedSize(15, false) == 10);
-        static_assert(cc::ViterbiCodec::UnencodedSize(16, false) == 10);
-        static_assert(cc::ViterbiCodec::UnencodedSize(17, false) == 11);
-        static_assert(cc::ViterbiCodec::UnencodedSize(18, false) == 12);
-        static_assert(cc::ViterbiCodec::UnencodedSize(19, false) == 12);
-        static_assert(cc::ViterbiCodec::UnencodedSize(20, false) == 13);
-        static_assert(cc::ViterbiCodec::UnencodedSize(21, false) == 14);
-
-        static_assert(cc::ViterbiCodec::EncodedSize(10, true) == 17);
-        static_assert(cc::ViterbiCodec::EncodedSize(11, true) == 18);
-        static_assert(cc::ViterbiCodec::EncodedSize(12, true) == 20);
-        static_assert(cc::ViterbiCodec::EncodedSize(13, true) == 21);
-        static_assert(cc::ViterbiCodec::EncodedSize(14, true) == 23);
-
-        static_assert(cc::ViterbiCodec::UnencodedSize(17, true) == 10);
-        static_assert(cc::ViterbiCodec::UnencodedSize(18, true) == 11);
-        static_assert(cc::ViterbiCodec::UnencodedSize(19, true) == 11);
-        static_assert(cc::ViterbiCodec::UnencodedSize(20, true) == 12);
-        static_assert(cc::ViterbiCodec::UnencodedSize(21, true) == 13);
-        static_assert(cc::ViterbiCodec::UnencodedSize(22, true) == 13);
-        static_assert(cc::ViterbiCodec::UnencodedSize(23, true) == 14);
-
-        static_assert(cc::ViterbiCodec::EncodedSize(255, true) == 384);
-        static_assert(cc::ViterbiCodec::UnencodedSize(384, true) == 255);
+        static_assert(cc::ViterbiCodec::EncodedSize(10, false, codeRate) == 15);
+        static_assert(cc::ViterbiCodec::EncodedSize(11, false, codeRate) == 17);
+        static_assert(cc::ViterbiCodec::EncodedSize(12, false, codeRate) == 18);
+        static_assert(cc::ViterbiCodec::EncodedSize(13, false, codeRate) == 20);
+        static_assert(cc::ViterbiCodec::EncodedSize(14, false, codeRate) == 21);
+
+        static_assert(cc::ViterbiCodec::UnencodedSize(15, false, codeRate) == 10);
+        static_assert(cc::ViterbiCodec::UnencodedSize(16, false, codeRate) == 10);
+        static_assert(cc::ViterbiCodec::UnencodedSize(17, false, codeRate) == 11);
+        static_assert(cc::ViterbiCodec::UnencodedSize(18, false, codeRate) == 12);
+        static_assert(cc::ViterbiCodec::UnencodedSize(19, false, codeRate) == 12);
+        static_assert(cc::ViterbiCodec::UnencodedSize(20, false, codeRate) == 13);
+        static_assert(cc::ViterbiCodec::UnencodedSize(21, false, codeRate) == 14);
+
+        static_assert(cc::ViterbiCodec::EncodedSize(10, true, codeRate) == 17);
+        static_assert(cc::ViterbiCodec::EncodedSize(11, true, codeRate) == 18);
+        static_assert(cc::ViterbiCodec::EncodedSize(12, true, codeRate) == 20);
+        static_assert(cc::ViterbiCodec::EncodedSize(13, true, codeRate) == 21);
+        static_assert(cc::ViterbiCodec::EncodedSize(14, true, codeRate) == 23);
+
+        static_assert(cc::ViterbiCodec::UnencodedSize(17, true, codeRate) == 10);
+        static_assert(cc::ViterbiCodec::UnencodedSize(18, true, codeRate) == 11);
+        static_assert(cc::ViterbiCodec::UnencodedSize(19, true, codeRate) == 11);
+        static_assert(cc::ViterbiCodec::UnencodedSize(20, true, codeRate) == 12);
+        static_assert(cc::ViterbiCodec::UnencodedSize(21, true, codeRate) == 13);
+        static_assert(cc::ViterbiCodec::UnencodedSize(22, true, codeRate) == 13);
+        static_assert(cc::ViterbiCodec::UnencodedSize(23, true, codeRate) == 14);
+
+        static_assert(cc::ViterbiCodec::EncodedSize(255, true, codeRate) == 384);
+        static_assert(cc::ViterbiCodec::UnencodedSize(384, true, codeRate) == 255);
     }
 
     // Encode() returns the correct amount of data
@@ -83,7 +192,7 @@ TEST_CASE("Convolutional coding")
         // output bytes. It has internal state to handle odd-sized inputs. Calling it multiple times
         // with the same input can therefore give different results. Flushing resets the internal
         // state.
-        auto cc = cc::ViterbiCodec();
+        auto cc = cc::ViterbiCodec(codeRate);
         REQUIRE(cc.Encode(std::array<Byte, 10>{}, /*flush=*/false).size() == 15U);
         REQUIRE(cc.Encode(std::array<Byte, 10>{}, /*flush=*/false).size() == 15U);
         REQUIRE(cc.Encode(std::array<Byte, 11>{}, /*flush=*/false).size() == 16U);
@@ -132,7 +241,7 @@ TEST_CASE("Convolutional coding")
          0x68_b, 0x1F_b, 0x38_b, 0xDA_b, 0xA4_b, 0x13_b, 0xB4_b, 0xD2_b, 0xF1_b, 0x93_b, 0xB0_b,
          0x82_b, 0xFD_b, 0xC6_b, 0x65_b, 0x4F_b, 0x7D_b, 0x4E_b, 0x21_b, 0x0B_b, 0xAA_b, 0xE0_b,
          0x07_b, 0xB9_b, 0x8E_b, 0x71_b, 0x5E_b, 0x3C_b, 0xCA_b, 0x75_b, 0x5D_b, 0xE8_b});
-    auto cc = cc::ViterbiCodec();
+    auto cc = cc::ViterbiCodec(codeRate);
 
     // Endode() returns the correct data
     {
@@ -152,18 +261,21 @@ TEST_CASE("Convolutional coding")
         auto gen = std::mt19937(rd());
         auto distribution = std::uniform_int_distribution(25, 98);
         auto freeSpace = static_cast<unsigned>(distribution(gen));
-        auto finalChunkSize = cc::ViterbiCodec::UnencodedSize(freeSpace, /*withFlushBits*/ true);
+        auto finalChunkSize =
+            cc::ViterbiCodec::UnencodedSize(freeSpace, /*withFlushBits*/ true, codeRate);
         auto dataIndex = 0U;
         auto buffer = etl::vector<Byte, correctlyEncodedMessage.size()>{};
         while(dataIndex + finalChunkSize < message.size())
         {
-            auto chunkSize = cc::ViterbiCodec::UnencodedSize(freeSpace, /*withFlushBits*/ false);
+            auto chunkSize =
+                cc::ViterbiCodec::UnencodedSize(freeSpace, /*withFlushBits*/ false, codeRate);
             auto encodedChunk =
                 cc.Encode(std::span(message).subspan(dataIndex, chunkSize), /*flush=*/false);
             buffer.insert(buffer.end(), encodedChunk.begin(), encodedChunk.end());
             dataIndex += chunkSize;
             freeSpace = static_cast<unsigned>(distribution(gen));
-            finalChunkSize = cc::ViterbiCodec::UnencodedSize(freeSpace, /*withFlushBits*/ true);
+            finalChunkSize =
+                cc::ViterbiCodec::UnencodedSize(freeSpace, /*withFlushBits*/ true, codeRate);
         }
         auto encodedChunk = cc.Encode(std::span(message).subspan(dataIndex), /*flush=*/true);
         buffer.insert(buffer.end(), encodedChunk.begin(), encodedChunk.end());
@@ -179,28 +291,29 @@ TEST_CASE("Convolutional coding")
 #ifndef USE_PUNCTURING
 TEST_CASE("Convolutional-Coding Without Puncturing")
 {
+    static constexpr auto codeRate = cc::CodeRate::oneHalf;
     {
-        static_assert(cc::ViterbiCodec::EncodedSize(100, false) == 200);
-        static_assert(cc::ViterbiCodec::EncodedSize(100, true) == 202);
-        static_assert(cc::ViterbiCodec::EncodedSize(101, false) == 202);
-        static_assert(cc::ViterbiCodec::EncodedSize(101, true) == 204);
-        static_assert(cc::ViterbiCodec::EncodedSize(102, false) == 204);
-        static_assert(cc::ViterbiCodec::EncodedSize(102, true) == 206);
-        static_assert(cc::ViterbiCodec::EncodedSize(255, true) == 512);
+        static_assert(cc::ViterbiCodec::EncodedSize(100, false, codeRate) == 200);
+        static_assert(cc::ViterbiCodec::EncodedSize(100, true, codeRate) == 202);
+        static_assert(cc::ViterbiCodec::EncodedSize(101, false, codeRate) == 202);
+        static_assert(cc::ViterbiCodec::EncodedSize(101, true, codeRate) == 204);
+        static_assert(cc::ViterbiCodec::EncodedSize(102, false, codeRate) == 204);
+        static_assert(cc::ViterbiCodec::EncodedSize(102, true, codeRate) == 206);
+        static_assert(cc::ViterbiCodec::EncodedSize(255, true, codeRate) == 512);
 
-        static_assert(cc::ViterbiCodec::UnencodedSize(201, true) == 99);
-        static_assert(cc::ViterbiCodec::UnencodedSize(201, false) == 100);
-        static_assert(cc::ViterbiCodec::UnencodedSize(202, true) == 100);
-        static_assert(cc::ViterbiCodec::UnencodedSize(202, false) == 101);
-        static_assert(cc::ViterbiCodec::UnencodedSize(203, true) == 100);
-        static_assert(cc::ViterbiCodec::UnencodedSize(203, false) == 101);
-        static_assert(cc::ViterbiCodec::UnencodedSize(204, true) == 101);
-        static_assert(cc::ViterbiCodec::UnencodedSize(204, false) == 102);
+        static_assert(cc::ViterbiCodec::UnencodedSize(201, true, codeRate) == 99);
+        static_assert(cc::ViterbiCodec::UnencodedSize(201, false, codeRate) == 100);
+        static_assert(cc::ViterbiCodec::UnencodedSize(202, true, codeRate) == 100);
+        static_assert(cc::ViterbiCodec::UnencodedSize(202, false, codeRate) == 101);
+        static_assert(cc::ViterbiCodec::UnencodedSize(203, true, codeRate) == 100);
+        static_assert(cc::ViterbiCodec::UnencodedSize(203, false, codeRate) == 101);
+        static_assert(cc::ViterbiCodec::UnencodedSize(204, true, codeRate) == 101);
+        static_assert(cc::ViterbiCodec::UnencodedSize(204, false, codeRate) == 102);
     }
 
     // Encode() returns the correct amount of data
     {
-        auto cc = cc::ViterbiCodec();
+        auto cc = cc::ViterbiCodec(codeRate);
         REQUIRE(cc.Encode(std::array<Byte, 10>{}, /*flush=*/false).size() == 20U);
         REQUIRE(cc.Encode(std::array<Byte, 11>{}, /*flush=*/false).size() == 22U);
         REQUIRE(cc.Encode(std::array<Byte, 10>{}, /*flush=*/true).size() == 22U);
@@ -258,7 +371,7 @@ TEST_CASE("Convolutional-Coding Without Puncturing")
          0x80_b, 0xBD_b, 0xCD_b, 0x0E_b, 0x71_b, 0x48_b, 0xFB_b, 0xFB_b, 0x47_b, 0x86_b, 0x0A_b,
          0x35_b, 0xB6_b, 0x9C_b, 0x20_b, 0x2F_b, 0x9C_b, 0x52_b, 0xD1_b, 0xE1_b, 0x6D_b, 0xA7_b,
          0xE7_b, 0x14_b, 0x5B_b, 0x69_b, 0xCF_b, 0x90_b});
-    auto cc = cc::ViterbiCodec();
+    auto cc = cc::ViterbiCodec(codeRate);
 
     {
         auto encodedMessage = cc.Encode(message, /*flush=*/true);
@@ -271,6 +384,145 @@ TEST_CASE("Convolutional-Coding Without Puncturing")
 #endif
 
 
+#if !defined(DISABLE_CHANNEL_CODING) && !defined(DISABLE_CONVOLUTIONAL_CODING)
+TEST_CASE("Table-driven convolutional encoding is bit-exact")
+{
+    // All combinations of encoder state and input byte. The state is given by the last 6 bits of
+    // the previous byte.
+    for(auto previousByte = 0U; previousByte < (1U << (cc::ViterbiCodec::constraint - 1U));
+        ++previousByte)
+    {
+        for(auto byte = 0U; byte < (1U << CHAR_BIT); ++byte)
+        {
+            auto data = std::array{static_cast<Byte>(previousByte), static_cast<Byte>(byte)};
+            auto encoder = cc::ViterbiCodec();
+            auto encodedData = encoder.Encode(data, /*flush=*/true);
+            auto expectedEncodedData = EncodeBitByBit(data, encoder.GetCodeRate());
+            REQUIRE(encodedData.size() == expectedEncodedData.size());
+            CHECK(std::ranges::equal(encodedData, expectedEncodedData));
+        }
+    }
+
+    // Encoding in chunks gives the same result as encoding everything at once
+    static constexpr auto message = GenerateSequentialBytes<cc::ViterbiCodec::maxUnencodedSize>();
+    auto encoder = cc::ViterbiCodec();
+    auto expectedEncodedMessage = EncodeBitByBit(message, encoder.GetCodeRate());
+    auto encodedMessage = etl::vector<Byte, cc::ViterbiCodec::maxEncodedSize>{};
+    static constexpr auto chunkSize = 37U;
+    for(auto i = 0U; i < message.size(); i += chunkSize)
+    {
+        auto chunk =
+            std::span(message).subspan(i, std::min<std::size_t>(chunkSize, message.size() - i));
+        auto isLastChunk = i + chunkSize >= message.size();
+        auto encodedChunk = encoder.Encode(chunk, /*flush=*/isLastChunk);
+        encodedMessage.insert(encodedMessage.end(), encodedChunk.begin(), encodedChunk.end());
+    }
+    REQUIRE(encodedMessage.size() == expectedEncodedMessage.size());
+    CHECK(std::ranges::equal(encodedMessage, expectedEncodedMessage));
+}
+#endif
+
+
+TEST_CASE("Viterbi decoding")
+{
+    static constexpr auto message = GenerateSequentialBytes<cc::ViterbiCodec::maxUnencodedSize>();
+    auto encoder = cc::ViterbiCodec();
+    auto decoder = cc::ViterbiDecoder();
+    auto decodedMessage = std::array<Byte, cc::ViterbiCodec::maxUnencodedSize>{};
+
+    // Decoding is the inverse of encoding
+    {
+        auto encodedMessage = encoder.Encode(message, /*flush=*/true);
+        auto nDecodedBytes = decoder.Decode(encodedMessage, decodedMessage);
+        CHECK(nDecodedBytes == message.size());
+        CHECK(decodedMessage == message);
+
+        auto encodedShortMessage = encoder.Encode(std::span(message).first(10), /*flush=*/true);
+        decodedMessage = {};
+        nDecodedBytes = decoder.Decode(encodedShortMessage, decodedMessage);
+        CHECK(nDecodedBytes == 10U);
+        CHECK(std::equal(message.begin(), message.begin() + 10, decodedMessage.begin()));
+    }
+
+#if !defined(DISABLE_CHANNEL_CODING) && !defined(DISABLE_CONVOLUTIONAL_CODING)
+    // Isolated bit errors are corrected
+    {
+        auto encodedMessage = encoder.Encode(message, /*flush=*/true);
+        static constexpr auto bitErrorDistance = 50U;
+        for(auto i = 7U; i < encodedMessage.size() * CHAR_BIT; i += bitErrorDistance)
+        {
+            encodedMessage[i / CHAR_BIT] ^= static_cast<Byte>(1U << (i % CHAR_BIT));
+        }
+        decodedMessage = {};
+        auto nDecodedBytes = decoder.Decode(encodedMessage, decodedMessage);
+        CHECK(nDecodedBytes == message.size());
+        CHECK(decodedMessage == message);
+    }
+
+    // Soft decisions help when the hard decisions are wrong but uncertain
+    {
+        auto encodedMessage = encoder.Encode(message, /*flush=*/true);
+        auto softBits = std::array<cc::ViterbiDecoder::SoftBit,
+                                   cc::ViterbiCodec::maxEncodedSize * CHAR_BIT>{};
+        for(auto i = 0U; i < encodedMessage.size() * CHAR_BIT; ++i)
+        {
+            auto bit = (static_cast<unsigned>(encodedMessage[i / CHAR_BIT])
+                        >> (CHAR_BIT - 1U - (i % CHAR_BIT)))
+                     & 1U;
+            softBits[i] =
+                bit == 1U ? cc::ViterbiDecoder::maxSoftBit : cc::ViterbiDecoder::SoftBit{0};
+        }
+        // Every 5th bit is slightly on the wrong side of the decision threshold. That is far too
+        // many errors for a hard-decision decoder but the soft-decision decoder has no problem.
+        for(auto i = 3U; i < encodedMessage.size() * CHAR_BIT; i += 5U)
+        {
+            softBits[i] = softBits[i] == 0U ? 4 : 3;
+        }
+        decodedMessage = {};
+        auto nDecodedBytes = decoder.DecodeSoft(
+            std::span(softBits).first(encodedMessage.size() * CHAR_BIT), decodedMessage);
+        CHECK(nDecodedBytes == message.size());
+        CHECK(decodedMessage == message);
+    }
+
+    // End-to-end: RS + scrambling + ASM + convolutional coding with bit errors on the channel
+    {
+        auto frame = std::array<Byte, sts1cobcsw::tm::channelAccessDataUnitLength>{};
+        std::ranges::copy(sts1cobcsw::attachedSynchMarker, frame.begin());
+        auto block = std::span(frame).subspan<sts1cobcsw::attachedSynchMarkerLength,
+                                              sts1cobcsw::tm::blockLength>();
+        auto originalMessage = GenerateSequentialBytes<sts1cobcsw::tm::messageLength>(0x42_b);
+        std::ranges::copy(originalMessage, block.begin());
+        sts1cobcsw::tm::Encode(block);
+        // With interleaving the frame is too long for Encode() so EncodeTo() must be used
+        auto encodedFrame = std::array<Byte,
+                                       sts1cobcsw::tm::FullyEncodedFrameLength(
+                                           sts1cobcsw::defaultCodingProfile)>{};
+        auto nEncodedBytes = encoder.EncodeTo(frame, encodedFrame, /*flush=*/true);
+        REQUIRE(nEncodedBytes == encodedFrame.size());
+        for(auto i = 11U; i < encodedFrame.size() * CHAR_BIT; i += 40U)
+        {
+            encodedFrame[i / CHAR_BIT] ^= static_cast<Byte>(1U << (i % CHAR_BIT));
+        }
+
+        auto decodedFrame = std::array<Byte, sts1cobcsw::tm::channelAccessDataUnitLength>{};
+        auto nDecodedBytes = decoder.Decode(encodedFrame, decodedFrame);
+        REQUIRE(nDecodedBytes == decodedFrame.size());
+        CHECK(std::equal(sts1cobcsw::attachedSynchMarker.begin(),
+                         sts1cobcsw::attachedSynchMarker.end(),
+                         decodedFrame.begin()));
+        auto decodedBlock = std::span(decodedFrame)
+                                .subspan<sts1cobcsw::attachedSynchMarkerLength,
+                                         sts1cobcsw::tm::blockLength>();
+        auto decodeResult = sts1cobcsw::tm::Decode(decodedBlock);
+        REQUIRE(decodeResult.has_value());
+        CHECK(decodeResult.value() == 0);
+        CHECK(std::equal(originalMessage.begin(), originalMessage.end(), decodedBlock.begin()));
+    }
+#endif
+}
+
+
 TEST_CASE("Reed-Solomon")
 {
     auto block = std::array<Byte, rs::blockLength>{};
@@ -291,6 +543,27 @@ TEST_CASE("Reed-Solomon")
         CHECK(paritySymbols == correctParitySymbols);
     }
 
+    // EncodeChannelAccessDataUnit() is the same as Encode() plus writing the attached sync marker
+    {
+        static constexpr auto originalTmMessage =
+            GenerateSequentialBytes<sts1cobcsw::tm::messageLength>();
+        auto channelAccessDataUnit =
+            std::array<Byte, sts1cobcsw::tm::channelAccessDataUnitLength>{};
+        std::ranges::fill(channelAccessDataUnit, 0xAA_b);
+        auto channelAccessDataUnitBlock = std::span(channelAccessDataUnit)
+                                              .subspan<sts1cobcsw::attachedSynchMarkerLength,
+                                                       sts1cobcsw::tm::blockLength>();
+        std::ranges::copy(originalTmMessage, channelAccessDataUnitBlock.begin());
+        sts1cobcsw::tm::EncodeChannelAccessDataUnit(channelAccessDataUnit);
+        auto tmBlock = std::array<Byte, sts1cobcsw::tm::blockLength>{};
+        std::ranges::copy(originalTmMessage, tmBlock.begin());
+        sts1cobcsw::tm::Encode(tmBlock);
+        CHECK(std::ranges::equal(channelAccessDataUnitBlock, tmBlock));
+        CHECK(std::equal(sts1cobcsw::attachedSynchMarker.begin(),
+                         sts1cobcsw::attachedSynchMarker.end(),
+                         channelAccessDataUnit.begin()));
+    }
+
     // Up to nParitySymbols / 2 errors can be corrected
     {
         static constexpr auto nErrors = sts1cobcsw::nParitySymbols / 2U;
@@ -328,6 +601,131 @@ TEST_CASE("Reed-Solomon")
         std::copy_n(block.begin(), message.size(), message.begin());
         CHECK(message != originalMessage);
     }
+
+    // Up to maxNErasures erasures can be corrected
+    {
+        auto erasurePositions = std::array<std::uint8_t, rs::maxNErasures>{};
+        for(auto i = 0U; i < erasurePositions.size(); ++i)
+        {
+            erasurePositions[i] = static_cast<std::uint8_t>(7 * i + 3);
+        }
+        std::ranges::copy(originalMessage, block.begin());
+        rs::Encode(std::span(block).first<rs::messageLength>(),
+                   std::span(block).last<rs::nParitySymbols>());
+        auto encodedBlock = block;
+        for(auto position : erasurePositions)
+        {
+            block[position] ^= static_cast<Byte>(position + 1);
+        }
+        auto decodeResult = rs::Decode(block, erasurePositions);
+        CHECK(decodeResult.has_value());
+        CHECK(decodeResult.value() == static_cast<int>(rs::maxNErasures));
+        CHECK(block == encodedBlock);
+
+        // Erasures that are not actually corrupted are fine
+        block[erasurePositions[0]] ^= 0x5A_b;
+        decodeResult = rs::Decode(block, erasurePositions);
+        CHECK(decodeResult.has_value());
+        CHECK(decodeResult.value() == 1);
+        CHECK(block == encodedBlock);
+
+        // Without the erasure information this is way too many errors
+        for(auto position : erasurePositions)
+        {
+            block[position] ^= 0xFF_b;
+        }
+        decodeResult = rs::Decode(block);
+        CHECK(decodeResult.has_error());
+
+        // Errors and erasures can be corrected as long as 2 * nErrors + nErasures <= nParitySymbols
+        static constexpr auto nErasures = 20U;
+        static constexpr auto nErrors = (rs::nParitySymbols - nErasures) / 2U;
+        block = encodedBlock;
+        for(auto i = 0U; i < nErasures; ++i)
+        {
+            block[erasurePositions[i]] ^= 0xFF_b;
+        }
+        for(auto i = 0U; i < nErrors; ++i)
+        {
+            block[rs::blockLength - 1 - 5 * i] ^= 0x81_b;
+        }
+        decodeResult = rs::Decode(block, std::span(erasurePositions).first(nErasures));
+        CHECK(decodeResult.has_value());
+        CHECK(decodeResult.value() == static_cast<int>(nErasures + nErrors));
+        CHECK(block == encodedBlock);
+
+        // One more error is too much
+        for(auto i = 0U; i < nErasures; ++i)
+        {
+            block[erasurePositions[i]] ^= 0xFF_b;
+        }
+        for(auto i = 0U; i < nErrors + 1; ++i)
+        {
+            block[rs::blockLength - 1 - 5 * i] ^= 0x81_b;
+        }
+        auto corruptedBlock = block;
+        decodeResult = rs::Decode(block, std::span(erasurePositions).first(nErasures));
+        CHECK(decodeResult.has_error());
+        CHECK(decodeResult.error() == sts1cobcsw::ErrorCode::errorCorrectionFailed);
+        // A failed decoding leaves the block untouched
+        CHECK(block == corruptedBlock);
+
+        // Too many or invalid erasure positions are rejected
+        auto tooManyErasurePositions = std::array<std::uint8_t, rs::maxNErasures + 1>{};
+        std::iota(tooManyErasurePositions.begin(), tooManyErasurePositions.end(), std::uint8_t{0});
+        decodeResult = rs::Decode(block, tooManyErasurePositions);
+        CHECK(decodeResult.has_error());
+        CHECK(decodeResult.error() == sts1cobcsw::ErrorCode::errorCorrectionFailed);
+        auto invalidErasurePositions = std::array<std::uint8_t, 1>{rs::blockLength};
+        decodeResult = rs::Decode(block, invalidErasurePositions);
+        CHECK(decodeResult.has_error());
+        CHECK(decodeResult.error() == sts1cobcsw::ErrorCode::invalidParameter);
+    }
+}
+
+
+TEST_CASE("Reed-Solomon is bit-identical to libfec")
+{
+    static constexpr auto nBlocks = 500U;
+    // The seed is fixed to make failures reproducible
+    auto gen = std::mt19937(12345);  // NOLINT(*magic-numbers)
+    auto byteDistribution = std::uniform_int_distribution<unsigned int>(0, UCHAR_MAX);
+    auto positionDistribution = std::uniform_int_distribution<unsigned int>(0, rs::blockLength - 1);
+    // Also test more errors than can be corrected to check that both fail in the same way
+    auto nErrorsDistribution =
+        std::uniform_int_distribution<unsigned int>(0, rs::nParitySymbols / 2 + 4);
+
+    for(auto i = 0U; i < nBlocks; ++i)
+    {
+        auto block = std::array<Byte, rs::blockLength>{};
+        std::ranges::generate(block, [&]() { return static_cast<Byte>(byteDistribution(gen)); });
+
+        auto libfecBlock = block;
+        rs::Encode(std::span(block).first<rs::messageLength>(),
+                   std::span(block).last<rs::nParitySymbols>());
+        // NOLINTBEGIN(*reinterpret-cast)
+        encode_rs_ccsds(reinterpret_cast<unsigned char *>(libfecBlock.data()),
+                        reinterpret_cast<unsigned char *>(libfecBlock.data() + rs::messageLength));
+        // NOLINTEND(*reinterpret-cast)
+        REQUIRE(block == libfecBlock);
+
+        auto nErrors = nErrorsDistribution(gen);
+        for(auto j = 0U; j < nErrors; ++j)
+        {
+            // Positions may repeat and values may be 0 so this is at most nErrors errors
+            block[positionDistribution(gen)] ^= static_cast<Byte>(byteDistribution(gen));
+        }
+        libfecBlock = block;
+        auto decodeResult = rs::Decode(block);
+        // NOLINTNEXTLINE(*reinterpret-cast)
+        auto libfecResult = decode_rs_ccsds(reinterpret_cast<unsigned char *>(libfecBlock.data()));
+        CHECK(decodeResult.has_value() == (libfecResult >= 0));
+        if(decodeResult.has_value())
+        {
+            CHECK(decodeResult.value() == libfecResult);
+        }
+        CHECK(block == libfecBlock);
+    }
 }
 
 
@@ -407,14 +805,42 @@ TEST_CASE("Scrambler")
             0x08_b, 0xa6_b};
         CHECK(data == correctlyScrambledData);
     }
+
+    // Scrambling works on unaligned spans and on spans longer than the scrambling sequence
+    {
+        auto sequence = std::array<Byte, rs::blockLength>{};
+        sts1cobcsw::tm::Scramble(sequence);
+        for(auto offset = 0U; offset < 4U; ++offset)
+        {
+            for(auto size : {0U, 1U, 3U, 4U, 5U, 254U, 255U, 256U, 2U * 255U + 7U})
+            {
+                auto buffer = std::array<Byte, 4U + 2U * 255U + 7U>{};
+                std::ranges::fill(buffer, 0x5A_b);
+                auto data = std::span(buffer).subspan(offset, size);
+                sts1cobcsw::tm::Scramble(data);
+                for(auto i = 0U; i < buffer.size(); ++i)
+                {
+                    auto isScrambled = offset <= i and i < offset + size;
+                    auto expectedByte =
+                        isScrambled ? (0x5A_b ^ sequence[(i - offset) % sequence.size()]) : 0x5A_b;
+                    REQUIRE(buffer[i] == expectedByte);
+                }
+            }
+        }
+    }
 }
 
 
 TEST_CASE("Channel coding")
 {
-    auto block = std::array<Byte, rs::blockLength>{};
-    auto message = std::array<Byte, rs::messageLength>{};
-    static constexpr auto originalMessage = GenerateSequentialBytes<rs::messageLength>();
+    auto block = std::array<Byte, sts1cobcsw::tc::blockLength>{};
+    auto message = std::array<Byte, sts1cobcsw::tc::messageLength>{};
+    static constexpr auto originalMessage =
+        GenerateSequentialBytes<sts1cobcsw::tc::messageLength>();
+    auto tmBlock = std::array<Byte, sts1cobcsw::tm::blockLength>{};
+    auto tmMessage = std::array<Byte, sts1cobcsw::tm::messageLength>{};
+    static constexpr auto originalTmMessage =
+        GenerateSequentialBytes<sts1cobcsw::tm::messageLength>();
 
     // Decoding is the inverse of encoding
     {
@@ -426,30 +852,30 @@ TEST_CASE("Channel coding")
         std::copy_n(block.begin(), message.size(), message.begin());
         CHECK(message == originalMessage);
 
-        std::ranges::copy(originalMessage, block.begin());
-        sts1cobcsw::tm::Encode(block);
-        decodeResult = sts1cobcsw::tm::Decode(block);
+        std::ranges::copy(originalTmMessage, tmBlock.begin());
+        sts1cobcsw::tm::Encode(tmBlock);
+        decodeResult = sts1cobcsw::tm::Decode(tmBlock);
         CHECK(decodeResult.has_value());
         CHECK(decodeResult.value() == 0);
-        std::copy_n(block.begin(), message.size(), message.begin());
-        CHECK(message == originalMessage);
+        std::copy_n(tmBlock.begin(), tmMessage.size(), tmMessage.begin());
+        CHECK(tmMessage == originalTmMessage);
     }
 
     // Up to nParitySymbols / 2 errors can be corrected
     {
         static constexpr auto nErrors = sts1cobcsw::nParitySymbols / 2U;
 
-        std::ranges::copy(originalMessage, block.begin());
-        sts1cobcsw::tm::Encode(block);
+        std::ranges::copy(originalTmMessage, tmBlock.begin());
+        sts1cobcsw::tm::Encode(tmBlock);
         for(auto i = 0U; i < nErrors; ++i)
         {
-            block[i] ^= 0xFF_b;
+            tmBlock[i] ^= 0xFF_b;
         }
-        auto decodeResult = sts1cobcsw::tm::Decode(block);
+        auto decodeResult = sts1cobcsw::tm::Decode(tmBlock);
         CHECK(decodeResult.has_value());
         CHECK(decodeResult.value() == static_cast<int>(nErrors));
-        std::copy_n(block.begin(), message.size(), message.begin());
-        CHECK(message == originalMessage);
+        std::copy_n(tmBlock.begin(), tmMessage.size(), tmMessage.begin());
+        CHECK(tmMessage == originalTmMessage);
 
         std::ranges::copy(originalMessage, block.begin());
         sts1cobcsw::tc::Encode(block);
@@ -464,10 +890,71 @@ TEST_CASE("Channel coding")
         CHECK(message == originalMessage);
     }
 
-    // Regression test
+    // TC blocks with too many errors can still be decoded if the corrupted bytes are flagged as
+    // erasures
     {
+        static constexpr auto nErasures = sts1cobcsw::nParitySymbols;
+
         std::ranges::copy(originalMessage, block.begin());
-        sts1cobcsw::tm::Encode(block);
+        sts1cobcsw::tc::Encode(block);
+        auto erasurePositions = std::array<std::uint8_t, nErasures>{};
+        std::iota(erasurePositions.begin(), erasurePositions.end(), std::uint8_t{100});
+        for(auto position : erasurePositions)
+        {
+            block[position] ^= 0xFF_b;
+        }
+        auto decodeResult = sts1cobcsw::tc::Decode(block, erasurePositions);
+        CHECK(decodeResult.has_value());
+        CHECK(decodeResult.value() == static_cast<int>(nErasures));
+        std::copy_n(block.begin(), message.size(), message.begin());
+        CHECK(message == originalMessage);
+
+        // Erasures are only used if decoding without them fails
+        std::ranges::copy(originalMessage, block.begin());
+        sts1cobcsw::tc::Encode(block);
+        block[0] ^= 0xFF_b;
+        decodeResult = sts1cobcsw::tc::Decode(block, erasurePositions);
+        CHECK(decodeResult.has_value());
+        CHECK(decodeResult.value() == 1);
+        std::copy_n(block.begin(), message.size(), message.begin());
+        CHECK(message == originalMessage);
+    }
+
+    // Decoding a TC block chunk by chunk while it is received gives the same result as decoding
+    // it as a whole
+    {
+        static constexpr auto chunkSize = 32U;
+        auto decoder = sts1cobcsw::tc::BlockDecoder{};
+        auto erasurePositions = std::array<std::uint8_t, sts1cobcsw::nParitySymbols>{};
+        std::iota(erasurePositions.begin(), erasurePositions.end(), std::uint8_t{10});
+        for(auto nErrors : {0U, 5U, sts1cobcsw::nParitySymbols / 2U + 1U})
+        {
+            std::ranges::copy(originalMessage, block.begin());
+            sts1cobcsw::tc::Encode(block);
+            for(auto i = 0U; i < nErrors; ++i)
+            {
+                block[erasurePositions[i]] ^= 0x5A_b;
+            }
+            decoder.Reset();
+            for(auto begin = 0U; begin < block.size(); begin += chunkSize)
+            {
+                CHECK(not decoder.IsComplete());
+                auto size = std::min<std::size_t>(chunkSize, block.size() - begin);
+                decoder.Update(std::span(block).subspan(begin, size));
+            }
+            CHECK(decoder.IsComplete());
+            auto decodeResult = decoder.Finish(block, erasurePositions);
+            CHECK(decodeResult.has_value());
+            CHECK(decodeResult.value() == static_cast<int>(nErrors));
+            std::copy_n(block.begin(), message.size(), message.begin());
+            CHECK(message == originalMessage);
+        }
+    }
+
+    // Regression test
+    {
+        std::ranges::copy(originalTmMessage, tmBlock.begin());
+        sts1cobcsw::tm::Encode(tmBlock);
         auto correctlyEncodedBlock = std::array{
             0xff_b, 0x49_b, 0x0c_b, 0xc3_b, 0x9e_b, 0x08_b, 0x76_b, 0xbb_b, 0x86_b, 0x25_b, 0x99_b,
             0xa6_b, 0xab_b, 0xba_b, 0x48_b, 0xc1_b, 0x4a_b, 0x86_b, 0x6f_b, 0xdf_b, 0x26_b, 0xb7_b,
@@ -493,7 +980,11 @@ TEST_CASE("Channel coding")
             0x60_b, 0xed_b, 0xc0_b, 0x54_b, 0x1c_b, 0x83_b, 0x5b_b, 0x9a_b, 0x2f_b, 0xc1_b, 0x6f_b,
             0xf1_b, 0xe5_b, 0xbe_b, 0x34_b, 0xb8_b, 0x96_b, 0xd8_b, 0x39_b, 0x4c_b, 0x6c_b, 0x31_b,
             0x73_b, 0x09_b};
-        CHECK(block == correctlyEncodedBlock);
+        // The expected TM block is only known without interleaving
+        if(sts1cobcsw::tm::interleavingDepth == 1)
+        {
+            CHECK(std::ranges::equal(tmBlock, correctlyEncodedBlock));
+        }
 
         std::ranges::copy(originalMessage, block.begin());
         sts1cobcsw::tc::Encode(block);
@@ -525,3 +1016,315 @@ TEST_CASE("Channel coding")
         CHECK(block == correctlyEncodedBlock);
     }
 }
+
+
+TEST_CASE("Frame encoder")
+{
+    namespace tm = sts1cobcsw::tm;
+
+    auto originalChannelAccessDataUnit = std::array<Byte, tm::channelAccessDataUnitLength>{};
+    auto originalMessage = GenerateSequentialBytes<tm::messageLength>(0x17_b);
+    std::ranges::copy(
+        originalMessage,
+        originalChannelAccessDataUnit.begin() + sts1cobcsw::attachedSynchMarkerLength);
+
+    auto expectedChannelAccessDataUnit = originalChannelAccessDataUnit;
+    tm::EncodeChannelAccessDataUnit(expectedChannelAccessDataUnit);
+    static constexpr auto fullyEncodedFrameLength =
+        tm::FullyEncodedFrameLength(sts1cobcsw::defaultCodingProfile);
+    auto expectedEncodedData = std::array<Byte, fullyEncodedFrameLength>{};
+    auto nExpectedBytes =
+        cc::ViterbiCodec().EncodeTo(expectedChannelAccessDataUnit, expectedEncodedData, true);
+    REQUIRE(nExpectedBytes == expectedEncodedData.size());
+
+    // Streaming the frame with any buffer size yields the same result as encoding it all at once
+    auto frameEncoder = tm::FrameEncoder();
+    CHECK(frameEncoder.IsDone());
+    auto buffer = std::array<Byte, 64>{};
+    for(auto bufferSize = tm::FrameEncoder::minReadSize; bufferSize <= buffer.size(); ++bufferSize)
+    {
+        auto channelAccessDataUnit = originalChannelAccessDataUnit;
+        frameEncoder.Start(channelAccessDataUnit);
+        CHECK(channelAccessDataUnit == expectedChannelAccessDataUnit);
+        auto encodedData = std::array<Byte, fullyEncodedFrameLength>{};
+        auto nEncodedBytes = 0U;
+        while(not frameEncoder.IsDone())
+        {
+            auto nReadBytes = frameEncoder.Read(std::span(buffer).first(bufferSize));
+            REQUIRE(nReadBytes <= bufferSize);
+            REQUIRE(nEncodedBytes + nReadBytes <= encodedData.size());
+            std::copy_n(buffer.begin(), nReadBytes, encodedData.begin() + nEncodedBytes);
+            nEncodedBytes += nReadBytes;
+        }
+        CHECK(nEncodedBytes == encodedData.size());
+        CHECK(encodedData == expectedEncodedData);
+        CHECK(frameEncoder.Read(buffer) == 0U);
+    }
+
+    // Buffers that are too small are not written to
+    frameEncoder.StartConvolutionalCoding(originalChannelAccessDataUnit);
+    CHECK(frameEncoder.Read(std::span(buffer).first(tm::FrameEncoder::minReadSize - 1)) == 0U);
+    CHECK(not frameEncoder.IsDone());
+}
+
+
+TEST_CASE("Coding profiles")
+{
+    namespace tm = sts1cobcsw::tm;
+    using sts1cobcsw::CodingProfile;
+
+    auto originalMessage = GenerateSequentialBytes<tm::messageLength>(0x29_b);
+    auto profiles = std::array{CodingProfile::none,
+                               CodingProfile::reedSolomon,
+                               CodingProfile::reedSolomonAndConvolutional,
+                               CodingProfile::reedSolomonAndPuncturedConvolutional};
+    static_assert(not IsValid(static_cast<CodingProfile>(4)));
+    for(auto profile : profiles)
+    {
+        if(not IsValid(profile))
+        {
+            continue;
+        }
+        auto channelAccessDataUnit = std::array<Byte, tm::channelAccessDataUnitLength>{};
+        std::ranges::copy(originalMessage,
+                          channelAccessDataUnit.begin() + sts1cobcsw::attachedSynchMarkerLength);
+
+        // The frame encoder produces exactly FullyEncodedFrameLength() bytes
+        auto frameEncoder = tm::FrameEncoder();
+        frameEncoder.Start(channelAccessDataUnit, profile);
+        auto encodedFrame = std::array<Byte, tm::maxFullyEncodedFrameLength>{};
+        auto nEncodedBytes = 0U;
+        auto buffer = std::array<Byte, 64>{};
+        while(not frameEncoder.IsDone())
+        {
+            auto nReadBytes = frameEncoder.Read(buffer);
+            REQUIRE(nEncodedBytes + nReadBytes <= encodedFrame.size());
+            std::copy_n(buffer.begin(), nReadBytes, encodedFrame.begin() + nEncodedBytes);
+            nEncodedBytes += nReadBytes;
+        }
+        REQUIRE(nEncodedBytes == tm::FullyEncodedFrameLength(profile));
+
+        // Convolutional coding corrects isolated bit errors on the channel
+        auto codeRate = ToCodeRate(profile);
+        if(codeRate != cc::CodeRate::uncoded)
+        {
+            for(auto i = 13U; i < nEncodedBytes * CHAR_BIT; i += 60U)
+            {
+                encodedFrame[i / CHAR_BIT] ^= static_cast<Byte>(1U << (i % CHAR_BIT));
+            }
+        }
+        auto decodedFrame = std::array<Byte, tm::channelAccessDataUnitLength>{};
+        auto nDecodedBytes = cc::ViterbiDecoder(codeRate).Decode(
+            std::span(encodedFrame).first(nEncodedBytes), decodedFrame);
+        REQUIRE(nDecodedBytes == tm::EncodedFrameLength(profile));
+        if(profile == CodingProfile::none)
+        {
+            CHECK(std::ranges::equal(std::span(decodedFrame).first(nDecodedBytes),
+                                     originalMessage));
+            continue;
+        }
+        CHECK(std::equal(sts1cobcsw::attachedSynchMarker.begin(),
+                         sts1cobcsw::attachedSynchMarker.end(),
+                         decodedFrame.begin()));
+        auto decodedBlock =
+            std::span(decodedFrame)
+                .subspan<sts1cobcsw::attachedSynchMarkerLength, tm::blockLength>();
+        auto decodeResult = tm::Decode(decodedBlock);
+        REQUIRE(decodeResult.has_value());
+        CHECK(decodeResult.value() == 0);
+        CHECK(std::equal(originalMessage.begin(), originalMessage.end(), decodedBlock.begin()));
+    }
+}
+
+
+TEST_CASE("Attached sync marker correlator")
+{
+    using sts1cobcsw::attachedSynchMarker;
+    using sts1cobcsw::ErrorCode;
+
+    static constexpr auto payloadLength = 64U;
+    static constexpr auto synchMarkerBits = 0x1ACF'FC1DU;
+    auto payload1 = GenerateSequentialBytes<payloadLength>(0x42_b);
+    auto payload2 = GenerateSequentialBytes<payloadLength>(0xA0_b);
+
+    // Byte-aligned markers are found
+    {
+        auto result = sts1cobcsw::FindSynchMarker(attachedSynchMarker);
+        REQUIRE(result.has_value());
+        CHECK(result.value().bitOffset == 0U);
+        CHECK(result.value().nBitErrors == 0U);
+        result = sts1cobcsw::FindSynchMarker(std::span(attachedSynchMarker).first(3));
+        REQUIRE(result.has_error());
+        CHECK(result.error() == ErrorCode::synchMarkerNotFound);
+    }
+
+    // Two back-to-back frames at arbitrary bit offsets with a bit slip and bit errors in between
+    {
+        auto stream = std::array<Byte, 2 * (attachedSynchMarker.size() + payloadLength) + 4>{};
+        auto writer = BitStreamWriter(stream);
+        auto gen = std::mt19937(2025);  // NOLINT(*magic-numbers)
+        static constexpr auto nNoiseBits = 13U;
+        writer.Write(static_cast<std::uint32_t>(gen()), nNoiseBits);
+        writer.Write(synchMarkerBits, 32);
+        writer.Write(payload1);
+        auto endOfFrame1 = writer.NWrittenBits();
+        writer.Write(1U, 1);  // Bit slip: one extra bit
+        writer.Write(synchMarkerBits ^ 0x0100'0010U, 32);  // Two bit errors
+        writer.Write(payload2);
+        auto endOfFrame2 = writer.NWrittenBits();
+        writer.Write(static_cast<std::uint32_t>(gen()), 7);
+
+        auto result = sts1cobcsw::FindSynchMarker(stream);
+        REQUIRE(result.has_value());
+        CHECK(result.value().bitOffset == nNoiseBits);
+        CHECK(result.value().nBitErrors == 0U);
+        auto decodedPayload = std::array<Byte, payloadLength>{};
+        sts1cobcsw::CopyBits(stream, result.value().bitOffset + 32, decodedPayload);
+        CHECK(decodedPayload == payload1);
+
+        result = sts1cobcsw::FindSynchMarkerNear(stream, endOfFrame1, /*maxNSlippedBits=*/2);
+        REQUIRE(result.has_value());
+        CHECK(result.value().bitOffset == endOfFrame1 + 1);
+        CHECK(result.value().nBitErrors == 2U);
+        sts1cobcsw::CopyBits(stream, result.value().bitOffset + 32, decodedPayload);
+        CHECK(decodedPayload == payload2);
+
+        // A plain search also finds the second marker
+        result = sts1cobcsw::FindSynchMarker(stream, endOfFrame1);
+        REQUIRE(result.has_value());
+        CHECK(result.value().bitOffset == endOfFrame1 + 1);
+
+        // The slip is larger than allowed
+        result = sts1cobcsw::FindSynchMarkerNear(stream, endOfFrame1 - 2, /*maxNSlippedBits=*/2);
+        CHECK(result.has_error());
+
+        result = sts1cobcsw::FindSynchMarker(stream, endOfFrame2);
+        REQUIRE(result.has_error());
+        CHECK(result.error() == ErrorCode::synchMarkerNotFound);
+    }
+
+    // Markers with too many bit errors are rejected unless the threshold is raised
+    {
+        auto stream = std::array<Byte, attachedSynchMarker.size() + 2>{};
+        auto writer = BitStreamWriter(stream);
+        writer.Write(0b101U, 3);
+        writer.Write(synchMarkerBits ^ 0x8000'0111U, 32);  // Four bit errors
+        auto result = sts1cobcsw::FindSynchMarker(stream);
+        CHECK(result.has_error());
+        result = sts1cobcsw::FindSynchMarker(stream, 0, /*maxNBitErrors=*/4);
+        REQUIRE(result.has_value());
+        CHECK(result.value().bitOffset == 3U);
+        CHECK(result.value().nBitErrors == 4U);
+    }
+
+    // CopyBits() realigns data at every bit offset
+    for(auto shift = 0U; shift < CHAR_BIT; ++shift)
+    {
+        auto stream = std::array<Byte, payloadLength + 1>{};
+        auto writer = BitStreamWriter(stream);
+        writer.Write(0U, shift);
+        writer.Write(payload1);
+        auto decodedPayload = std::array<Byte, payloadLength>{};
+        sts1cobcsw::CopyBits(stream, shift, decodedPayload);
+        CHECK(decodedPayload == payload1);
+    }
+
+    // ShiftBitsLeft() does the same in place, with the last stream byte passed separately
+    for(auto shift = 0U; shift < CHAR_BIT; ++shift)
+    {
+        auto stream = std::array<Byte, payloadLength + 1>{};
+        auto writer = BitStreamWriter(stream);
+        writer.Write(0U, shift);
+        writer.Write(payload1);
+        auto data = std::array<Byte, payloadLength>{};
+        std::ranges::copy(std::span(stream).first<payloadLength>(), data.begin());
+        sts1cobcsw::ShiftBitsLeft(data, shift, stream.back());
+        CHECK(data == payload1);
+    }
+}
+
+
+TEST_CASE("Interleaved Reed-Solomon")
+{
+    // Without interleaving EncodeInterleaved() is the same as Encode()
+    {
+        static constexpr auto originalMessage = GenerateSequentialBytes<rs::messageLength>();
+        auto block = std::array<Byte, rs::blockLength>{};
+        auto interleavedBlock = std::array<Byte, rs::blockLength>{};
+        std::ranges::copy(originalMessage, block.begin());
+        std::ranges::copy(originalMessage, interleavedBlock.begin());
+        rs::Encode(std::span(block).first<rs::messageLength>(),
+                   std::span(block).last<rs::nParitySymbols>());
+        rs::EncodeInterleaved<1>(std::span(interleavedBlock).first<rs::messageLength>(),
+                                 std::span(interleavedBlock).last<rs::nParitySymbols>());
+        CHECK(interleavedBlock == block);
+    }
+
+    // The codewords are interleaved symbol by symbol
+    {
+        static constexpr auto interleavingDepth = 3U;
+        static constexpr auto originalMessage =
+            GenerateSequentialBytes<interleavingDepth * rs::messageLength>();
+        auto interleavedBlock = std::array<Byte, interleavingDepth * rs::blockLength>{};
+        std::ranges::copy(originalMessage, interleavedBlock.begin());
+        rs::EncodeInterleaved<interleavingDepth>(
+            std::span(interleavedBlock).first<interleavingDepth * rs::messageLength>(),
+            std::span(interleavedBlock).last<interleavingDepth * rs::nParitySymbols>());
+        for(auto j = 0U; j < interleavingDepth; ++j)
+        {
+            auto block = std::array<Byte, rs::blockLength>{};
+            for(auto i = 0U; i < rs::messageLength; ++i)
+            {
+                block[i] = originalMessage[i * interleavingDepth + j];
+            }
+            rs::Encode(std::span(block).first<rs::messageLength>(),
+                       std::span(block).last<rs::nParitySymbols>());
+            for(auto i = 0U; i < rs::blockLength; ++i)
+            {
+                REQUIRE(interleavedBlock[i * interleavingDepth + j] == block[i]);
+            }
+        }
+    }
+
+    // A burst of up to interleavingDepth * nParitySymbols / 2 bytes can be corrected anywhere in
+    // the block
+    {
+        static constexpr auto maxNErrors = rs::nParitySymbols / 2U;
+        for(auto burstStart : {0U, 1U, 100U, 200U})
+        {
+            CHECK(CanCorrectBurstError<1>(burstStart, 1 * maxNErrors));
+            CHECK(CanCorrectBurstError<2>(burstStart, 2 * maxNErrors));
+            CHECK(CanCorrectBurstError<3>(burstStart, 3 * maxNErrors));
+            CHECK(CanCorrectBurstError<4>(burstStart, 4 * maxNErrors));
+            CHECK(CanCorrectBurstError<5>(burstStart, 5 * maxNErrors));
+        }
+        // The last bytes of the block contain the parity symbols of all codewords
+        CHECK(CanCorrectBurstError<5>(5 * rs::blockLength - 5 * maxNErrors, 5 * maxNErrors));
+    }
+
+    // Longer bursts overwhelm shallower interleaving
+    {
+        static constexpr auto burstLength = 50U;
+        CHECK(not CanCorrectBurstError<1>(10, burstLength));
+        CHECK(not CanCorrectBurstError<2>(10, burstLength));
+        CHECK(not CanCorrectBurstError<3>(10, burstLength));
+        CHECK(CanCorrectBurstError<4>(10, burstLength));
+        CHECK(CanCorrectBurstError<5>(10, burstLength));
+    }
+
+    // Decoding fails if a single codeword cannot be corrected
+    {
+        static constexpr auto interleavingDepth = 2U;
+        auto block = std::array<Byte, interleavingDepth * rs::blockLength>{};
+        rs::EncodeInterleaved<interleavingDepth>(
+            std::span(block).first<interleavingDepth * rs::messageLength>(),
+            std::span(block).last<interleavingDepth * rs::nParitySymbols>());
+        // Only corrupt the even bytes, i.e., the first codeword
+        for(auto i = 0U; i < rs::nParitySymbols / 2U + 1U; ++i)
+        {
+            block[interleavingDepth * i] ^= 0xFF_b;
+        }
+        auto decodeResult = rs::DecodeInterleaved<interleavingDepth>(block);
+        CHECK(decodeResult.has_error());
+    }
+}
@@ -0,0 +1,96 @@
+#include <Tests/CatchRodos/TestMacros.hpp>
+
+#include <Sts1CobcSw/Flash/Flash.hpp>
+#include <Sts1CobcSw/Fram/Fram.hpp>
+#include <Sts1CobcSw/Hal/DmaSpi.hpp>
+#include <Sts1CobcSw/Hal/Spis.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <strong_type/difference.hpp>
+#include <strong_type/type.hpp>
+
+#include <rodos/support/support-libs/random.h>
+#include <rodos_no_using_namespace.h>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <span>
+#include <utility>
+
+
+namespace flash = sts1cobcsw::flash;
+namespace fram = sts1cobcsw::fram;
+namespace hal = sts1cobcsw::hal;
+
+using sts1cobcsw::Byte;
+using sts1cobcsw::endOfTime;
+using sts1cobcsw::ms;
+
+
+namespace
+{
+auto FillWithRandomBytes(std::span<Byte> data) -> void;
+}
+
+
+// The FRAM and the flash are connected to DMA SPIs. Transfers below the threshold are done by
+// HAL_SPI, the longer ones by the DMA.
+TEST_CASE("DMA SPI with the FRAM")
+{
+    fram::Initialize();
+    auto deviceId = fram::ReadDeviceId();
+    CHECK(deviceId == fram::correctDeviceId);
+
+    static constexpr auto maxDataSize = 4 * 1024U;
+    RODOS::setRandSeed(static_cast<std::uint64_t>(RODOS::NOW()));
+    auto address = fram::Address(RODOS::uint32Rand() % (value_of(fram::memorySize) - maxDataSize));
+    auto writtenData = std::array<Byte, maxDataSize>{};
+    auto readData = std::array<Byte, maxDataSize>{};
+    for(auto dataSize : std::array{
+            1U, hal::minDmaTransferLength - 1U, hal::minDmaTransferLength, maxDataSize})
+    {
+        FillWithRandomBytes(writtenData);
+        readData.fill(Byte{0});
+        // The timeout doesn't matter because we don't run the SPI supervisor thread in this test
+        fram::WriteTo(address, std::span<Byte const>(writtenData).first(dataSize), 30 * ms);
+        fram::ReadFrom(address, std::span(readData).first(dataSize), 30 * ms);
+        CHECK(std::ranges::equal(std::span(readData).first(dataSize),
+                                 std::span(writtenData).first(dataSize)));
+        // A failed DMA transfer would keep its transfer end for the SPI supervisor
+        CHECK(sts1cobcsw::framEpsSpi.TransferEnd() == endOfTime);
+    }
+}
+
+
+TEST_CASE("DMA SPI with the flash")
+{
+    flash::Initialize();
+    auto jedecId = flash::ReadJedecId();
+    CHECK(jedecId.manufacturerId == flash::correctJedecId.manufacturerId);
+    CHECK(jedecId.deviceId == flash::correctJedecId.deviceId);
+
+    static constexpr auto address = 0x0001'0000U;
+    flash::EraseSector(address);
+    auto waitWhileBusyResult = flash::WaitWhileBusy(500 * ms);
+    CHECK(waitWhileBusyResult.has_error() == false);
+
+    auto writtenPage = flash::Page{};
+    FillWithRandomBytes(writtenPage);
+    flash::ProgramPage(address, writtenPage);
+    waitWhileBusyResult = flash::WaitWhileBusy(5 * ms);
+    CHECK(waitWhileBusyResult.has_error() == false);
+    auto readPage = flash::ReadPage(address);
+    CHECK(readPage == writtenPage);
+    CHECK(sts1cobcsw::flashSpi.TransferEnd() == endOfTime);
+}
+
+
+namespace
+{
+auto FillWithRandomBytes(std::span<Byte> data) -> void
+{
+    std::ranges::generate(data, []() { return static_cast<Byte>(RODOS::uint32Rand()); });
+}
+}
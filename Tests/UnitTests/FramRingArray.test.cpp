@@ -18,6 +18,7 @@
 #include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <type_traits>
 #include <utility>
 
@@ -246,6 +247,13 @@ TEST_CASE("FramRingArray")
         charRingArray2.FindAndReplace([](auto x) { return x == 0; }, 1);
         CHECK(charRingArray2.Get(0) == 21);
         CHECK(charRingArray2.Get(1) == 42);
+
+        // GetRange() reads from the cache and stops at its end
+        auto chars = std::array<char, 3>{};
+        CHECK(charRingArray2.GetRange(0, std::span(chars)) == 2U);
+        CHECK(chars[0] == 21);
+        CHECK(chars[1] == 42);
+        CHECK(charRingArray2.GetRange(2, std::span(chars)) == 0U);
     }
 
     // FramRingArray of custom type
@@ -340,6 +348,20 @@ TEST_CASE("FramRingArray")
         CHECK(sRingArray.Get(0) == s2);
         CHECK(sRingArray.Get(1) == s7);
         CHECK(sRingArray.Get(2) == s8);
+
+        // GetRange() reads consecutive elements and wraps around the end of the FRAM array
+        auto sArray = std::array<S, 3>{};
+        CHECK(sRingArray.GetRange(0, std::span(sArray)) == 3U);
+        CHECK(sArray == (std::array{s2, s7, s8}));
+        auto sPair = std::array<S, 2>{};
+        CHECK(sRingArray.GetRange(1, std::span(sPair)) == 2U);
+        CHECK(sPair == (std::array{s7, s8}));
+        // Only the elements up to the end of the ring are read
+        sArray = {};
+        CHECK(sRingArray.GetRange(2, std::span(sArray)) == 1U);
+        CHECK(sArray == (std::array{s8, S{}, S{}}));
+        // GetRange() with an out-of-bounds index does not read anything
+        CHECK(sRingArray.GetRange(3, std::span(sArray)) == 0U);
     }
 }
 
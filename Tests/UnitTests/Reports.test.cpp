@@ -15,6 +15,7 @@
 #include <Sts1CobcSw/Serial/Serial.hpp>
 #include <Sts1CobcSw/Serial/UInt.hpp>
 #include <Sts1CobcSw/Telemetry/TelemetryRecord.hpp>
+#include <Sts1CobcSw/Telemetry/TelemetryRecordCompression.hpp>
 #include <Sts1CobcSw/Utility/Span.hpp>
 #include <Sts1CobcSw/Vocabulary/FileTransfer.hpp>
 #include <Sts1CobcSw/Vocabulary/Ids.hpp>
@@ -28,8 +29,10 @@
 
 #include <algorithm>
 #include <array>
+#include <bit>
 #include <cstddef>
 #include <cstdint>
+#include <span>
 #include <utility>
 
 
@@ -329,6 +332,62 @@ TEST_CASE("Housekeeping parameter report")
 }
 
 
+TEST_CASE("Compressed housekeeping parameter report")
+{
+    auto dataField = etl::vector<Byte, sts1cobcsw::tm::maxPacketDataLength>{};
+    auto record = sts1cobcsw::TelemetryRecord{.nTotalResets = 1U,
+                                              .rodosTimeInSeconds = 1'000,
+                                              .realTime = RealTime(1'000'000),
+                                              .cobcTemperature = 2'000U,
+                                              .rfTemperature = 2'100U,
+                                              .rxDataRate = 9'600,
+                                              .txDataRate = 9'600};
+    record.epsAdcData.adc4.fill(1'000U);
+    record.epsAdcData.adc5.fill(2'000U);
+    record.epsAdcData.adc6.fill(3'000U);
+    auto records = etl::vector<sts1cobcsw::TelemetryRecord, 10>{};
+    auto report = sts1cobcsw::CompressedHousekeepingParameterReport{};
+    CHECK(report.NRecords() == 0U);
+    while(report.Add(record))
+    {
+        records.push_back(record);
+        record.rodosTimeInSeconds += 30;
+        record.realTime = RealTime(value_of(record.realTime) + 30);
+        record.cobcTemperature = static_cast<std::uint16_t>(record.cobcTemperature + 3U);
+        auto & adcValue = record.epsAdcData.adc4[records.size()];
+        adcValue = static_cast<std::uint16_t>(adcValue + 5U);
+    }
+    // An uncompressed report contains only a single record
+    CHECK(report.NRecords() >= 3U);
+    CHECK(report.NRecords() == records.size());
+
+    auto addToResult = report.AddTo(&dataField);
+    CHECK(addToResult.has_error() == false);
+    CHECK(dataField.size() == report.Size());
+    // Packet secondary header
+    CHECK(dataField[1] == 3_b);    // Service type ID
+    CHECK(dataField[2] == 128_b);  // Submessage type ID
+    // Structure ID
+    CHECK(dataField[11] == 0_b);
+    // Number of records
+    CHECK(dataField[12] == static_cast<Byte>(records.size()));
+
+    // On ground, the records are decompressed one after the other
+    auto compressedRecords = std::span<Byte const>(dataField).subspan(13);
+    auto serializedRecord = sts1cobcsw::Serialize<std::endian::big>(sts1cobcsw::TelemetryRecord{});
+    for(auto const & originalRecord : records)
+    {
+        auto decompressResult = sts1cobcsw::Decompress(&compressedRecords, &serializedRecord);
+        CHECK(decompressResult.has_value());
+        auto decompressedRecord =
+            sts1cobcsw::Deserialize<std::endian::big, sts1cobcsw::TelemetryRecord>(
+                serializedRecord);
+        CHECK(decompressedRecord == originalRecord);
+    }
+    CHECK(compressedRecords.empty());
+}
+
+
 TEST_CASE("Parameter value report")
 {
     using sts1cobcsw::Parameter;
@@ -524,6 +524,34 @@ TEST_CASE("ReportHousekeepingParameterReportFunction")
 }
 
 
+TEST_CASE("ReportCompressedHousekeepingParameterReportFunction")
+{
+    auto buffer = etl::vector<Byte, sts1cobcsw::tc::maxPacketLength>{};
+    buffer.resize(4);
+    buffer[0] = 0x00_b;  // First Report Index (high byte)
+    buffer[1] = 0x01_b;  // First Report Index (low byte)
+    buffer[2] = 0x01_b;  // Last Report Index (high byte)
+    buffer[3] = 0x02_b;  // Last Report Index (low byte)
+
+    auto parseResult =
+        sts1cobcsw::ParseAsReportCompressedHousekeepingParameterReportFunction(buffer);
+    CHECK(parseResult.has_value());
+    auto function = parseResult.value();
+    CHECK(function.firstReportIndex == 0x01);
+    CHECK(function.lastReportIndex == 0x0102);
+
+    // The same checks as for uncompressed reports apply
+    buffer[0] = 0x02_b;
+    parseResult = sts1cobcsw::ParseAsReportCompressedHousekeepingParameterReportFunction(buffer);
+    CHECK(parseResult.has_error());
+    CHECK(parseResult.error() == ErrorCode::invalidApplicationData);
+    buffer.resize(3);
+    parseResult = sts1cobcsw::ParseAsReportCompressedHousekeepingParameterReportFunction(buffer);
+    CHECK(parseResult.has_error());
+    CHECK(parseResult.error() == ErrorCode::invalidDataLength);
+}
+
+
 TEST_CASE("ParseAsEnableFileTransferFunction")
 {
     auto buffer = etl::vector<Byte, sts1cobcsw::tc::maxPacketLength>{};
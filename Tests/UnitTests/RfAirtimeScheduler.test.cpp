@@ -0,0 +1,194 @@
+#include <Sts1CobcSw/Rf/AirtimeScheduler.hpp>
+#include <Sts1CobcSw/Serial/Serial.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <strong_type/difference.hpp>
+#include <strong_type/type.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <bit>
+#include <cstdint>
+
+
+namespace rf = sts1cobcsw::rf;
+using rf::Activity;
+using sts1cobcsw::ms;
+using sts1cobcsw::s;
+
+
+namespace
+{
+// The ground station last sent something long ago and there is plenty of time until the next
+// housekeeping report
+constexpr auto quietLink = rf::LinkState{.remainingIntervalDuration = 30 * s,
+                                         .remainingFileTransferWindowDuration = 60 * s,
+                                         .frameSendDuration = 100 * ms,
+                                         .dataHandlingDuration = 2 * s,
+                                         .timeSinceLastUplink = 120 * s};
+}
+
+
+TEST_CASE("Housekeeping report is followed by an RX window")
+{
+    auto scheduler = rf::AirtimeScheduler{};
+    auto state = quietLink;
+    state.housekeepingIsPending = true;
+    auto slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::sendHousekeeping);
+
+    state.housekeepingIsPending = false;
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::receive);
+    CHECK(slot.duration == rf::rxTimeoutAfterTelemetryRecord);
+
+    // Without anything to send, the rest of the interval is idle
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::idle);
+    CHECK(slot.duration == state.remainingIntervalDuration);
+
+    // The RX window must leave enough time to handle the received data
+    state.housekeepingIsPending = true;
+    (void)scheduler.Schedule(state);
+    state.housekeepingIsPending = false;
+    state.remainingIntervalDuration = 4 * s;
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::receive);
+    CHECK(slot.duration == 2 * s);
+
+    // If there is not even time for the shortest RX window, it is skipped
+    state.housekeepingIsPending = true;
+    (void)scheduler.Schedule(state);
+    state.housekeepingIsPending = false;
+    state.remainingIntervalDuration = 2500 * ms;
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::idle);
+}
+
+
+TEST_CASE("RX window is shortened when frames are waiting and the ground is not active")
+{
+    auto scheduler = rf::AirtimeScheduler{};
+    auto state = quietLink;
+    state.nQueuedCfdpFrames = 3;
+    state.housekeepingIsPending = true;
+    (void)scheduler.Schedule(state);
+    state.housekeepingIsPending = false;
+    auto slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::receive);
+    CHECK(slot.duration == rf::minRxTimeout);
+    CHECK(scheduler.Statistics().nShortenedRxSlots == 1);
+
+    // The frames are sent until shortly before the next housekeeping report. Since the ground is
+    // not active, no RX window follows.
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::sendCfdpFrames);
+    CHECK(slot.duration == state.remainingIntervalDuration - rf::sendWindowMargin);
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::sendCfdpFrames);
+
+    // The send window also ends with the file transfer window
+    state.remainingFileTransferWindowDuration = 10 * s;
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::sendCfdpFrames);
+    CHECK(slot.duration == 10 * s - rf::sendWindowMargin);
+
+    // If not even one frame fits, nothing is sent
+    state.remainingIntervalDuration = rf::sendWindowMargin + 50 * ms;
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::idle);
+}
+
+
+TEST_CASE("RX window is not shortened before the ground talked to us in the current pass")
+{
+    auto scheduler = rf::AirtimeScheduler{};
+    auto state = quietLink;
+    state.nQueuedCfdpFrames = 3;
+    state.timeSinceLastUplink = rf::maxPassDuration;
+    state.housekeepingIsPending = true;
+    (void)scheduler.Schedule(state);
+    state.housekeepingIsPending = false;
+    auto slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::receive);
+    CHECK(slot.duration == rf::rxTimeoutAfterTelemetryRecord);
+    CHECK(scheduler.Statistics().nShortenedRxSlots == 0);
+
+    // The waiting frames are still sent after the RX window
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::sendCfdpFrames);
+}
+
+
+TEST_CASE("Active ground station gets longer RX windows")
+{
+    auto scheduler = rf::AirtimeScheduler{};
+    auto state = quietLink;
+    state.nQueuedCfdpFrames = 3;
+    state.timeSinceLastUplink = 10 * s;
+    state.housekeepingIsPending = true;
+    (void)scheduler.Schedule(state);
+    state.housekeepingIsPending = false;
+    auto slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::receive);
+    CHECK(slot.duration == rf::rxTimeoutAfterTelemetryRecord);
+    CHECK(scheduler.Statistics().nShortenedRxSlots == 0);
+
+    // As long as the ground station keeps sending, we keep receiving
+    state.uplinkIsActive = true;
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::receive);
+    CHECK(slot.duration == rf::rxTimeoutForAdditionalData);
+
+    // CFDP frames leave room for the ACK and NAK PDUs, which are received right after them
+    state.uplinkIsActive = false;
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::sendCfdpFrames);
+    CHECK(slot.duration
+          == state.remainingIntervalDuration - rf::sendWindowMargin - rf::minRxTimeout);
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::receive);
+    CHECK(slot.duration == rf::minRxTimeout);
+    slot = scheduler.Schedule(state);
+    CHECK(slot.activity == Activity::sendCfdpFrames);
+}
+
+
+TEST_CASE("Scheduler statistics")
+{
+    auto scheduler = rf::AirtimeScheduler{};
+    CHECK(scheduler.Statistics() == rf::SchedulerStatistics{});
+
+    auto state = quietLink;
+    state.nQueuedCfdpFrames = 20;
+    state.housekeepingIsPending = true;
+    (void)scheduler.Schedule(state);
+    state.housekeepingIsPending = false;
+    (void)scheduler.Schedule(state);
+    (void)scheduler.Schedule(state);
+    state.nQueuedCfdpFrames = 0;
+    (void)scheduler.Schedule(state);
+
+    auto statistics = scheduler.Statistics();
+    CHECK(statistics.nHousekeepingSlots == 1);
+    CHECK(statistics.nRxSlots == 1);
+    CHECK(statistics.nShortenedRxSlots == 1);
+    CHECK(statistics.nCfdpSlots == 1);
+    CHECK(statistics.nIdleSlots == 1);
+    CHECK(statistics.rxDurationInS == 1);
+    // Only the airtime of the queued frames counts, not the whole send window
+    CHECK(statistics.cfdpDurationInS == 2);
+
+    // Counters saturate instead of overflowing
+    for(auto i = 0; i < 70'000; ++i)
+    {
+        (void)scheduler.Schedule(state);
+    }
+    CHECK(scheduler.Statistics().nIdleSlots == UINT16_MAX);
+
+    auto serializedStatistics = sts1cobcsw::Serialize<std::endian::big>(statistics);
+    CHECK(serializedStatistics.size() == 18U);
+    auto deserializedStatistics =
+        sts1cobcsw::Deserialize<std::endian::big, rf::SchedulerStatistics>(serializedStatistics);
+    CHECK(deserializedStatistics == statistics);
+}
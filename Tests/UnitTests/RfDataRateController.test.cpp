@@ -0,0 +1,145 @@
+#include <Sts1CobcSw/Rf/DataRateController.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <cstdint>
+
+
+namespace rf = sts1cobcsw::rf;
+using rf::DataRateDecision;
+
+
+namespace
+{
+constexpr auto minDataRate = 2'400U;
+constexpr auto maxDataRate = 57'600U;
+constexpr auto goodQuality =
+    rf::UplinkQuality{.nGoodFrames = 4, .nCorrectedErrors = 4, .nRssiSamples = 1, .meanRssi = 80};
+}
+
+
+TEST_CASE("Data rate is not adaptive without valid bounds")
+{
+    CHECK(rf::DataRateIsAdaptive(minDataRate, maxDataRate));
+    CHECK(rf::DataRateIsAdaptive(9'600, 9'600));
+    CHECK(not rf::DataRateIsAdaptive(0, 0));
+    CHECK(not rf::DataRateIsAdaptive(9'600, 4'800));
+    CHECK(not rf::DataRateIsAdaptive(9'700, 19'100));
+
+    auto state = rf::DataRateControllerState{.dataRate = 9'600};
+    auto badQuality = rf::UplinkQuality{.nBadFrames = 1};
+    CHECK(rf::AdaptDataRate(&state, badQuality, 0, 0) == DataRateDecision::keep);
+    CHECK(state.dataRate == 9'600);
+}
+
+
+TEST_CASE("Data rate is clamped to the bounds")
+{
+    auto state = rf::DataRateControllerState{.dataRate = 115'200, .nGoodEvaluations = 2};
+    CHECK(rf::AdaptDataRate(&state, {}, minDataRate, maxDataRate)
+          == DataRateDecision::clampToBounds);
+    CHECK(state.dataRate == maxDataRate);
+    CHECK(state.nGoodEvaluations == 0);
+
+    state.dataRate = 1'200;
+    CHECK(rf::AdaptDataRate(&state, {}, minDataRate, maxDataRate)
+          == DataRateDecision::clampToBounds);
+    CHECK(state.dataRate == minDataRate);
+
+    // Bounds that are not supported data rates are rounded inwards
+    state.dataRate = 1'200;
+    CHECK(rf::AdaptDataRate(&state, {}, 3'000, 50'000) == DataRateDecision::clampToBounds);
+    CHECK(state.dataRate == 4'800);
+
+    // Without uplink data, a data rate within the bounds is kept
+    CHECK(rf::AdaptDataRate(&state, {}, minDataRate, maxDataRate) == DataRateDecision::keep);
+    CHECK(state.dataRate == 4'800);
+}
+
+
+TEST_CASE("Data rate is stepped down immediately on a bad uplink")
+{
+    auto state = rf::DataRateControllerState{.dataRate = 9'600, .nGoodEvaluations = 2};
+
+    SECTION("Bad frames")
+    {
+        auto quality = rf::UplinkQuality{.nGoodFrames = 10, .nBadFrames = 1};
+        CHECK(rf::AdaptDataRate(&state, quality, minDataRate, maxDataRate)
+              == DataRateDecision::stepDown);
+    }
+    SECTION("Many corrected errors")
+    {
+        auto quality = rf::UplinkQuality{
+            .nGoodFrames = 2, .nCorrectedErrors = 2 * rf::maxNCorrectedErrorsPerFrame + 1};
+        CHECK(rf::AdaptDataRate(&state, quality, minDataRate, maxDataRate)
+              == DataRateDecision::stepDown);
+    }
+    SECTION("Low RSSI")
+    {
+        auto quality = rf::UplinkQuality{
+            .nGoodFrames = 1, .nRssiSamples = 1, .meanRssi = rf::minRssi - 1};
+        CHECK(rf::AdaptDataRate(&state, quality, minDataRate, maxDataRate)
+              == DataRateDecision::stepDown);
+    }
+    CHECK(state.dataRate == 4'800);
+    CHECK(state.nGoodEvaluations == 0);
+
+    // The lower bound is never crossed
+    state.dataRate = minDataRate;
+    auto quality = rf::UplinkQuality{.nBadFrames = 1};
+    CHECK(rf::AdaptDataRate(&state, quality, minDataRate, maxDataRate) == DataRateDecision::keep);
+    CHECK(state.dataRate == minDataRate);
+}
+
+
+TEST_CASE("Data rate is stepped up after consecutive good evaluations")
+{
+    auto state = rf::DataRateControllerState{.dataRate = 19'200};
+    for(auto i = 1U; i < rf::nGoodEvaluationsToStepUp; ++i)
+    {
+        CHECK(rf::AdaptDataRate(&state, goodQuality, minDataRate, maxDataRate)
+              == DataRateDecision::keep);
+        CHECK(state.nGoodEvaluations == i);
+    }
+    CHECK(rf::AdaptDataRate(&state, goodQuality, minDataRate, maxDataRate)
+          == DataRateDecision::stepUp);
+    CHECK(state.dataRate == 38'400);
+    CHECK(state.nGoodEvaluations == 0);
+
+    // Evaluations without uplink data do not count
+    CHECK(rf::AdaptDataRate(&state, {}, minDataRate, maxDataRate) == DataRateDecision::keep);
+    CHECK(state.nGoodEvaluations == 0);
+
+    // The upper bound is never crossed
+    state.dataRate = maxDataRate;
+    for(auto i = 0U; i < 2 * rf::nGoodEvaluationsToStepUp; ++i)
+    {
+        CHECK(rf::AdaptDataRate(&state, goodQuality, minDataRate, maxDataRate)
+              == DataRateDecision::keep);
+    }
+    CHECK(state.dataRate == maxDataRate);
+    CHECK(state.nGoodEvaluations == rf::nGoodEvaluationsToStepUp);
+}
+
+
+TEST_CASE("Data rate is kept within the hysteresis band")
+{
+    auto state = rf::DataRateControllerState{.dataRate = 9'600, .nGoodEvaluations = 2};
+
+    SECTION("Some corrected errors")
+    {
+        auto quality = rf::UplinkQuality{
+            .nGoodFrames = 1, .nCorrectedErrors = rf::maxNCorrectedErrorsPerGoodFrame + 1};
+        CHECK(rf::AdaptDataRate(&state, quality, minDataRate, maxDataRate)
+              == DataRateDecision::keep);
+    }
+    SECTION("Mediocre RSSI")
+    {
+        auto quality = rf::UplinkQuality{
+            .nGoodFrames = 1, .nRssiSamples = 1, .meanRssi = rf::minRssiToStepUp - 1};
+        CHECK(rf::AdaptDataRate(&state, quality, minDataRate, maxDataRate)
+              == DataRateDecision::keep);
+    }
+    CHECK(state.dataRate == 9'600);
+    CHECK(state.nGoodEvaluations == 0);
+}
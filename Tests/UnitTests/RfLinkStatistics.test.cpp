@@ -0,0 +1,81 @@
+#include <Sts1CobcSw/Rf/LinkStatistics.hpp>
+#include <Sts1CobcSw/Serial/Serial.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <limits>
+
+
+namespace rf = sts1cobcsw::rf;
+
+
+TEST_CASE("Link statistics without samples")
+{
+    auto collector = rf::LinkStatisticsCollector{};
+    CHECK(collector.Get() == rf::LinkStatistics{});
+}
+
+
+TEST_CASE("Link statistics keep min, mean, and max of the samples")
+{
+    auto collector = rf::LinkStatisticsCollector{};
+    collector.AddSample(100, -20);
+    collector.AddSample(120, 10);
+    collector.AddSample(110, 4);
+    auto statistics = collector.Get();
+    CHECK(statistics.nSamples == 3);
+    CHECK(statistics.minRssi == 100);
+    CHECK(statistics.meanRssi == 110);
+    CHECK(statistics.maxRssi == 120);
+    CHECK(statistics.minAfcOffset == -20);
+    CHECK(statistics.meanAfcOffset == -2);
+    CHECK(statistics.maxAfcOffset == 10);
+
+    collector.Reset();
+    CHECK(collector.Get() == rf::LinkStatistics{});
+}
+
+
+TEST_CASE("Link statistics counters saturate")
+{
+    auto collector = rf::LinkStatisticsCollector{};
+    for(auto i = 0; i < std::numeric_limits<std::uint16_t>::max() + 10; ++i)
+    {
+        collector.CountRxFifoOverflow();
+        collector.AddSample(255, std::numeric_limits<std::int16_t>::min());
+    }
+    collector.CountTxFifoUnderrun();
+    collector.AddReceivedBytes(std::numeric_limits<std::uint32_t>::max() - 1U);
+    collector.AddReceivedBytes(100);
+    collector.AddSentBytes(223);
+    auto statistics = collector.Get();
+    CHECK(statistics.nRxFifoOverflows == std::numeric_limits<std::uint16_t>::max());
+    CHECK(statistics.nTxFifoUnderruns == 1);
+    CHECK(statistics.nSamples == std::numeric_limits<std::uint16_t>::max());
+    CHECK(statistics.meanRssi == 255);
+    CHECK(statistics.meanAfcOffset == std::numeric_limits<std::int16_t>::min());
+    CHECK(statistics.nReceivedBytes == std::numeric_limits<std::uint32_t>::max());
+    CHECK(statistics.nSentBytes == 223);
+}
+
+
+TEST_CASE("(De-)Serialization of LinkStatistics")
+{
+    static constexpr auto original = rf::LinkStatistics{.nSamples = 1,
+                                                         .minRssi = 2,
+                                                         .meanRssi = 3,
+                                                         .maxRssi = 4,
+                                                         .minAfcOffset = -5,
+                                                         .meanAfcOffset = 6,
+                                                         .maxAfcOffset = 7,
+                                                         .nRxFifoOverflows = 8,
+                                                         .nTxFifoUnderruns = 9,
+                                                         .nReceivedBytes = 10,
+                                                         .nSentBytes = 11};
+    auto serialized = sts1cobcsw::Serialize<std::endian::big>(original);
+    CHECK(serialized.size() == 23);
+    auto deserialized = sts1cobcsw::Deserialize<std::endian::big, rf::LinkStatistics>(serialized);
+    CHECK(deserialized == original);
+}
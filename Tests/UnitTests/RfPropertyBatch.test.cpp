@@ -0,0 +1,98 @@
+#include <Sts1CobcSw/Rf/PropertyBatch.hpp>
+#include <Sts1CobcSw/Rf/RfDataRateConfigs.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <algorithm>
+#include <array>
+#include <span>
+
+
+using sts1cobcsw::Byte;
+using sts1cobcsw::operator""_b;
+
+namespace rf = sts1cobcsw::rf;
+
+
+namespace
+{
+consteval auto BuildContiguousBatch() -> rf::PropertyBatch
+{
+    auto batch = rf::PropertyBatch();
+    batch.Set(rf::PropertyGroup::modem, 0x00_b, std::array{0x01_b, 0x02_b});
+    batch.Set(rf::PropertyGroup::modem, 0x02_b, std::array{0x03_b});
+    batch.Set(rf::PropertyGroup::modem, 0x05_b, std::array{0x04_b});
+    batch.Set(rf::PropertyGroup::pkt, 0x08_b, std::array{0x05_b, 0x06_b});
+    // Overwrite a property that was already set
+    batch.Set(rf::PropertyGroup::modem, 0x01_b, std::array{0x07_b});
+    return batch;
+}
+
+
+consteval auto BuildLongBatch() -> rf::PropertyBatch
+{
+    auto batch = rf::PropertyBatch();
+    batch.Set(rf::PropertyGroup::match, 0x00_b, std::array<Byte, 8>{});
+    batch.Set(rf::PropertyGroup::match, 0x08_b, std::array<Byte, 8>{});
+    batch.Set(rf::PropertyGroup::match, 0x10_b, std::array<Byte, 4>{});
+    return batch;
+}
+
+
+consteval auto BuildBatchWithOptionalProperties() -> rf::PropertyBatch
+{
+    auto batch = rf::PropertyBatch();
+    batch.Set(rf::PropertyGroup::modem, 0x00_b, std::array{0x00_b, 0x01_b, 0x02_b, 0x03_b, 0x04_b});
+    batch.Set(rf::PropertyGroup::modem, 0x10_b, std::array{0x10_b});
+    batch.MakeAllOptional();
+    batch.Set(rf::PropertyGroup::modem, 0x01_b, std::array{0x0A_b});
+    batch.Set(rf::PropertyGroup::modem, 0x03_b, std::array{0x0B_b});
+    batch.Set(rf::PropertyGroup::modem, 0x10_b, std::array{0x0C_b});
+    return batch;
+}
+
+
+auto Equal(std::span<Byte const> lhs, std::span<Byte const> rhs) -> bool
+{
+    return std::ranges::equal(lhs, rhs);
+}
+}
+
+
+TEST_CASE("Contiguous properties are merged into one SET_PROPERTY command")
+{
+    static constexpr auto commands =
+        BuildContiguousBatch().ToCommands<BuildContiguousBatch().NCommands()>();
+    REQUIRE(commands.size() == 3U);
+    CHECK(Equal(commands[0].Bytes(),
+                std::array{0x11_b, 0x20_b, 0x03_b, 0x00_b, 0x01_b, 0x07_b, 0x03_b}));
+    CHECK(Equal(commands[1].Bytes(), std::array{0x11_b, 0x20_b, 0x01_b, 0x05_b, 0x04_b}));
+    CHECK(Equal(commands[2].Bytes(), std::array{0x11_b, 0x12_b, 0x02_b, 0x08_b, 0x05_b, 0x06_b}));
+}
+
+
+TEST_CASE("SET_PROPERTY commands contain at most 12 properties")
+{
+    static constexpr auto commands = BuildLongBatch().ToCommands<BuildLongBatch().NCommands()>();
+    REQUIRE(commands.size() == 2U);
+    CHECK(commands[0].length == rf::maxSetPropertyCommandLength);
+    CHECK(commands[0].bytes[2] == 0x0C_b);
+    CHECK(commands[0].bytes[3] == 0x00_b);
+    CHECK(commands[1].length == rf::setPropertyHeaderLength + 8U);
+    CHECK(commands[1].bytes[2] == 0x08_b);
+    CHECK(commands[1].bytes[3] == 0x0C_b);
+}
+
+
+TEST_CASE("Optional properties are only written to fill gaps")
+{
+    static constexpr auto nCommands = BuildBatchWithOptionalProperties().NCommands();
+    static constexpr auto commands = BuildBatchWithOptionalProperties().ToCommands<nCommands>();
+    REQUIRE(commands.size() == 2U);
+    // The optional property 0x02 fills the gap between 0x01 and 0x03, but 0x00 and 0x04 are dropped
+    CHECK(Equal(commands[0].Bytes(),
+                std::array{0x11_b, 0x20_b, 0x03_b, 0x01_b, 0x0A_b, 0x02_b, 0x0B_b}));
+    // Required properties overwrite optional ones
+    CHECK(Equal(commands[1].Bytes(), std::array{0x11_b, 0x20_b, 0x01_b, 0x10_b, 0x0C_b}));
+}
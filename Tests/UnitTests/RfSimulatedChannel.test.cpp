@@ -0,0 +1,401 @@
+#include <Tests/CatchRodos/TestMacros.hpp>
+
+#include <Sts1CobcSw/ChannelCoding/ChannelCoding.hpp>
+#include <Sts1CobcSw/Fram/Fram.hpp>
+#include <Sts1CobcSw/Fram/FramMock.hpp>
+#include <Sts1CobcSw/Mailbox/Mailbox.hpp>
+#include <Sts1CobcSw/Mailbox/RingQueue.hpp>
+#include <Sts1CobcSw/Rf/Rf.hpp>
+#include <Sts1CobcSw/Rf/RfMock.hpp>
+#include <Sts1CobcSw/Rf/TcBlockPool.hpp>
+#include <Sts1CobcSw/RfProtocols/Configuration.hpp>
+#include <Sts1CobcSw/RfProtocols/Reports.hpp>
+#include <Sts1CobcSw/RfProtocols/SpacePacket.hpp>
+#include <Sts1CobcSw/RodosTime/RodosTime.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Serial/Serial.hpp>
+#include <Sts1CobcSw/Telemetry/TelemetryRecord.hpp>
+#include <Sts1CobcSw/TmTransmission/TmTransmission.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <strong_type/affine_point.hpp>
+#include <strong_type/difference.hpp>
+#include <strong_type/ordered.hpp>
+#include <strong_type/type.hpp>
+
+#include <rodos_no_using_namespace.h>
+
+#include <etl/vector.h>
+
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+
+namespace sts1cobcsw
+{
+namespace
+{
+[[nodiscard]] auto IsHousekeepingPacket(std::span<Byte const, tm::blockLength> block) -> bool;
+
+
+constexpr auto dataRate = 115'200U;
+constexpr auto nFrames = 10;
+
+auto nDecodedFrames = 0;
+auto nFailedFrames = 0;
+auto nHousekeepingPackets = 0;
+// The first byte of every decoded frame, which the CFDP frames use as an index
+auto decodedFrameIndexes = etl::vector<Byte, cfdpFrameQueueCapacity>{};
+
+auto uplinkMessage = std::array<Byte, tc::messageLength>{};
+auto uplinkBlock = std::array<Byte, tc::blockLength>{};
+auto nUplinkBlocksLeft = 0;
+
+auto pool = rf::TcBlockPool{};
+auto cfdpFrameQueue = CfdpFrameQueue{};
+auto telemetryRecordMailbox = Mailbox<TelemetryRecord>{};
+// If this is positive, the CFDP frame queue is cleared in the PrepareForTx() call that decrements
+// it to 0, like the file transfer thread does when a transfer is canceled
+auto nTxPreparationsUntilQueueIsCleared = 0;
+
+
+// The ground station decodes every frame it receives
+auto DecodeDownlinkFrame(std::span<Byte const> data) -> void
+{
+    auto block = std::array<Byte, tm::blockLength>{};
+    std::ranges::copy(data.subspan(attachedSynchMarkerLength, tm::blockLength), block.begin());
+    if(tm::Decode(block).has_value())
+    {
+        ++nDecodedFrames;
+        if(IsHousekeepingPacket(block))
+        {
+            ++nHousekeepingPackets;
+        }
+        if(not decodedFrameIndexes.full())
+        {
+            decodedFrameIndexes.push_back(block[0]);
+        }
+    }
+    else
+    {
+        ++nFailedFrames;
+    }
+}
+
+
+// The ground station only checks the headers of the space packet in the frame
+auto IsHousekeepingPacket(std::span<Byte const, tm::blockLength> block) -> bool
+{
+    auto packet = block.subspan<tm::transferFramePrimaryHeaderLength>();
+    auto primaryHeader = SpacePacketPrimaryHeader{};
+    (void)DeserializeFrom<ccsdsEndianness>(packet.data(), &primaryHeader);
+    auto secondaryHeader = packet.subspan<packetPrimaryHeaderLength>();
+    return primaryHeader.packetType == telemetryPacketType and primaryHeader.apid == normalApid
+       and secondaryHeader[1] == Byte{3} and secondaryHeader[2] == Byte{25};
+}
+
+
+auto SendUplinkBlock(std::span<Byte> data) -> std::size_t
+{
+    if(nUplinkBlocksLeft == 0 or data.size() < uplinkBlock.size())
+    {
+        return 0;
+    }
+    --nUplinkBlocksLeft;
+    std::ranges::copy(uplinkBlock, data.begin());
+    return uplinkBlock.size();
+}
+
+
+// Send one housekeeping report per transmission, like the RF communication thread does
+auto SendFrames(int n) -> void
+{
+    nDecodedFrames = 0;
+    nFailedFrames = 0;
+    nHousekeepingPackets = 0;
+    for(auto i = 0; i < n; ++i)
+    {
+        SendAndWait(HousekeepingParameterReport(TelemetryRecord{}));
+    }
+}
+
+
+auto Airtime(std::size_t nBytes) -> Duration
+{
+    return static_cast<std::int64_t>(nBytes * CHAR_BIT) * s / static_cast<std::int64_t>(dataRate);
+}
+
+
+auto QueueCfdpFrames(int n) -> void
+{
+    nDecodedFrames = 0;
+    nFailedFrames = 0;
+    decodedFrameIndexes.clear();
+    for(auto i = 0; i < n; ++i)
+    {
+        auto frame = std::array<Byte, tm::transferFrameLength>{};
+        frame[0] = static_cast<Byte>(i);
+        CHECK(cfdpFrameQueue.Put(frame).has_value());
+    }
+}
+
+
+// Return the goodput in bytes/s
+auto Goodput(int nFrames, Duration duration) -> std::int64_t
+{
+    return static_cast<std::int64_t>(nFrames) * static_cast<std::int64_t>(tm::messageLength) * s
+         / duration;
+}
+}
+
+
+// The RF communication thread does not run in this test, so nothing is received before sending
+auto PrepareForTx() -> void
+{
+    if(nTxPreparationsUntilQueueIsCleared > 0)
+    {
+        --nTxPreparationsUntilQueueIsCleared;
+        if(nTxPreparationsUntilQueueIsCleared == 0)
+        {
+            cfdpFrameQueue.Clear();
+        }
+    }
+}
+
+
+
+TEST_INIT("Initialize the simulated RF channel")
+{
+    // The housekeeping reports contain the real time, which needs the FRAM
+    fram::ram::SetAllDoFunctions();
+    fram::ram::memory.fill(0x00_b);
+    fram::Initialize();
+    for(auto i = 0U; i < tc::messageLength; ++i)
+    {
+        uplinkMessage[i] = static_cast<Byte>(i * 3U);
+    }
+    std::ranges::copy(uplinkMessage, uplinkBlock.begin());
+    tc::Encode(uplinkBlock);
+    rf::SetDownlinkHandler(DecodeDownlinkFrame);
+    rf::SetUplinkSource(SendUplinkBlock);
+}
+
+
+TEST_CASE("Downlink over an error-free channel")
+{
+    REQUIRE(rf::Initialize().has_value());
+    rf::SetChannelModel({});
+    rf::SetTxDataRate(dataRate);
+    rf::SetTxCodingProfile(CodingProfile::reedSolomonAndConvolutional);
+
+    // Nothing is sent while TX is off
+    rf::DisableTx();
+    SendFrames(1);
+    CHECK(nDecodedFrames == 0);
+
+    rf::EnableTx();
+    auto start = CurrentRodosTime();
+    SendFrames(1);
+    auto duration = CurrentRodosTime() - start;
+    CHECK(nDecodedFrames == 1);
+    CHECK(nHousekeepingPackets == 1);
+    auto airtime = Airtime(
+        tm::FullyEncodedFrameLength(CodingProfile::reedSolomonAndConvolutional));
+    CHECK(rf::GetChannelStatistics().txAirtime == airtime);
+    CHECK(FrameSendDuration() == airtime);
+    CHECK(duration >= airtime);
+    CHECK(rf::GetChannelStatistics().nFlippedBits == 0U);
+}
+
+
+TEST_CASE("Housekeeping dump in one continuous transmission")
+{
+    REQUIRE(rf::Initialize().has_value());
+    rf::EnableTx();
+    rf::SetChannelModel({.bitErrorRate = 1e-3, .postTxDelay = 100 * ms});
+    rf::SetTxDataRate(dataRate);
+    rf::SetTxCodingProfile(CodingProfile::reedSolomonAndConvolutional);
+
+    nDecodedFrames = 0;
+    nHousekeepingPackets = 0;
+    auto start = CurrentRodosTime();
+    SetTxDataLength(static_cast<std::uint16_t>(nFrames));
+    for(auto i = 0; i < nFrames; ++i)
+    {
+        SendAndContinue(HousekeepingParameterReport(TelemetryRecord{}));
+    }
+    FinalizeTransmission();
+    auto duration = CurrentRodosTime() - start;
+    CHECK(nDecodedFrames == nFrames);
+    CHECK(nHousekeepingPackets == nFrames);
+    CHECK(rf::GetChannelStatistics().txAirtime == nFrames * FrameSendDuration());
+    // Only the last frame is followed by the post-TX delay
+    CHECK(duration < nFrames * FrameSendDuration() + 2 * 100 * ms);
+}
+
+
+TEST_CASE("Goodput depends on the bit error rate")
+{
+    REQUIRE(rf::Initialize().has_value());
+    rf::EnableTx();
+    rf::SetTxDataRate(dataRate);
+    rf::SetTxCodingProfile(CodingProfile::reedSolomonAndConvolutional);
+
+    // About 2 bit errors per frame are easily corrected
+    rf::SetChannelModel({.bitErrorRate = 1e-3});
+    SendFrames(nFrames);
+    CHECK(nDecodedFrames == nFrames);
+    CHECK(rf::GetChannelStatistics().nFlippedBits > 0U);
+
+    // So is a burst error of 10 bytes
+    rf::SetChannelModel({.burstErrorProbability = 1.0, .burstLength = 10});
+    SendFrames(nFrames);
+    CHECK(nDecodedFrames == nFrames);
+    CHECK(rf::GetChannelStatistics().nBurstErrors == static_cast<std::uint32_t>(nFrames));
+
+    // About 40 bit errors per frame are too much for the Reed-Solomon code
+    rf::SetChannelModel({.bitErrorRate = 2e-2});
+    SendFrames(nFrames);
+    CHECK(nDecodedFrames < nFrames);
+    CHECK(nDecodedFrames + nFailedFrames == nFrames);
+}
+
+
+TEST_CASE("Uplink bursts and RX/TX turnaround")
+{
+    REQUIRE(rf::Initialize().has_value());
+    rf::EnableTx();
+    rf::SetRxDataRate(dataRate);
+    rf::SetTxDataRate(dataRate);
+    static constexpr auto rxTxSwitchDuration = 20 * ms;
+    // 20 corrupted bytes can only be corrected because they are flagged as suspect
+    rf::SetChannelModel({.burstErrorProbability = 1.0,
+                         .burstLength = 20,
+                         .rxTxSwitchDuration = rxTxSwitchDuration});
+
+    // Nothing is received if the ground station does not send anything
+    auto blocks = rf::ReceivedTcBlocks{};
+    CHECK(rf::ReceiveBurst(&pool, &blocks, 20 * ms) == 0U);
+    CHECK(pool.NAvailableBlocks() == rf::nTcBlockBuffers);
+
+    nUplinkBlocksLeft = 3;
+    auto start = CurrentRodosTime();
+    CHECK(rf::ReceiveBurst(&pool, &blocks, 1 * s) == 3U);
+    CHECK(CurrentRodosTime() - start >= 3 * Airtime(attachedSynchMarkerLength + tc::blockLength));
+    CHECK(blocks.size() == 3U);
+    for(auto * block : blocks)
+    {
+        REQUIRE(block->suspectByteRanges.size() == 1U);
+        auto erasurePositions = etl::vector<std::uint8_t, rs::maxNErasures>{};
+        for(auto i = block->suspectByteRanges[0].begin; i < block->suspectByteRanges[0].end; ++i)
+        {
+            erasurePositions.push_back(static_cast<std::uint8_t>(i));
+        }
+        auto decodeResult = tc::Decode(block->data, erasurePositions);
+        CHECK(decodeResult.has_value());
+        CHECK(std::ranges::equal(std::span(block->data).first<tc::messageLength>(), uplinkMessage));
+        pool.Release(block);
+    }
+
+    // Switching from RX to TX takes time
+    start = CurrentRodosTime();
+    SendFrames(1);
+    CHECK(CurrentRodosTime() - start >= rxTxSwitchDuration);
+    CHECK(rf::GetChannelStatistics().nRxTxSwitches == 1U);
+}
+
+
+TEST_CASE("Continuous CFDP bursts increase the goodput")
+{
+    REQUIRE(rf::Initialize().has_value());
+    rf::EnableTx();
+    rf::SetTxDataRate(dataRate);
+    rf::SetTxCodingProfile(CodingProfile::reedSolomonAndConvolutional);
+    rf::SetChannelModel({.postTxDelay = 100 * ms});
+    static constexpr auto nCfdpFrames = static_cast<int>(cfdpFrameQueueCapacity);
+
+    // One transmission per frame
+    auto start = CurrentRodosTime();
+    SendFrames(nCfdpFrames);
+    auto singleFrameGoodput = Goodput(nCfdpFrames, CurrentRodosTime() - start);
+    CHECK(nDecodedFrames == nCfdpFrames);
+
+    // SendCfdpFrames() sends all queued frames in one continuous transmission
+    QueueCfdpFrames(nCfdpFrames);
+    start = CurrentRodosTime();
+    SendCfdpFrames(&cfdpFrameQueue, &telemetryRecordMailbox, endOfTime);
+    auto burstGoodput = Goodput(nCfdpFrames, CurrentRodosTime() - start);
+    CHECK(nDecodedFrames == nCfdpFrames);
+    CHECK(cfdpFrameQueue.IsEmpty());
+    for(auto i = 0; i < nCfdpFrames; ++i)
+    {
+        CHECK(decodedFrameIndexes[static_cast<std::size_t>(i)] == static_cast<Byte>(i));
+    }
+
+    RODOS::PRINTF("Goodput with %d CFDP frames at %u bit/s: %d B/s single frames, %d B/s burst\n",
+                  nCfdpFrames,
+                  dataRate,
+                  static_cast<int>(singleFrameGoodput),
+                  static_cast<int>(burstGoodput));
+    CHECK(burstGoodput > 2 * singleFrameGoodput);
+}
+
+
+TEST_CASE("CFDP bursts stop at the end of the send window and for new telemetry")
+{
+    REQUIRE(rf::Initialize().has_value());
+    rf::EnableTx();
+    rf::SetTxDataRate(dataRate);
+    rf::SetTxCodingProfile(CodingProfile::reedSolomonAndConvolutional);
+    rf::SetChannelModel({.postTxDelay = 100 * ms});
+    static constexpr auto nCfdpFrames = static_cast<int>(cfdpFrameQueueCapacity);
+    QueueCfdpFrames(nCfdpFrames);
+
+    // Only the frames that fit into the send window are sent
+    SendCfdpFrames(
+        &cfdpFrameQueue, &telemetryRecordMailbox, CurrentRodosTime() + 3 * FrameSendDuration());
+    CHECK(nDecodedFrames == 3);
+    CHECK(cfdpFrameQueue.Size() == static_cast<std::size_t>(nCfdpFrames - 3));
+
+    // A new telemetry record takes precedence
+    REQUIRE(telemetryRecordMailbox.Put(TelemetryRecord{}).has_value());
+    SendCfdpFrames(&cfdpFrameQueue, &telemetryRecordMailbox, endOfTime);
+    CHECK(nDecodedFrames == 3);
+    (void)telemetryRecordMailbox.Get();
+
+    // The remaining frames are sent in order
+    SendCfdpFrames(&cfdpFrameQueue, &telemetryRecordMailbox, endOfTime);
+    CHECK(nDecodedFrames == nCfdpFrames);
+    CHECK(cfdpFrameQueue.IsEmpty());
+    for(auto i = 0; i < nCfdpFrames; ++i)
+    {
+        CHECK(decodedFrameIndexes[static_cast<std::size_t>(i)] == static_cast<Byte>(i));
+    }
+}
+
+
+TEST_CASE("CFDP bursts are filled with idle frames if the queue is cleared in between")
+{
+    REQUIRE(rf::Initialize().has_value());
+    rf::EnableTx();
+    rf::SetTxDataRate(dataRate);
+    rf::SetTxCodingProfile(CodingProfile::reedSolomonAndConvolutional);
+    static constexpr auto nCfdpFrames = static_cast<int>(cfdpFrameQueueCapacity);
+    QueueCfdpFrames(nCfdpFrames);
+
+    // SetTxDataLength() and sending the first two frames prepare for TX. Then the queue is cleared.
+    nTxPreparationsUntilQueueIsCleared = 3;
+    SendCfdpFrames(&cfdpFrameQueue, &telemetryRecordMailbox, endOfTime);
+    CHECK(nTxPreparationsUntilQueueIsCleared == 0);
+    CHECK(cfdpFrameQueue.IsEmpty());
+    // The whole announced burst is sent and the ground station decodes the idle frames too
+    CHECK(nDecodedFrames == nCfdpFrames);
+    CHECK(nFailedFrames == 0);
+    CHECK(decodedFrameIndexes[0] == Byte{0});
+    CHECK(decodedFrameIndexes[1] == Byte{1});
+}
+}
@@ -0,0 +1,52 @@
+#include <Tests/CatchRodos/TestMacros.hpp>
+
+#include <Sts1CobcSw/Rf/TcBlockPool.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+
+#include <array>
+
+
+namespace sts1cobcsw
+{
+auto pool = rf::TcBlockPool{};
+
+
+TEST_CASE("TcBlockPool")
+{
+    CHECK(pool.NAvailableBlocks() == rf::nTcBlockBuffers);
+
+    auto blocks = std::array<rf::ReceivedTcBlock *, rf::nTcBlockBuffers>{};
+    for(auto i = 0U; i < blocks.size(); ++i)
+    {
+        blocks[i] = pool.Acquire();
+        REQUIRE(blocks[i] != nullptr);
+        CHECK(pool.NAvailableBlocks() == rf::nTcBlockBuffers - i - 1U);
+    }
+    for(auto i = 1U; i < blocks.size(); ++i)
+    {
+        CHECK(blocks[i] != blocks[i - 1U]);
+    }
+    CHECK(pool.Acquire() == nullptr);
+    CHECK(pool.NAvailableBlocks() == 0U);
+
+    // A released block is handed out again with its suspect byte ranges cleared
+    blocks[3]->suspectByteRanges.push_back({.begin = 1, .end = 2});
+    blocks[3]->data[0] = 0xAB_b;
+    pool.Release(blocks[3]);
+    CHECK(pool.NAvailableBlocks() == 1U);
+    auto * block = pool.Acquire();
+    CHECK(block == blocks[3]);
+    CHECK(block->suspectByteRanges.empty());
+    CHECK(pool.NAvailableBlocks() == 0U);
+
+    // Releasing nullptr does nothing
+    pool.Release(nullptr);
+    CHECK(pool.NAvailableBlocks() == 0U);
+
+    for(auto * b : blocks)
+    {
+        pool.Release(b);
+    }
+    CHECK(pool.NAvailableBlocks() == rf::nTcBlockBuffers);
+}
+}
@@ -0,0 +1,121 @@
+#include <Tests/CatchRodos/TestMacros.hpp>
+#include <Tests/Utility/Stringification.hpp>  // IWYU pragma: keep
+
+#include <Sts1CobcSw/Mailbox/RingQueue.hpp>
+#include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/RodosTime/RodosTime.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <strong_type/affine_point.hpp>
+#include <strong_type/difference.hpp>
+#include <strong_type/type.hpp>
+
+#include <utility>
+
+
+namespace sts1cobcsw
+{
+TEST_CASE("RingQueue")
+{
+    auto queue = RingQueue<int, 4>{};
+    CHECK(queue.Capacity() == 4U);
+    CHECK(queue.IsEmpty());
+    CHECK(queue.IsFull() == false);
+    CHECK(queue.Size() == 0U);
+
+    auto getResult = queue.Get();
+    CHECK(getResult.has_error());
+    CHECK(getResult.error() == ErrorCode::empty);
+    auto peekResult = queue.Peek();
+    CHECK(peekResult.has_error());
+    CHECK(peekResult.error() == ErrorCode::empty);
+
+    auto suspendResult = queue.SuspendUntilNotEmptyOr(CurrentRodosTime() + 1 * ms);
+    CHECK(suspendResult.has_error());
+    CHECK(suspendResult.error() == ErrorCode::timeout);
+    suspendResult = queue.SuspendUntilNotFullOr(CurrentRodosTime() + 1 * ms);
+    CHECK(suspendResult.has_value());
+
+    for(auto i = 0; i < 4; ++i)
+    {
+        auto putResult = queue.Put(i);
+        CHECK(putResult.has_value());
+    }
+    CHECK(queue.IsEmpty() == false);
+    CHECK(queue.IsFull());
+    CHECK(queue.Size() == 4U);
+
+    auto putResult = queue.Put(4);
+    CHECK(putResult.has_error());
+    CHECK(putResult.error() == ErrorCode::full);
+
+    suspendResult = queue.SuspendUntilNotFullOr(CurrentRodosTime() + 1 * ms);
+    CHECK(suspendResult.has_error());
+    CHECK(suspendResult.error() == ErrorCode::timeout);
+    suspendResult = queue.SuspendUntilNotEmptyOr(CurrentRodosTime() + 1 * ms);
+    CHECK(suspendResult.has_value());
+
+    // Messages come out in the order they were put in
+    peekResult = queue.Peek();
+    CHECK(peekResult.has_value());
+    CHECK(peekResult.value() == 0);
+    CHECK(queue.Size() == 4U);
+    for(auto i = 0; i < 2; ++i)
+    {
+        getResult = queue.Get();
+        CHECK(getResult.has_value());
+        CHECK(getResult.value() == i);
+    }
+    CHECK(queue.Size() == 2U);
+
+    // The queue wraps around
+    for(auto i = 4; i < 6; ++i)
+    {
+        putResult = queue.Put(i);
+        CHECK(putResult.has_value());
+    }
+    CHECK(queue.IsFull());
+    for(auto i = 2; i < 6; ++i)
+    {
+        getResult = queue.Get();
+        CHECK(getResult.has_value());
+        CHECK(getResult.value() == i);
+    }
+    CHECK(queue.IsEmpty());
+    CHECK(queue.Size() == 0U);
+
+    // PutFront() jumps ahead of all queued messages
+    for(auto i = 0; i < 3; ++i)
+    {
+        putResult = queue.Put(i);
+        CHECK(putResult.has_value());
+    }
+    putResult = queue.PutFront(-1);
+    CHECK(putResult.has_value());
+    CHECK(queue.IsFull());
+    putResult = queue.PutFront(-2);
+    CHECK(putResult.has_error());
+    CHECK(putResult.error() == ErrorCode::full);
+    for(auto i = -1; i < 3; ++i)
+    {
+        getResult = queue.Get();
+        CHECK(getResult.has_value());
+        CHECK(getResult.value() == i);
+    }
+
+    // Clear() drops all queued messages
+    for(auto i = 0; i < 3; ++i)
+    {
+        putResult = queue.Put(i);
+        CHECK(putResult.has_value());
+    }
+    queue.Clear();
+    CHECK(queue.IsEmpty());
+    CHECK(queue.Size() == 0U);
+    putResult = queue.Put(7);
+    CHECK(putResult.has_value());
+    getResult = queue.Get();
+    CHECK(getResult.has_value());
+    CHECK(getResult.value() == 7);
+}
+}
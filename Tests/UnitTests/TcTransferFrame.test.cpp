@@ -90,4 +90,13 @@ TEST_CASE("Parsing TC Transfer Frames")
     parseResult = sts1cobcsw::tc::ParseAsTransferFrame(buffer);
     CHECK(parseResult.has_error());
     CHECK(parseResult.error() == sts1cobcsw::ErrorCode::authenticationFailed);
+
+    // A precomputed MAC is used instead of computing it over the buffer
+    auto correctMac = std::array{0x38_b, 0x34_b, 0x83_b, 0x8B_b, 0x28_b, 0xA3_b, 0xF6_b, 0x00_b};
+    parseResult = sts1cobcsw::tc::ParseAsTransferFrame(buffer, correctMac);
+    CHECK(parseResult.has_value());
+    buffer[sts1cobcsw::tc::transferFrameLength - 1] = 0x2C_b;
+    parseResult = sts1cobcsw::tc::ParseAsTransferFrame(buffer, correctMac);
+    CHECK(parseResult.has_error());
+    CHECK(parseResult.error() == sts1cobcsw::ErrorCode::authenticationFailed);
 }
@@ -66,10 +66,30 @@ TEST_CASE("(De-)Serialization of TelemetryRecord")
             .nUncorrectableUplinkErrors = 56U,
             .nGoodTransferFrames = 57U,
             .nBadTransferFrames = 58U,
-            .lastFrameSequenceNumber = 59U,
-            .lastMessageTypeId = {60U, 61U},
+            .nDroppedPdus = 59U,
+            .lastFrameSequenceNumber = 60U,
+            .lastMessageTypeId = {61U, 62U},
             .fileTransferStatus = sts1cobcsw::FileTransferStatus::sending,
-            .transactionSequenceNumber = 62U
+            .transactionSequenceNumber = 63U,
+            .linkStatistics = {.nSamples = 64U,
+                               .minRssi = 65U,
+                               .meanRssi = 66U,
+                               .maxRssi = 67U,
+                               .minAfcOffset = -68,
+                               .meanAfcOffset = 69,
+                               .maxAfcOffset = 70,
+                               .nRxFifoOverflows = 71U,
+                               .nTxFifoUnderruns = 72U,
+                               .nReceivedBytes = 73U,
+                               .nSentBytes = 74U},
+            .lastTxDataRateDecision = sts1cobcsw::rf::DataRateDecision::stepDown,
+            .schedulerStatistics = {.nHousekeepingSlots = 75U,
+                                    .nRxSlots = 76U,
+                                    .nShortenedRxSlots = 77U,
+                                    .nCfdpSlots = 78U,
+                                    .nIdleSlots = 79U,
+                                    .rxDurationInS = 80U,
+                                    .cfdpDurationInS = 81U}
         };
         auto serializedRecord = Serialize<std::endian::big>(originalRecord);
         auto deserializedRecord = Deserialize<std::endian::big, TelemetryRecord>(serializedRecord);
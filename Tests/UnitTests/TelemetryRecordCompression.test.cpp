@@ -0,0 +1,170 @@
+#include <Sts1CobcSw/Outcome/Outcome.hpp>
+#include <Sts1CobcSw/Serial/Byte.hpp>
+#include <Sts1CobcSw/Serial/Serial.hpp>
+#include <Sts1CobcSw/Telemetry/TelemetryRecord.hpp>
+#include <Sts1CobcSw/Telemetry/TelemetryRecordCompression.hpp>
+#include <Sts1CobcSw/Vocabulary/Time.hpp>
+
+#include <catch2/catch_test_macros.hpp>
+
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+
+using sts1cobcsw::Byte;
+using sts1cobcsw::Compress;
+using sts1cobcsw::Decompress;
+using sts1cobcsw::ErrorCode;
+using sts1cobcsw::RealTime;
+using sts1cobcsw::SerialBuffer;
+using sts1cobcsw::Serialize;
+using sts1cobcsw::serialSize;
+using sts1cobcsw::TelemetryRecord;
+
+
+namespace
+{
+// Records as they are taken every 30 s: the time advances, the sensor values are a little noisy,
+// and a few counters increase from time to time
+auto MakeRecords(int nRecords) -> std::vector<TelemetryRecord>;
+}
+
+
+TEST_CASE("Compressed telemetry records can be decompressed")
+{
+    auto records = MakeRecords(20);
+    auto reference = Serialize<std::endian::big>(TelemetryRecord{});
+    auto compressedData = std::vector<Byte>{};
+    for(auto const & record : records)
+    {
+        auto serializedRecord = Serialize<std::endian::big>(record);
+        auto compressedRecord = Compress(serializedRecord, reference);
+        compressedData.insert(
+            compressedData.end(), compressedRecord.begin(), compressedRecord.end());
+        reference = serializedRecord;
+    }
+
+    // On ground, the records are decompressed in the same order
+    auto data = std::span<Byte const>(compressedData);
+    auto record = Serialize<std::endian::big>(TelemetryRecord{});
+    for(auto const & originalRecord : records)
+    {
+        auto decompressResult = Decompress(&data, &record);
+        REQUIRE(decompressResult.has_value());
+        auto decompressedRecord =
+            sts1cobcsw::Deserialize<std::endian::big, TelemetryRecord>(record);
+        CHECK(decompressedRecord == originalRecord);
+    }
+    CHECK(data.empty());
+}
+
+
+TEST_CASE("Consecutive telemetry records compress well")
+{
+    auto records = MakeRecords(2);
+    auto first = Serialize<std::endian::big>(records[0]);
+    auto second = Serialize<std::endian::big>(records[1]);
+
+    // Even the first record is smaller than the uncompressed one since many bytes are still at
+    // their default value
+    auto compressedFirst = Compress(first, Serialize<std::endian::big>(TelemetryRecord{}));
+    CHECK(compressedFirst.size() < serialSize<TelemetryRecord>);
+    auto compressedSecond = Compress(second, first);
+    CHECK(compressedSecond.size() * 4 < serialSize<TelemetryRecord>);
+
+    // A record that did not change takes one bit per byte
+    auto compressedSame = Compress(second, second);
+    CHECK(compressedSame.size() == (serialSize<TelemetryRecord> + 7) / 8);
+}
+
+
+TEST_CASE("Large differences are compressed losslessly")
+{
+    auto reference = SerialBuffer<TelemetryRecord>{};
+    auto record = SerialBuffer<TelemetryRecord>{};
+    for(auto i = 0U; i < record.size(); ++i)
+    {
+        // Covers all differences from -128 to 127 several times
+        reference[i] = static_cast<Byte>(i * 7U);
+        record[i] = static_cast<Byte>(i * 13U);
+    }
+    auto compressedRecord = Compress(record, reference);
+    CHECK(compressedRecord.size() <= sts1cobcsw::maxCompressedTelemetryRecordSize);
+
+    auto data = std::span<Byte const>(compressedRecord.data(), compressedRecord.size());
+    auto decompressedRecord = reference;
+    auto decompressResult = Decompress(&data, &decompressedRecord);
+    CHECK(decompressResult.has_value());
+    CHECK(decompressedRecord == record);
+    CHECK(data.empty());
+}
+
+
+TEST_CASE("Decompressing truncated data fails")
+{
+    auto records = MakeRecords(1);
+    auto reference = Serialize<std::endian::big>(TelemetryRecord{});
+    auto compressedRecord = Compress(Serialize<std::endian::big>(records[0]), reference);
+
+    auto data = std::span<Byte const>(compressedRecord.data(), compressedRecord.size() - 1);
+    auto record = reference;
+    auto decompressResult = Decompress(&data, &record);
+    CHECK(decompressResult.has_error());
+    CHECK(decompressResult.error() == ErrorCode::bufferTooSmall);
+    // Neither the data nor the reference are changed
+    CHECK(data.size() == compressedRecord.size() - 1);
+    CHECK(record == reference);
+}
+
+
+namespace
+{
+auto MakeRecords(int nRecords) -> std::vector<TelemetryRecord>
+{
+    auto records = std::vector<TelemetryRecord>{};
+    auto record = TelemetryRecord{.framIsWorking = 1,
+                                  .epsIsWorking = 1,
+                                  .flashIsWorking = 1,
+                                  .rfIsWorking = 1,
+                                  .nTotalResets = 1234U,
+                                  .rodosTimeInSeconds = 5'000,
+                                  .realTime = RealTime(1'750'000'000),
+                                  .cobcTemperature = 2'000U,
+                                  .rfTemperature = 2'100U,
+                                  .rxDataRate = 9'600,
+                                  .txDataRate = 9'600};
+    for(auto i = 0U; i < record.epsAdcData.adc4.size(); ++i)
+    {
+        record.epsAdcData.adc4[i] = static_cast<std::uint16_t>(1'000U + 100U * i);
+    }
+    for(auto i = 0U; i < record.epsAdcData.adc5.size(); ++i)
+    {
+        record.epsAdcData.adc5[i] = static_cast<std::uint16_t>(2'000U + 100U * i);
+    }
+    for(auto i = 0U; i < record.epsAdcData.adc6.size(); ++i)
+    {
+        record.epsAdcData.adc6[i] = static_cast<std::uint16_t>(3'000U + 100U * i);
+    }
+    for(auto n = 0; n < nRecords; ++n)
+    {
+        records.push_back(record);
+        record.rodosTimeInSeconds += 30;
+        record.realTime = RealTime(value_of(record.realTime) + 30);
+        // Alternate the noise so that the values stay in range
+        auto noise = (n % 2 == 0) ? 3 : -3;
+        record.cobcTemperature = static_cast<std::uint16_t>(record.cobcTemperature + noise);
+        for(auto & value : record.epsAdcData.adc4)
+        {
+            value = static_cast<std::uint16_t>(value + noise);
+        }
+        auto & adcValue = record.epsAdcData.adc5[static_cast<unsigned>(n) % 10U];
+        adcValue = static_cast<std::uint16_t>(adcValue + 2U);
+        record.nGoodTransferFrames = static_cast<std::uint16_t>(record.nGoodTransferFrames + n % 3);
+        record.schedulerStatistics.nHousekeepingSlots++;
+        record.schedulerStatistics.nIdleSlots++;
+    }
+    return records;
+}
+}
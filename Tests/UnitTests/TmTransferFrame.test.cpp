@@ -44,9 +44,9 @@ private:
 
 TEST_CASE("TM Transfer Frame")
 {
-    auto block = std::array<Byte, blockLength>{};
+    auto block = std::array<Byte, tm::blockLength>{};
     auto frame = tm::TransferFrame(Span(&block).first<tm::transferFrameLength>());
-    CHECK(block == (std::array<Byte, blockLength>{}));
+    CHECK(block == (std::array<Byte, tm::blockLength>{}));
 
     frame.StartNew(pusVcid);
     auto & dataField = frame.GetDataField();
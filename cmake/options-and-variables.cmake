@@ -25,13 +25,20 @@ if(REDIRECT_RF_OVER_UCI AND CMAKE_SYSTEM_NAME STREQUAL Linux)
     )
 endif()
 
-option(USE_PUNCTURING "Use puncturing for convolutinal codes" OFF)
+option(USE_PUNCTURING "Use puncturing for convolutinal codes by default" OFF)
 option(DISABLE_CHANNEL_CODING "Do not encode and decode transfer frames" OFF)
-option(DISABLE_CONVOLUTIONAL_CODING "Do not use convolutionally encode transfer frames" OFF)
+option(DISABLE_CONVOLUTIONAL_CODING
+       "Do not convolutionally encode transfer frames by default" OFF
+)
 option(ENABLE_DEBUG_PRINT_STACK_USAGE "Enable printing of stack usage in debug builds" OFF)
 option(FORCE_ENABLE_DEBUG_PRINT "Enable printing of debug messages even in release builds" OFF)
 
 set(HW_VERSION 30 CACHE STRING "Hardware version")
+set(RS_INTERLEAVING_DEPTH 1 CACHE STRING "Reed-Solomon interleaving depth of TM transfer frames")
+set_property(CACHE RS_INTERLEAVING_DEPTH PROPERTY STRINGS 1 2 3 4 5)
+if(NOT RS_INTERLEAVING_DEPTH MATCHES "^[1-5]$")
+    message(FATAL_ERROR "RS_INTERLEAVING_DEPTH must be 1, 2, 3, 4 or 5")
+endif()
 
 # Developer mode enables targets and code paths in the CMake scripts that are only relevant for the
 # developer(s) of STS1 COBC SW. Targets necessary to build the project must be provided